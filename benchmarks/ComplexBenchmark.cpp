@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include <complex>
+#include <random>
+#include <vector>
+#include "dsp/cfixed.hpp"
+#include "dsp/fft.hpp"
+#include "fixed_point/fixed_point.hpp"
+
+// dsp::cfixed<Fixed> against the std::complex<Fixed> path it replaces
+
+using Fixed = FixedPoint<16, 8, SaturationPolicy>;
+using StdComplex = std::complex<Fixed>;
+using CFixed = dsp::cfixed<Fixed>;
+
+template<typename Complex>
+static std::vector<Complex> make_signal(std::size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<Complex> v;
+    v.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) v.emplace_back(Fixed(dist(rng)), Fixed(dist(rng)));
+    return v;
+}
+
+// Element-wise complex multiply
+template<typename Complex>
+static void BM_ComplexMul(benchmark::State& st) {
+    size_t N = st.range(0);
+    auto a = make_signal<Complex>(N, 1);
+    auto b = make_signal<Complex>(N, 2);
+    std::vector<Complex> out(N);
+    for (auto _ : st) {
+        for (size_t i = 0; i < N; ++i) out[i] = a[i] * b[i];
+        benchmark::DoNotOptimize(out.data());
+    }
+    st.SetItemsProcessed(st.iterations() * N);
+}
+BENCHMARK_TEMPLATE(BM_ComplexMul, StdComplex)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_ComplexMul, CFixed)->Arg(1024);
+
+static void BM_ComplexMul3(benchmark::State& st) {
+    size_t N = st.range(0);
+    auto a = make_signal<CFixed>(N, 1);
+    auto b = make_signal<CFixed>(N, 2);
+    std::vector<CFixed> out(N);
+    for (auto _ : st) {
+        for (size_t i = 0; i < N; ++i) out[i] = dsp::mul3(a[i], b[i]);
+        benchmark::DoNotOptimize(out.data());
+    }
+    st.SetItemsProcessed(st.iterations() * N);
+}
+BENCHMARK(BM_ComplexMul3)->Arg(1024);
+
+// Forward FFT on each complex type
+template<typename Complex>
+static void BM_FFTComplex(benchmark::State& st) {
+    size_t N = st.range(0);
+    auto data = make_signal<Complex>(N, 3);
+    dsp::FFTPlan<Fixed, Complex> plan(N);
+    for (auto _ : st) {
+        auto tmp = data;
+        plan.forward(tmp);
+        benchmark::DoNotOptimize(tmp);
+    }
+    st.SetItemsProcessed(st.iterations() * N);
+}
+BENCHMARK_TEMPLATE(BM_FFTComplex, StdComplex)->Arg(256)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_FFTComplex, CFixed)->Arg(256)->Arg(1024);
+
+BENCHMARK_MAIN();
@@ -1,6 +1,19 @@
 #include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include "dsp/convolution2d.hpp"
 #include "dsp/dft.hpp"
 #include "dsp/fft.hpp"
+#include "dsp/fft_cache.hpp"
+#include "dsp/fft2d.hpp"
+#include "dsp/goertzel.hpp"
+#include "dsp/real_fft.hpp"
+#include "dsp/split_fft.hpp"
+#include "dsp/static_fft.hpp"
 #include "fixed_point/fixed_point.hpp"
 
 using Fixed = FixedPoint<16, 8, SaturationPolicy>;
@@ -16,16 +29,455 @@ static void BM_DFT(benchmark::State& st) {
 }
 BENCHMARK(BM_DFT)->Arg(128)->Arg(256)->Arg(512)->Arg(1024);
 
+// The O(N^2) sum dft() runs for lengths without a radix FFT kernel, reading its twiddle table
+static void BM_DFT_Direct(benchmark::State& st) {
+    size_t N = st.range(0);
+    std::vector<CFixed> data(N);
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(dsp::dft_direct(data));
+    }
+}
+BENCHMARK(BM_DFT_Direct)->Arg(128)->Arg(256)->Arg(512)->Arg(1024);
+
+// A few bins out of N = 1024 (compare BM_DFT/1024)
+static void BM_DFT_Bins(benchmark::State& st) {
+    const size_t N = 1024;
+    std::vector<CFixed> data(N);
+    std::vector<size_t> bins(st.range(0));
+    for (size_t i = 0; i < bins.size(); ++i) bins[i] = 7 * i + 3;
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(dsp::dft_bins(data, bins));
+    }
+}
+BENCHMARK(BM_DFT_Bins)->Arg(1)->Arg(4)->Arg(16);
+
+// Cycles per transformed point, from the loop's wall time and the CPU clock the library detects
+static void report_cycles_per_point(benchmark::State& st, size_t N, std::chrono::steady_clock::duration elapsed) {
+    double cycles = std::chrono::duration<double>(elapsed).count() * benchmark::CPUInfo::Get().cycles_per_second;
+    st.counters["cycles/pt"] = cycles / (double(st.iterations()) * double(N));
+}
+
+template<dsp::FFTKernel Kernel>
 static void BM_FFT(benchmark::State& st) {
     size_t N = st.range(0);
     std::vector<CFixed> data(N);
+    dsp::FFTPlan<Fixed> plan(N, Kernel);
+    std::vector<CFixed> tmp(N);
+    auto start = std::chrono::steady_clock::now();
+    for (auto _ : st) {
+        std::copy(data.begin(), data.end(), tmp.begin());
+        plan.forward(tmp);
+        benchmark::DoNotOptimize(tmp);
+    }
+    report_cycles_per_point(st, N, std::chrono::steady_clock::now() - start);
+}
+BENCHMARK(BM_FFT<dsp::FFTKernel::Radix2>)->Arg(128)->Arg(256)->Arg(512)->Arg(1024);
+BENCHMARK(BM_FFT<dsp::FFTKernel::Radix4>)->Arg(128)->Arg(256)->Arg(512)->Arg(1024);
+BENCHMARK(BM_FFT<dsp::FFTKernel::SplitRadix>)->Arg(128)->Arg(256)->Arg(512)->Arg(1024);
+
+// Past L2 the single-array kernels sweep DRAM log2(N) times; FourStep works in sqrt(N)-point tiles
+BENCHMARK(BM_FFT<dsp::FFTKernel::Radix4>)->Name("BM_FFT_Large<Radix4>")->RangeMultiplier(4)->Range(1 << 16, 1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FFT<dsp::FFTKernel::FourStep>)->Name("BM_FFT_Large<FourStep>")->RangeMultiplier(4)->Range(1 << 16, 1 << 20)->Unit(benchmark::kMillisecond);
+
+// One large transform on 1..16 threads (FourStep plans split each step into tasks); the
+// speedup is the 1-thread time over the n-thread time at the same N
+static void BM_FFT_Parallel(benchmark::State& st) {
+    size_t N = st.range(0);
+    size_t threads = st.range(1);
+    std::vector<CFixed> data(N);
     dsp::FFTPlan<Fixed> plan(N);
+    std::vector<CFixed> tmp(N);
+    auto start = std::chrono::steady_clock::now();
     for (auto _ : st) {
-        auto tmp = data;
+        std::copy(data.begin(), data.end(), tmp.begin());
+        plan.forward_parallel(tmp, threads);
+        benchmark::DoNotOptimize(tmp);
+    }
+    report_cycles_per_point(st, N, std::chrono::steady_clock::now() - start);
+}
+BENCHMARK(BM_FFT_Parallel)->ArgsProduct({ { 1 << 20, 1 << 22 }, { 1, 2, 4, 8, 16 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Small sizes: the runtime plan (Radix2 and the Auto Radix4) vs. StaticFFT's unrolled codelets
+BENCHMARK(BM_FFT<dsp::FFTKernel::Radix2>)->Name("BM_FFT_Small<Radix2>")->Arg(8)->Arg(16)->Arg(32)->Arg(64);
+BENCHMARK(BM_FFT<dsp::FFTKernel::Radix4>)->Name("BM_FFT_Small<Radix4>")->Arg(8)->Arg(16)->Arg(32)->Arg(64);
+
+// Frame sizes that are not powers of two: MixedRadix for 480..1536, Bluestein for the prime 1009
+static void BM_FFT_AnyLength(benchmark::State& st) {
+    size_t N = st.range(0);
+    std::vector<CFixed> data(N);
+    dsp::FFTPlan<Fixed> plan(N);
+    std::vector<CFixed> tmp(N);
+    auto start = std::chrono::steady_clock::now();
+    for (auto _ : st) {
+        std::copy(data.begin(), data.end(), tmp.begin());
         plan.forward(tmp);
         benchmark::DoNotOptimize(tmp);
     }
+    report_cycles_per_point(st, N, std::chrono::steady_clock::now() - start);
+}
+BENCHMARK(BM_FFT_AnyLength)->Arg(480)->Arg(960)->Arg(1000)->Arg(1536)->Arg(1009);
+BENCHMARK(BM_DFT)->Name("BM_DFT_AnyLength")->Arg(480)->Arg(1000)->Arg(1009);
+
+// Tone detection on 1024-sample Q15 frames: a Goertzel bank of 1..32 bins per frame (compare
+// BM_DFT_Bins and BM_FFT<Radix4>/1024), and the sliding DFT's update of every bin per sample
+static void BM_Goertzel(benchmark::State& st) {
+    using Q15 = FixedPoint<16, 15, SaturationPolicy>;
+    const size_t N = 1024;
+    std::vector<Q15> frame(N);
+    std::vector<double> bins(st.range(0));
+    for (size_t i = 0; i < bins.size(); ++i) bins[i] = 7.5 * double(i) + 3;
+    dsp::GoertzelBank<Q15> bank(N, bins);
+    auto start = std::chrono::steady_clock::now();
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(bank.analyze(frame));
+    }
+    report_cycles_per_point(st, N, std::chrono::steady_clock::now() - start);
+}
+BENCHMARK(BM_Goertzel)->Arg(1)->Arg(8)->Arg(32);
+
+static void BM_SlidingDFT(benchmark::State& st) {
+    using Q15 = FixedPoint<16, 15, SaturationPolicy>;
+    const size_t N = 1024;
+    std::vector<size_t> bins(st.range(0));
+    for (size_t i = 0; i < bins.size(); ++i) bins[i] = 7 * i + 3;
+    dsp::SlidingDFT<Q15> sdft(N, bins);
+    std::vector<Q15> block(N, Q15(0.25));
+    auto start = std::chrono::steady_clock::now();
+    for (auto _ : st) {
+        sdft.process(std::span<const Q15>(block));
+        benchmark::DoNotOptimize(sdft.bin(0));
+    }
+    report_cycles_per_point(st, N, std::chrono::steady_clock::now() - start);
+}
+BENCHMARK(BM_SlidingDFT)->Arg(1)->Arg(8)->Arg(32);
+
+// The inverse runs the forward passes with conjugate twiddles and its 1/N folded in, so it
+// should cost what BM_FFT<Radix4> does at the same sizes
+template<dsp::FFTKernel Kernel>
+static void BM_FFT_Inverse(benchmark::State& st) {
+    size_t N = st.range(0);
+    std::vector<CFixed> data(N);
+    dsp::FFTPlan<Fixed> plan(N, Kernel);
+    std::vector<CFixed> tmp(N);
+    auto start = std::chrono::steady_clock::now();
+    for (auto _ : st) {
+        std::copy(data.begin(), data.end(), tmp.begin());
+        plan.inverse(tmp);
+        benchmark::DoNotOptimize(tmp);
+    }
+    report_cycles_per_point(st, N, std::chrono::steady_clock::now() - start);
+}
+BENCHMARK(BM_FFT_Inverse<dsp::FFTKernel::Radix4>)->Arg(128)->Arg(256)->Arg(512)->Arg(1024);
+
+// One block of fast convolution: forward FFT, multiply by a stored filter spectrum, inverse.
+// The bit-reversed variant runs DIF/DIT passes and skips both permutations.
+template<bool BitReversed>
+static void BM_FFT_ConvolutionBlock(benchmark::State& st) {
+    size_t N = st.range(0);
+    std::vector<CFixed> data(N), filter(N);
+    dsp::FFTPlan<Fixed> plan(N, dsp::FFTKernel::Radix4);
+    std::vector<CFixed> tmp(N);
+    auto start = std::chrono::steady_clock::now();
+    for (auto _ : st) {
+        std::copy(data.begin(), data.end(), tmp.begin());
+        if constexpr (BitReversed) {
+            plan.forward_bitreversed(tmp);
+            dsp::multiply_spectra(std::span<CFixed>(tmp), std::span<const CFixed>(filter));
+            plan.inverse_bitreversed(tmp);
+        } else {
+            plan.forward(tmp);
+            dsp::multiply_spectra(std::span<CFixed>(tmp), std::span<const CFixed>(filter));
+            plan.inverse(tmp);
+        }
+        benchmark::DoNotOptimize(tmp);
+    }
+    report_cycles_per_point(st, N, std::chrono::steady_clock::now() - start);
+}
+BENCHMARK(BM_FFT_ConvolutionBlock<false>)->Arg(1024)->Arg(16384)->Arg(1 << 18);
+BENCHMARK(BM_FFT_ConvolutionBlock<true>)->Arg(1024)->Arg(16384)->Arg(1 << 18);
+
+// Scaling modes on a Q8.8 signal near full scale (+-100), where the unscaled spectrum saturates.
+// SQNR_dB compares data * 2^exponent against the double DFT of the quantized input.
+template<typename Sample>
+static std::vector<std::complex<Sample>> full_scale_signal(size_t N) {
+    std::mt19937 rng(static_cast<unsigned>(N));
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+    std::vector<std::complex<Sample>> x(N);
+    for (auto& v : x) v = { Sample(dist(rng)), Sample(dist(rng)) };
+    return x;
+}
+
+template<typename Sample>
+static double sqnr_db(const std::vector<std::complex<Sample>>& x, const std::vector<std::complex<Sample>>& X, int exponent) {
+    std::vector<std::complex<double>> ref(x.size());
+    for (size_t n = 0; n < x.size(); ++n) ref[n] = { x[n].real().to_double(), x[n].imag().to_double() };
+    ref = dsp::dft(ref);
+    double signal = 0.0, noise = 0.0;
+    for (size_t k = 0; k < x.size(); ++k) {
+        std::complex<double> v(std::ldexp(X[k].real().to_double(), exponent), std::ldexp(X[k].imag().to_double(), exponent));
+        signal += std::norm(ref[k]);
+        noise += std::norm(v - ref[k]);
+    }
+    return 10.0 * std::log10(signal / noise);
+}
+
+template<typename Sample, dsp::FFTScaling Scaling>
+static void BM_FFT_Scaling(benchmark::State& st) {
+    size_t N = st.range(0);
+    auto data = full_scale_signal<Sample>(N);
+    dsp::FFTPlan<Sample> plan(N);
+    auto tmp = data;
+    int exponent = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto _ : st) {
+        std::copy(data.begin(), data.end(), tmp.begin());
+        exponent = plan.forward(tmp, Scaling);
+        benchmark::DoNotOptimize(tmp);
+    }
+    report_cycles_per_point(st, N, std::chrono::steady_clock::now() - start);
+    st.counters["SQNR_dB"] = sqnr_db(data, tmp, exponent);
+}
+BENCHMARK(BM_FFT_Scaling<Fixed, dsp::FFTScaling::None>)->Arg(256)->Arg(1024);
+BENCHMARK(BM_FFT_Scaling<Fixed, dsp::FFTScaling::PerStage>)->Arg(256)->Arg(1024);
+BENCHMARK(BM_FFT_Scaling<Fixed, dsp::FFTScaling::Conditional>)->Arg(256)->Arg(1024);
+// The alternative: 32-bit storage with room for the growth
+BENCHMARK(BM_FFT_Scaling<FixedPoint<32, 8, SaturationPolicy>, dsp::FFTScaling::None>)->Arg(256)->Arg(1024);
+
+template<size_t N>
+static void BM_StaticFFT(benchmark::State& st) {
+    std::array<CFixed, N> data{};
+    std::array<CFixed, N> tmp;
+    auto start = std::chrono::steady_clock::now();
+    for (auto _ : st) {
+        tmp = data;
+        dsp::StaticFFT<Fixed, N>::forward(tmp);
+        benchmark::DoNotOptimize(tmp);
+    }
+    report_cycles_per_point(st, N, std::chrono::steady_clock::now() - start);
+}
+BENCHMARK(BM_StaticFFT<8>);
+BENCHMARK(BM_StaticFFT<16>);
+BENCHMARK(BM_StaticFFT<32>);
+BENCHMARK(BM_StaticFFT<64>);
+
+// Real input: widened to complex for FFTPlan vs. packed into an N/2-point transform by RealFFTPlan
+static void BM_FFT_RealInputAsComplex(benchmark::State& st) {
+    size_t N = st.range(0);
+    std::vector<Fixed> signal(N, Fixed(0.25));
+    dsp::FFTPlan<Fixed> plan(N);
+    std::vector<CFixed> spectrum(N);
+    for (auto _ : st) {
+        for (size_t n = 0; n < N; ++n) spectrum[n] = CFixed(signal[n], Fixed(0));
+        plan.forward(spectrum);
+        benchmark::DoNotOptimize(spectrum);
+    }
+}
+BENCHMARK(BM_FFT_RealInputAsComplex)->Arg(128)->Arg(256)->Arg(512)->Arg(1024);
+
+static void BM_RealFFT(benchmark::State& st) {
+    size_t N = st.range(0);
+    std::vector<Fixed> signal(N, Fixed(0.25));
+    dsp::RealFFTPlan<Fixed> plan(N);
+    std::vector<CFixed> spectrum;
+    for (auto _ : st) {
+        plan.forward(signal, spectrum);
+        benchmark::DoNotOptimize(spectrum);
+    }
+}
+BENCHMARK(BM_RealFFT)->Arg(128)->Arg(256)->Arg(512)->Arg(1024);
+
+// Split-complex layout: separate re/im arrays, butterflies through the simd kernels (compare BM_FFT<Radix2>)
+static void BM_SplitFFT(benchmark::State& st) {
+    size_t N = st.range(0);
+    std::vector<Fixed> re(N), im(N), tmp_re(N), tmp_im(N);
+    dsp::SplitFFTPlan<Fixed> plan(N);
+    auto start = std::chrono::steady_clock::now();
+    for (auto _ : st) {
+        std::copy(re.begin(), re.end(), tmp_re.begin());
+        std::copy(im.begin(), im.end(), tmp_im.begin());
+        plan.forward(tmp_re, tmp_im);
+        benchmark::DoNotOptimize(tmp_re);
+        benchmark::DoNotOptimize(tmp_im);
+    }
+    report_cycles_per_point(st, N, std::chrono::steady_clock::now() - start);
+}
+BENCHMARK(BM_SplitFFT)->Arg(128)->Arg(256)->Arg(512)->Arg(1024)->Arg(4096);
+
+// 256 channels of one frame each: a forward() per buffer vs. one forward_batch (lane-interleaved) call.
+// Second argument: worker threads for forward_batch (0 = automatic)
+static constexpr size_t kBatchChannels = 256;
+
+static void BM_FFT_BatchLoop(benchmark::State& st) {
+    size_t N = st.range(0);
+    std::vector<std::vector<CFixed>> input(kBatchChannels, std::vector<CFixed>(N, CFixed(Fixed(0.01), Fixed(-0.02))));
+    auto work = input;
+    dsp::FFTPlan<Fixed> plan(N);
+    for (auto _ : st) {
+        work = input;
+        for (auto& buffer : work) plan.forward(buffer);
+        benchmark::DoNotOptimize(work);
+    }
+    st.SetItemsProcessed(int64_t(st.iterations()) * int64_t(kBatchChannels));
+}
+BENCHMARK(BM_FFT_BatchLoop)->Arg(256)->Arg(1024)->Arg(4096);
+
+static void BM_FFT_Batch(benchmark::State& st) {
+    size_t N = st.range(0);
+    size_t threads = st.range(1);
+    std::vector<std::vector<CFixed>> input(kBatchChannels, std::vector<CFixed>(N, CFixed(Fixed(0.01), Fixed(-0.02))));
+    auto work = input;
+    dsp::FFTPlan<Fixed> plan(N);
+    for (auto _ : st) {
+        work = input;
+        plan.forward_batch(std::span<std::vector<CFixed>>(work), threads);
+        benchmark::DoNotOptimize(work);
+    }
+    st.SetItemsProcessed(int64_t(st.iterations()) * int64_t(kBatchChannels));
+}
+BENCHMARK(BM_FFT_Batch)->Args({ 256, 1 })->Args({ 1024, 1 })->Args({ 4096, 1 })->Args({ 1024, 0 });
+
+// N x N 2D FFT: row FFTs and hand-written transposes (rows, transpose, rows, transpose back),
+// column FFTs read in place with a stride (forward_batch with stride N), and FFT2DPlan's
+// column strips
+template<typename SampleType>
+static dsp::Array2D<std::complex<SampleType>> test_image(size_t N) {
+    dsp::Array2D<std::complex<SampleType>> image(N, N);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    // Small enough that the unscaled Fixed spectrum stays in range
+    for (auto& v : image.data) v = { SampleType(dist(rng) / double(N)), SampleType(dist(rng) / double(N)) };
+    return image;
+}
+
+template<typename SampleType>
+static void BM_FFT2D_RowTranspose(benchmark::State& st) {
+    size_t N = st.range(0);
+    auto input = test_image<SampleType>(N);
+    auto work = input, scratch = input;
+    dsp::FFTPlan<SampleType> plan(N);
+    auto pass = [&](dsp::Array2D<std::complex<SampleType>>& a, dsp::Array2D<std::complex<SampleType>>& t) {
+        for (size_t r = 0; r < N; ++r) plan.forward(a.row(r));
+        for (size_t r = 0; r < N; ++r)
+            for (size_t c = 0; c < N; ++c) t(c, r) = a(r, c);
+    };
+    auto start = std::chrono::steady_clock::now();
+    for (auto _ : st) {
+        work = input;
+        pass(work, scratch);
+        pass(scratch, work);
+        benchmark::DoNotOptimize(work);
+    }
+    report_cycles_per_point(st, N * N, std::chrono::steady_clock::now() - start);
+}
+BENCHMARK(BM_FFT2D_RowTranspose<Fixed>)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FFT2D_RowTranspose<double>)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+template<typename SampleType>
+static void BM_FFT2D_StridedColumns(benchmark::State& st) {
+    size_t N = st.range(0);
+    auto input = test_image<SampleType>(N);
+    auto work = input;
+    dsp::FFTPlan<SampleType> plan(N);
+    auto start = std::chrono::steady_clock::now();
+    for (auto _ : st) {
+        work = input;
+        plan.forward_batch(std::span(work.data), N, 1, N, 1);
+        plan.forward_batch(std::span(work.data), N, N, 1, 1);
+        benchmark::DoNotOptimize(work);
+    }
+    report_cycles_per_point(st, N * N, std::chrono::steady_clock::now() - start);
+}
+BENCHMARK(BM_FFT2D_StridedColumns<Fixed>)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FFT2D_StridedColumns<double>)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+template<typename SampleType>
+static void BM_FFT2D(benchmark::State& st) {
+    size_t N = st.range(0);
+    auto input = test_image<SampleType>(N);
+    auto work = input;
+    dsp::FFT2DPlan<SampleType> plan(N, N);
+    auto start = std::chrono::steady_clock::now();
+    for (auto _ : st) {
+        work = input;
+        plan.forward(work, 1);
+        benchmark::DoNotOptimize(work);
+    }
+    report_cycles_per_point(st, N * N, std::chrono::steady_clock::now() - start);
+}
+BENCHMARK(BM_FFT2D<Fixed>)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FFT2D<double>)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+// 256 x 256 image, K x K separable kernel: direct sum, the separable two-pass path, and through
+// the 2D FFT
+enum class Conv2D { Direct, Separable, FFT };
+
+template<Conv2D Method>
+static void BM_Convolve2D(benchmark::State& st) {
+    const size_t N = 256, K = st.range(0);
+    dsp::Array2D<double> image(N, N), kernel(K, K);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (auto& v : image.data) v = dist(rng);
+    std::vector<double> taps(K);
+    for (auto& v : taps) v = dist(rng);
+    for (size_t i = 0; i < K; ++i)
+        for (size_t j = 0; j < K; ++j) kernel(i, j) = taps[i] * taps[j];
+    for (auto _ : st) {
+        if constexpr (Method == Conv2D::Direct) benchmark::DoNotOptimize(dsp::convolve2d(image, kernel));
+        else if constexpr (Method == Conv2D::Separable) benchmark::DoNotOptimize(dsp::convolve2d(image, taps, taps));
+        else benchmark::DoNotOptimize(dsp::convolve2d_fft(image, kernel));
+    }
+}
+BENCHMARK(BM_Convolve2D<Conv2D::Direct>)->Arg(3)->Arg(7)->Arg(15)->Arg(31)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Convolve2D<Conv2D::Separable>)->Arg(3)->Arg(7)->Arg(15)->Arg(31)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Convolve2D<Conv2D::FFT>)->Arg(3)->Arg(7)->Arg(15)->Arg(31)->Unit(benchmark::kMillisecond);
+
+// Planning cost: a fresh plan (sin/cos per twiddle), one copied from the cache's shared twiddle
+// circle (a cache miss once the circle exists), a cache hit, and reading a plan back from wisdom
+static void BM_FFTPlan_Build(benchmark::State& st) {
+    size_t N = st.range(0);
+    for (auto _ : st) {
+        dsp::FFTPlan<Fixed> plan(N);
+        benchmark::DoNotOptimize(plan);
+    }
+}
+BENCHMARK(BM_FFTPlan_Build)->Arg(1024)->Arg(4096);
+
+static void BM_FFTPlan_FromCircle(benchmark::State& st) {
+    size_t N = st.range(0);
+    dsp::FFTPlanCache<Fixed> cache;
+    auto circle = cache.twiddle_circle(N);
+    for (auto _ : st) {
+        dsp::FFTPlan<Fixed> plan(N, dsp::FFTKernel::Auto, std::span<const CFixed>(*circle));
+        benchmark::DoNotOptimize(plan);
+    }
+}
+BENCHMARK(BM_FFTPlan_FromCircle)->Arg(1024)->Arg(4096);
+
+static void BM_FFTPlan_CacheHit(benchmark::State& st) {
+    size_t N = st.range(0);
+    dsp::FFTPlanCache<Fixed> cache;
+    cache.plan(N);
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(cache.plan(N));
+    }
+}
+BENCHMARK(BM_FFTPlan_CacheHit)->Arg(1024)->Arg(4096);
+
+static void BM_FFTPlan_LoadWisdom(benchmark::State& st) {
+    size_t N = st.range(0);
+    dsp::FFTPlanCache<Fixed> cache;
+    cache.plan(N);
+    std::stringstream wisdom;
+    cache.save(wisdom);
+    std::string bytes = wisdom.str();
+    for (auto _ : st) {
+        std::stringstream in(bytes);
+        dsp::FFTPlanCache<Fixed> restored;
+        restored.load(in);
+        benchmark::DoNotOptimize(restored.plan(N));
+    }
 }
-BENCHMARK(BM_FFT)->Arg(128)->Arg(256)->Arg(512)->Arg(1024);
+BENCHMARK(BM_FFTPlan_LoadWisdom)->Arg(1024)->Arg(4096);
 
 BENCHMARK_MAIN();
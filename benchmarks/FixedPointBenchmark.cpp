@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <random>
+#include "fixed_point/fixed_point.hpp"
+
+using Q16_16 = FixedPoint<32, 16, SaturationPolicy>;
+using Q32_32 = FixedPoint<64, 32, SaturationPolicy>;
+
+template<typename Fixed>
+static std::vector<Fixed> make_operands(std::size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+    std::vector<Fixed> v(n);
+    for (auto& x : v) {
+        x = Fixed(dist(rng));
+        if (x == Fixed(0)) x = Fixed(1);
+    }
+    return v;
+}
+
+// Element-wise a[i] * b[i] through the scalar policy
+template<typename Fixed>
+static void BM_Mul(benchmark::State& st) {
+    size_t N = st.range(0);
+    auto a = make_operands<Fixed>(N, 1);
+    auto b = make_operands<Fixed>(N, 2);
+    std::vector<Fixed> out(N);
+    for (auto _ : st) {
+        for (size_t i = 0; i < N; ++i) out[i] = a[i] * b[i];
+        benchmark::DoNotOptimize(out.data());
+    }
+    st.SetItemsProcessed(st.iterations() * N);
+}
+BENCHMARK_TEMPLATE(BM_Mul, Q16_16)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_Mul, Q32_32)->Arg(1024);
+
+// Element-wise a[i] / b[i] through the scalar policy
+template<typename Fixed>
+static void BM_Div(benchmark::State& st) {
+    size_t N = st.range(0);
+    auto a = make_operands<Fixed>(N, 3);
+    auto b = make_operands<Fixed>(N, 4);
+    std::vector<Fixed> out(N);
+    for (auto _ : st) {
+        for (size_t i = 0; i < N; ++i) out[i] = a[i] / b[i];
+        benchmark::DoNotOptimize(out.data());
+    }
+    st.SetItemsProcessed(st.iterations() * N);
+}
+BENCHMARK_TEMPLATE(BM_Div, Q16_16)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_Div, Q32_32)->Arg(1024);
+
+BENCHMARK_MAIN();
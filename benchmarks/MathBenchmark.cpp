@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "fixed_point/fixed_point.hpp"
+#include "fixed_point/math.hpp"
+
+// Throughput of the fixed-point transcendentals against libm on the same values
+// (libm pays the FixedPoint -> float -> FixedPoint round-trip, as FFT post-processing would).
+// Each benchmark also reports the maximum absolute error against double libm as "max_err".
+
+using Q16_16 = FixedPoint<32, 16, SaturationPolicy>;
+using fixed_point::MathMethod;
+
+constexpr std::size_t kCount = 1024;
+
+static std::vector<Q16_16> make_values(double lo, double hi, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    std::vector<Q16_16> v(kCount);
+    for (auto& x : v) x = Q16_16(dist(rng));
+    return v;
+}
+
+template<typename Fn, typename Ref>
+static void run_unary(benchmark::State& st, const std::vector<Q16_16>& in, Fn fn, Ref ref) {
+    std::vector<Q16_16> out(in.size());
+    for (auto _ : st) {
+        for (std::size_t i = 0; i < in.size(); ++i) out[i] = fn(in[i]);
+        benchmark::DoNotOptimize(out.data());
+    }
+    double max_err = 0.0;
+    for (std::size_t i = 0; i < in.size(); ++i)
+        max_err = std::max(max_err, std::abs(out[i].to_double() - ref(in[i].to_double())));
+    st.counters["max_err"] = max_err;
+    st.SetItemsProcessed(st.iterations() * in.size());
+}
+
+template<typename Fn, typename Ref>
+static void run_binary(benchmark::State& st, const std::vector<Q16_16>& a, const std::vector<Q16_16>& b, Fn fn, Ref ref) {
+    std::vector<Q16_16> out(a.size());
+    for (auto _ : st) {
+        for (std::size_t i = 0; i < a.size(); ++i) out[i] = fn(a[i], b[i]);
+        benchmark::DoNotOptimize(out.data());
+    }
+    double max_err = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        max_err = std::max(max_err, std::abs(out[i].to_double() - ref(a[i].to_double(), b[i].to_double())));
+    st.counters["max_err"] = max_err;
+    st.SetItemsProcessed(st.iterations() * a.size());
+}
+
+// ---- sin ----
+
+static double ref_sin(double x) { return std::sin(x); }
+
+static void BM_Sin_Cordic(benchmark::State& st) {
+    run_unary(st, make_values(-10, 10, 1), [](Q16_16 x) { return fixed_point::sin(x); }, ref_sin);
+}
+BENCHMARK(BM_Sin_Cordic);
+
+static void BM_Sin_Table(benchmark::State& st) {
+    run_unary(st, make_values(-10, 10, 1), [](Q16_16 x) { return fixed_point::sin<MathMethod::Table>(x); }, ref_sin);
+}
+BENCHMARK(BM_Sin_Table);
+
+static void BM_Sin_Libm(benchmark::State& st) {
+    run_unary(st, make_values(-10, 10, 1), [](Q16_16 x) { return Q16_16(std::sin(x.to_float())); }, ref_sin);
+}
+BENCHMARK(BM_Sin_Libm);
+
+// ---- atan2 ----
+
+static double ref_atan2(double y, double x) { return std::atan2(y, x); }
+
+static void BM_Atan2_Cordic(benchmark::State& st) {
+    run_binary(st, make_values(-100, 100, 2), make_values(-100, 100, 3),
+               [](Q16_16 y, Q16_16 x) { return fixed_point::atan2(y, x); }, ref_atan2);
+}
+BENCHMARK(BM_Atan2_Cordic);
+
+static void BM_Atan2_Table(benchmark::State& st) {
+    run_binary(st, make_values(-100, 100, 2), make_values(-100, 100, 3),
+               [](Q16_16 y, Q16_16 x) { return fixed_point::atan2<MathMethod::Table>(y, x); }, ref_atan2);
+}
+BENCHMARK(BM_Atan2_Table);
+
+static void BM_Atan2_Libm(benchmark::State& st) {
+    run_binary(st, make_values(-100, 100, 2), make_values(-100, 100, 3),
+               [](Q16_16 y, Q16_16 x) { return Q16_16(std::atan2(y.to_float(), x.to_float())); }, ref_atan2);
+}
+BENCHMARK(BM_Atan2_Libm);
+
+// ---- magnitude ----
+
+static double ref_hypot(double x, double y) { return std::hypot(x, y); }
+
+static void BM_Magnitude_Cordic(benchmark::State& st) {
+    run_binary(st, make_values(-1000, 1000, 4), make_values(-1000, 1000, 5),
+               [](Q16_16 x, Q16_16 y) { return fixed_point::magnitude(x, y); }, ref_hypot);
+}
+BENCHMARK(BM_Magnitude_Cordic);
+
+static void BM_Magnitude_Libm(benchmark::State& st) {
+    run_binary(st, make_values(-1000, 1000, 4), make_values(-1000, 1000, 5),
+               [](Q16_16 x, Q16_16 y) { return Q16_16(std::hypot(x.to_float(), y.to_float())); }, ref_hypot);
+}
+BENCHMARK(BM_Magnitude_Libm);
+
+// ---- sqrt / log2 ----
+
+static double ref_sqrt(double x) { return std::sqrt(x); }
+static double ref_log2(double x) { return std::log2(x); }
+
+static void BM_Sqrt_Fixed(benchmark::State& st) {
+    run_unary(st, make_values(0, 30000, 6), [](Q16_16 x) { return fixed_point::sqrt(x); }, ref_sqrt);
+}
+BENCHMARK(BM_Sqrt_Fixed);
+
+static void BM_Sqrt_Libm(benchmark::State& st) {
+    run_unary(st, make_values(0, 30000, 6), [](Q16_16 x) { return Q16_16(std::sqrt(x.to_float())); }, ref_sqrt);
+}
+BENCHMARK(BM_Sqrt_Libm);
+
+static void BM_Log2_Table(benchmark::State& st) {
+    run_unary(st, make_values(0.001, 30000, 7), [](Q16_16 x) { return fixed_point::log2(x); }, ref_log2);
+}
+BENCHMARK(BM_Log2_Table);
+
+static void BM_Log2_Libm(benchmark::State& st) {
+    run_unary(st, make_values(0.001, 30000, 7), [](Q16_16 x) { return Q16_16(std::log2(x.to_float())); }, ref_log2);
+}
+BENCHMARK(BM_Log2_Libm);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "fixed_point/fixed_point.hpp"
+#include "fixed_point/accumulator.hpp"
+
+namespace dsp {
+
+    // Guard bits a FixedPoint dot product gets by default: whatever is left of a 64-bit
+    // accumulator, or 32 bits of a 128-bit one for wider formats (0 for other types)
+    template<typename SampleType>
+    constexpr int max_guard_bits() {
+        if constexpr (is_fixed_point_v<SampleType>) {
+            return 2 * SampleType::total_bits < 64 ? 64 - 2 * SampleType::total_bits : 32;
+        } else {
+            return 0;
+        }
+    }
+
+    // Running sum of products for filter/convolution inner loops.
+    // Generic sample types simply use their own + and *.
+    template<typename SampleType, int GuardBits = max_guard_bits<SampleType>()>
+    class MacAccumulator {
+    public:
+        constexpr void mac(const SampleType& a, const SampleType& b) {
+            sum_ += a * b;
+        }
+
+        constexpr SampleType result() const {
+            return sum_;
+        }
+
+    private:
+        SampleType sum_{ 0 };
+    };
+
+    // FixedPoint samples are summed exactly with GuardBits of headroom and
+    // rounded/saturated once in result(), instead of once per tap.
+    template<typename SampleType, int GuardBits>
+        requires (is_fixed_point_v<SampleType> && GuardBits > 0
+                  && 2 * SampleType::total_bits <= 64 && 2 * SampleType::total_bits + GuardBits <= 128)
+    class MacAccumulator<SampleType, GuardBits> {
+    public:
+        constexpr void mac(const SampleType& a, const SampleType& b) {
+            acc_.mac(a, b);
+        }
+
+        constexpr SampleType result() const {
+            return acc_.template narrow<SampleType>();
+        }
+
+    private:
+        Accumulator<ProductType<SampleType, SampleType>, GuardBits> acc_{};
+    };
+
+} // namespace dsp
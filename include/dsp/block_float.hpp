@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "fixed_point/fixed_point.hpp"
+#include "fixed_point/rounding.hpp"
+#include "cfixed.hpp"
+
+namespace dsp {
+
+    namespace detail {
+
+        // A block's mantissas are FixedPoint values or complex pairs of them
+        template<typename Mantissa>
+        struct mantissa_traits {
+            using component = Mantissa;
+            static constexpr bool is_complex = false;
+        };
+
+        template<typename T>
+        struct mantissa_traits<std::complex<T>> {
+            using component = T;
+            static constexpr bool is_complex = true;
+        };
+
+        template<typename T>
+        struct mantissa_traits<cfixed<T>> {
+            using component = T;
+            static constexpr bool is_complex = true;
+        };
+
+        template<typename Mantissa, typename Fn>
+        constexpr void for_each_component(const Mantissa& m, Fn&& fn) {
+            if constexpr (mantissa_traits<Mantissa>::is_complex) {
+                fn(m.real());
+                fn(m.imag());
+            } else {
+                fn(m);
+            }
+        }
+
+        template<typename Mantissa, typename Fn>
+        constexpr Mantissa map_components(const Mantissa& m, Fn&& fn) {
+            if constexpr (mantissa_traits<Mantissa>::is_complex) {
+                return Mantissa(fn(m.real()), fn(m.imag()));
+            } else {
+                return fn(m);
+            }
+        }
+
+        // Bits a component's magnitude needs, as an unsigned mask: OR these over a block and
+        // pass the result to headroom_of_bits
+        template<typename Component>
+        constexpr auto magnitude_bits(const Component& c) {
+            using S = typename Component::StorageType;
+            using U = std::make_unsigned_t<S>;
+            constexpr int bits = static_cast<int>(sizeof(S) * 8);
+            // v ^ (v >> (bits-1)) is v for v >= 0 and ~v for v < 0: the bits a value needs
+            S v = c.raw();
+            return static_cast<U>(v ^ static_cast<S>(v >> (bits - 1)));
+        }
+
+        template<typename Component>
+        constexpr int headroom_of_bits(std::make_unsigned_t<typename Component::StorageType> used) {
+            constexpr int bits = static_cast<int>(sizeof(typename Component::StorageType) * 8);
+            return bits - 1 - static_cast<int>(std::bit_width(used));
+        }
+
+        // Redundant sign bits shared by every component (storage bits - 1 for an all-zero block)
+        template<typename Mantissa>
+        constexpr int block_headroom(std::span<const Mantissa> block) {
+            using Component = typename mantissa_traits<Mantissa>::component;
+            std::make_unsigned_t<typename Component::StorageType> used = 0;
+            for (const auto& m : block) {
+                for_each_component(m, [&](const Component& c) { used |= magnitude_bits(c); });
+            }
+            return headroom_of_bits<Component>(used);
+        }
+
+        // Multiply every component by 2^-shift (a left shift when negative), rounding to nearest
+        template<typename Mantissa>
+        constexpr void block_shift_right(std::span<Mantissa> block, int shift) {
+            using Component = typename mantissa_traits<Mantissa>::component;
+            if (shift == 0) return;
+            for (auto& m : block) {
+                m = map_components(m, [&](const Component& c) {
+                    return c.template scale_pow2<fixed_point::Rounding::Nearest>(-shift);
+                });
+            }
+        }
+
+        template<typename Raw>
+        constexpr int wide_bit_width(Raw magnitude) {
+            int width = 0;
+            while (magnitude > Raw(0)) {
+                magnitude = magnitude >> 1;
+                ++width;
+            }
+            return width;
+        }
+
+    } // namespace detail
+
+    // Block floating point: FixedPoint mantissas that share one exponent,
+    // value[i] = mantissas[i] * 2^exponent. Mantissa is a FixedPoint type,
+    // std::complex<FixedPoint> or cfixed<FixedPoint>.
+    //
+    // The arithmetic stays in the mantissa format (16-bit mantissas keep 16-bit
+    // inner loops); the helpers below move the block between headroom and precision
+    // and record every shift in the exponent, which gives float-like dynamic range.
+    template<typename Mantissa>
+    struct BlockFloat {
+        using mantissa_type = Mantissa;
+        using component_type = typename detail::mantissa_traits<Mantissa>::component;
+        static_assert(is_fixed_point_v<component_type>, "BlockFloat needs FixedPoint mantissas");
+
+        static constexpr int mantissa_bits = static_cast<int>(sizeof(typename component_type::StorageType) * 8);
+
+        std::vector<Mantissa> mantissas;  ///< shared-exponent mantissas
+        int exponent = 0;                 ///< power of two applied to every mantissa
+
+        constexpr BlockFloat() = default;
+
+        constexpr explicit BlockFloat(std::size_t n) : mantissas(n) {}
+
+        constexpr BlockFloat(std::vector<Mantissa> m, int e) : mantissas(std::move(m)), exponent(e) {}
+
+        // Real (double) or complex (std::complex<double>) values, stored with the
+        // exponent that lets the largest magnitude use the whole mantissa range
+        template<typename Value>
+        static BlockFloat from_values(std::span<const Value> values) {
+            double peak = 0.0;
+            for (const auto& v : values) {
+                if constexpr (detail::mantissa_traits<Mantissa>::is_complex) {
+                    peak = std::max({ peak, std::abs(double(v.real())), std::abs(double(v.imag())) });
+                } else {
+                    peak = std::max(peak, std::abs(double(v)));
+                }
+            }
+            // Largest magnitude that cannot round past the top of the mantissa
+            constexpr double limit = (double(std::numeric_limits<typename component_type::StorageType>::max()) - 0.5)
+                                     / double(uint64_t(1) << component_type::fractional_bits);
+            int e = 0;
+            if (peak > 0.0) {
+                e = static_cast<int>(std::ceil(std::log2(peak / limit)));
+                if (std::ldexp(peak, -e) > limit) ++e;  // log2 rounding
+            }
+
+            BlockFloat block(values.size());
+            block.exponent = e;
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                if constexpr (detail::mantissa_traits<Mantissa>::is_complex) {
+                    block.mantissas[i] = Mantissa(component_type(std::ldexp(double(values[i].real()), -e)),
+                                                  component_type(std::ldexp(double(values[i].imag()), -e)));
+                } else {
+                    block.mantissas[i] = component_type(std::ldexp(double(values[i]), -e));
+                }
+            }
+            return block;
+        }
+
+        // Exact integer results (e.g. accumulator sums) with frac_bits fractional bits, scaled by
+        // 2^exponent, rounded into the narrowest shift that keeps every value in range
+        template<typename Raw>
+        static BlockFloat from_wide(std::span<const Raw> raw, int frac_bits, int exponent)
+            requires (!detail::mantissa_traits<Mantissa>::is_complex)
+        {
+            using S = typename component_type::StorageType;
+            using fixed_point::Rounding;
+            using fixed_point::shift_right_rounded;
+            constexpr int F = component_type::fractional_bits;
+
+            Raw hi = 0, lo = 0;
+            for (const auto& r : raw) {
+                hi = std::max(hi, r);
+                lo = std::min(lo, r);
+            }
+            int width = std::max(detail::wide_bit_width(hi), detail::wide_bit_width(Raw(-(lo + Raw(1)))));
+            int shift = std::max(0, width - (mantissa_bits - 1));
+            // Rounding can still carry the extreme values one step out of range
+            while (shift_right_rounded<Rounding::Nearest>(hi, shift) > Raw(std::numeric_limits<S>::max())
+                   || shift_right_rounded<Rounding::Nearest>(lo, shift) < Raw(std::numeric_limits<S>::min())) {
+                ++shift;
+            }
+
+            BlockFloat block(raw.size());
+            block.exponent = exponent + shift - frac_bits + F;
+            for (std::size_t i = 0; i < raw.size(); ++i) {
+                block.mantissas[i] = component_type::from_raw(static_cast<S>(shift_right_rounded<Rounding::Nearest>(raw[i], shift)));
+            }
+            return block;
+        }
+
+        constexpr std::size_t size() const {
+            return mantissas.size();
+        }
+
+        // Value i as double (real mantissas) or std::complex<double>
+        auto value(std::size_t i) const {
+            if constexpr (detail::mantissa_traits<Mantissa>::is_complex) {
+                return std::complex<double>(std::ldexp(mantissas[i].real().to_double(), exponent),
+                                            std::ldexp(mantissas[i].imag().to_double(), exponent));
+            } else {
+                return std::ldexp(mantissas[i].to_double(), exponent);
+            }
+        }
+
+        // Redundant sign bits shared by all mantissas
+        constexpr int headroom() const {
+            return detail::block_headroom(std::span<const Mantissa>(mantissas));
+        }
+
+        // Divide the mantissas by 2^bits (rounded) and raise the exponent to match
+        constexpr void shift_right(int bits) {
+            if (bits <= 0) return;
+            detail::block_shift_right(std::span<Mantissa>(mantissas), bits);
+            exponent += bits;
+        }
+
+        // Use all the headroom for precision
+        constexpr void normalize() {
+            int h = headroom();
+            if (h == mantissa_bits - 1) return;  // all zero
+            detail::block_shift_right(std::span<Mantissa>(mantissas), -h);
+            exponent -= h;
+        }
+
+        // Shift right just far enough that the next operation has `bits` bits of headroom
+        constexpr void ensure_headroom(int bits) {
+            shift_right(bits - headroom());
+        }
+
+        // Re-express the block with a larger exponent (needed before adding blocks)
+        constexpr void align_to(int target_exponent) {
+            shift_right(target_exponent - exponent);
+        }
+    };
+
+} // namespace dsp
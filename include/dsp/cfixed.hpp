@@ -0,0 +1,169 @@
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "fixed_point/fixed_point.hpp"
+#include "fixed_point/int128.hpp"
+#include "fixed_point/rounding.hpp"
+#include "fixed_point/convert.hpp"
+
+namespace dsp {
+
+    // Complex FixedPoint sample with a guaranteed {re, im} layout.
+    // std::complex<FixedPoint> is unspecified for non-floating types and multiplies
+    // through four separately shifted and saturated products. cfixed forms each part
+    // of a product exactly in a wide integer and rounds/overflows once. conj and
+    // multiplication by +-j only swap and negate parts.
+    template<typename T>
+    struct cfixed {
+        static_assert(is_fixed_point_v<T>, "cfixed needs a FixedPoint component type");
+        using value_type = T;
+
+        T re;
+        T im;
+
+        constexpr cfixed() = default;
+        constexpr cfixed(T real, T imag = T{}) : re(real), im(imag) {}
+
+        // std::complex-style accessors, so generic transform code works on either type
+        constexpr T real() const { return re; }
+        constexpr T imag() const { return im; }
+        constexpr void real(T v) { re = v; }
+        constexpr void imag(T v) { im = v; }
+
+        constexpr cfixed operator-() const { return { -re, -im }; }
+
+        constexpr cfixed& operator+=(const cfixed& other) { re += other.re; im += other.im; return *this; }
+        constexpr cfixed& operator-=(const cfixed& other) { re -= other.re; im -= other.im; return *this; }
+        constexpr cfixed& operator*=(const cfixed& other) { return *this = *this * other; }
+        constexpr cfixed& operator*=(const T& s) { re *= s; im *= s; return *this; }
+
+        friend constexpr cfixed operator+(cfixed a, const cfixed& b) { return a += b; }
+        friend constexpr cfixed operator-(cfixed a, const cfixed& b) { return a -= b; }
+        friend constexpr cfixed operator*(cfixed a, const T& s) { return a *= s; }
+        friend constexpr cfixed operator*(const T& s, cfixed a) { return a *= s; }
+
+        friend constexpr bool operator==(const cfixed& a, const cfixed& b) { return a.re == b.re && a.im == b.im; }
+    };
+
+    namespace detail {
+
+        template<typename T>
+        inline constexpr int cfixed_storage_bits = static_cast<int>(sizeof(typename T::StorageType) * 8);
+
+        // Wide enough for a sum of two exact products, including the 3-multiply form
+        template<typename T>
+        using cfixed_wide = std::conditional_t<(2 * cfixed_storage_bits<T> + 2 <= 64), int64_t, fixed_point::wide_int128>;
+
+        // 64-bit components would need more than 128 bits; they use the component operators
+        template<typename T>
+        inline constexpr bool cfixed_has_wide = cfixed_storage_bits<T> <= 32;
+
+        template<typename T>
+        constexpr T cfixed_narrow(cfixed_wide<T> v) {
+            using fixed_point::Rounding;
+            return T::from_raw(T::PolicyType::narrow(
+                fixed_point::shift_right_rounded<Rounding::Nearest>(v, T::fractional_bits)));
+        }
+
+        template<typename T>
+        constexpr cfixed_wide<T> cfixed_raw(const T& x) {
+            return static_cast<cfixed_wide<T>>(x.raw());
+        }
+
+    } // namespace detail
+
+    // (a.re*b.re - a.im*b.im, a.re*b.im + a.im*b.re) with one rounding per part
+    template<typename T>
+    constexpr cfixed<T> operator*(const cfixed<T>& a, const cfixed<T>& b) {
+        if constexpr (detail::cfixed_has_wide<T>) {
+            using detail::cfixed_raw;
+            auto re = cfixed_raw(a.re) * cfixed_raw(b.re) - cfixed_raw(a.im) * cfixed_raw(b.im);
+            auto im = cfixed_raw(a.re) * cfixed_raw(b.im) + cfixed_raw(a.im) * cfixed_raw(b.re);
+            return { detail::cfixed_narrow<T>(re), detail::cfixed_narrow<T>(im) };
+        } else {
+            return { a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re };
+        }
+    }
+
+    // Same exact result as operator* from three multiplies (for targets where a multiply
+    // costs more than an add):
+    //   k1 = b.re*(a.re + a.im), k2 = a.re*(b.im - b.re), k3 = a.im*(b.re + b.im)
+    //   re = k1 - k3, im = k1 + k2
+    template<typename T>
+    constexpr cfixed<T> mul3(const cfixed<T>& a, const cfixed<T>& b) {
+        if constexpr (detail::cfixed_has_wide<T>) {
+            using detail::cfixed_raw;
+            auto k1 = cfixed_raw(b.re) * (cfixed_raw(a.re) + cfixed_raw(a.im));
+            auto k2 = cfixed_raw(a.re) * (cfixed_raw(b.im) - cfixed_raw(b.re));
+            auto k3 = cfixed_raw(a.im) * (cfixed_raw(b.re) + cfixed_raw(b.im));
+            return { detail::cfixed_narrow<T>(k1 - k3), detail::cfixed_narrow<T>(k1 + k2) };
+        } else {
+            return a * b;
+        }
+    }
+
+    template<typename T>
+    constexpr cfixed<T> conj(const cfixed<T>& z) {
+        return { z.re, -z.im };
+    }
+
+    // z * j
+    template<typename T>
+    constexpr cfixed<T> mul_j(const cfixed<T>& z) {
+        return { -z.im, z.re };
+    }
+
+    // z * -j
+    template<typename T>
+    constexpr cfixed<T> mul_neg_j(const cfixed<T>& z) {
+        return { z.im, -z.re };
+    }
+
+    template<typename T>
+    inline constexpr bool is_cfixed_v = false;
+
+    template<typename T>
+    inline constexpr bool is_cfixed_v<cfixed<T>> = true;
+
+    // ---- Bulk conversions ----
+
+    // float/double complex buffers <-> cfixed through the vectorised quantizers in convert.hpp
+    template<typename T, typename Float>
+        requires std::is_floating_point_v<Float>
+    void quantize(std::span<const std::complex<Float>> in, std::span<cfixed<T>> out,
+                  fixed_point::Rounding rounding = fixed_point::Rounding::Nearest) {
+        static_assert(sizeof(cfixed<T>) == 2 * sizeof(T) && std::is_standard_layout_v<cfixed<T>>, "cfixed must be {re, im}");
+        fixed_point::quantize<T>(std::span<const Float>(reinterpret_cast<const Float*>(in.data()), 2 * in.size()),
+                                 std::span<T>(reinterpret_cast<T*>(out.data()), 2 * out.size()), rounding);
+    }
+
+    template<typename T, typename Float>
+        requires std::is_floating_point_v<Float>
+    void dequantize(std::span<const cfixed<T>> in, std::span<std::complex<Float>> out) {
+        static_assert(sizeof(cfixed<T>) == 2 * sizeof(T) && std::is_standard_layout_v<cfixed<T>>, "cfixed must be {re, im}");
+        fixed_point::dequantize<T>(std::span<const T>(reinterpret_cast<const T*>(in.data()), 2 * in.size()),
+                                   std::span<Float>(reinterpret_cast<Float*>(out.data()), 2 * out.size()));
+    }
+
+    // Migration helpers from/to std::complex<FixedPoint> buffers
+    template<typename T>
+    std::vector<cfixed<T>> to_cfixed(const std::vector<std::complex<T>>& in) {
+        std::vector<cfixed<T>> out;
+        out.reserve(in.size());
+        for (const auto& z : in) out.emplace_back(z.real(), z.imag());
+        return out;
+    }
+
+    template<typename T>
+    std::vector<std::complex<T>> to_std_complex(const std::vector<cfixed<T>>& in) {
+        std::vector<std::complex<T>> out;
+        out.reserve(in.size());
+        for (const auto& z : in) out.emplace_back(z.re, z.im);
+        return out;
+    }
+
+} // namespace dsp
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cmath>
+#include <numbers>
+
+namespace dsp {
+
+    // sin/cos (and atan, sqrt, log2 for fixed-point tables) that can be evaluated in
+    // constant expressions. At runtime these forward to <cmath>; during constant
+    // evaluation they use range-reduced series that are accurate to a few ulps of double.
+    namespace detail {
+
+        // Series on the reduced argument |r| <= pi/4
+        constexpr double sin_series(double r) {
+            double r2 = r * r;
+            double term = r;
+            double sum = r;
+            for (int k = 1; k <= 11; ++k) {
+                term *= -r2 / double((2 * k) * (2 * k + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        constexpr double cos_series(double r) {
+            double r2 = r * r;
+            double term = 1.0;
+            double sum = 1.0;
+            for (int k = 1; k <= 11; ++k) {
+                term *= -r2 / double((2 * k - 1) * (2 * k));
+                sum += term;
+            }
+            return sum;
+        }
+
+        // Series on the reduced argument |r| <= 2 - sqrt(3) = tan(pi/12)
+        constexpr double atan_series(double r) {
+            double r2 = r * r;
+            double power = r;
+            double sum = r;
+            for (int k = 1; k <= 20; ++k) {
+                power *= -r2;
+                sum += power / double(2 * k + 1);
+            }
+            return sum;
+        }
+
+        // ln(m) = 2*atanh((m-1)/(m+1)) for the mantissa 1 <= m < 2
+        constexpr double log_series(double m) {
+            double s = (m - 1.0) / (m + 1.0);
+            double s2 = s * s;
+            double power = s;
+            double sum = s;
+            for (int k = 1; k <= 20; ++k) {
+                power *= s2;
+                sum += power / double(2 * k + 1);
+            }
+            return 2.0 * sum;
+        }
+
+        // Split x into n*(pi/2) + r with |r| <= pi/4, returns n mod 4
+        constexpr int reduce_quadrant(double x, double& r) {
+            constexpr double half_pi = std::numbers::pi / 2.0;
+            double q = x / half_pi;
+            long long n = static_cast<long long>(q < 0 ? q - 0.5 : q + 0.5);
+            r = x - double(n) * half_pi;
+            return static_cast<int>(((n % 4) + 4) % 4);
+        }
+
+    } // namespace detail
+
+    constexpr double constexpr_sin(double x) {
+        if consteval {
+            double r = 0.0;
+            switch (detail::reduce_quadrant(x, r)) {
+                case 0:  return  detail::sin_series(r);
+                case 1:  return  detail::cos_series(r);
+                case 2:  return -detail::sin_series(r);
+                default: return -detail::cos_series(r);
+            }
+        } else {
+            return std::sin(x);
+        }
+    }
+
+    constexpr double constexpr_cos(double x) {
+        if consteval {
+            double r = 0.0;
+            switch (detail::reduce_quadrant(x, r)) {
+                case 0:  return  detail::cos_series(r);
+                case 1:  return -detail::sin_series(r);
+                case 2:  return -detail::cos_series(r);
+                default: return  detail::sin_series(r);
+            }
+        } else {
+            return std::cos(x);
+        }
+    }
+
+    constexpr double constexpr_atan(double x) {
+        if consteval {
+            constexpr double sqrt3 = std::numbers::sqrt3;
+            if (x < 0.0) return -constexpr_atan(-x);
+            if (x > 1.0) return std::numbers::pi / 2.0 - constexpr_atan(1.0 / x);
+            if (x > 2.0 - sqrt3) return std::numbers::pi / 6.0 + constexpr_atan((x * sqrt3 - 1.0) / (x + sqrt3));
+            return detail::atan_series(x);
+        } else {
+            return std::atan(x);
+        }
+    }
+
+    constexpr double constexpr_sqrt(double x) {
+        if consteval {
+            if (x <= 0.0) return 0.0;
+            // Newton's method from above decreases monotonically until it converges
+            double r = x > 1.0 ? x : 1.0;
+            for (int i = 0; i < 1100; ++i) {
+                double next = 0.5 * (r + x / r);
+                if (next >= r) break;
+                r = next;
+            }
+            return r;
+        } else {
+            return std::sqrt(x);
+        }
+    }
+
+    // x > 0
+    constexpr double constexpr_log2(double x) {
+        if consteval {
+            int e = 0;
+            while (x >= 2.0) { x /= 2.0; ++e; }
+            while (x < 1.0)  { x *= 2.0; --e; }
+            return double(e) + detail::log_series(x) / std::numbers::ln2;
+        } else {
+            return std::log2(x);
+        }
+    }
+
+} // namespace dsp
@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <algorithm>
+#include "accumulate.hpp"
+#include "block_float.hpp"
 
 namespace dsp {
 
@@ -15,11 +17,13 @@ namespace dsp {
 
 		// Perform linear convolution
         for (std::size_t n = 0; n < result.size(); ++n) {
+            MacAccumulator<SampleType> sum;
             for (std::size_t k = 0; k < kernel_size; ++k) {
                 if (n - k >= 0 && n - k < signal_size) {
-                    result[n] += signal[n - k] * kernel[k];
+                    sum.mac(signal[n - k], kernel[k]);
                 }
             }
+            result[n] = sum.result();
         }
 		return result;
     }
@@ -48,11 +52,11 @@ namespace dsp {
 
 		// Perform circular convolution
         for (std::size_t n = 0; n < result_size; ++n) {
-            SampleType sum = SampleType(0);
+            MacAccumulator<SampleType> sum;
             for (std::size_t k = 0; k < result_size; ++k) {
-                sum += padded_signal[(n - k + result_size) % result_size] * padded_kernel[k];
+                sum.mac(padded_signal[(n - k + result_size) % result_size], padded_kernel[k]);
             }
-			result[n] = sum;
+			result[n] = sum.result();
         }
 
 		return result;
@@ -68,14 +72,40 @@ namespace dsp {
 
         // Slide the kernel backwards
         for (std::size_t n = 0; n < result.size(); ++n) {
+            MacAccumulator<SampleType> sum;
             for (std::size_t k = 0; k < M; ++k) {
                 // only accumulate when n >= k (to avoid underflow)
                 // and (n - k) is still in [0 .. N-1]
                 if (n >= k && (n - k) < N) {
-                    result[n] += signal[n - k] * kernel[k];
+                    sum.mac(signal[n - k], kernel[k]);
                 }
             }
+            result[n] = sum.result();
         }
         return result;
     }
+
+	// Block-floating-point linear convolution. Every output is summed exactly and the
+	// whole result is rounded once, with the smallest shared exponent that fits.
+    template<typename SampleType>
+        requires is_fixed_point_v<SampleType>
+    BlockFloat<SampleType> convolve(const BlockFloat<SampleType>& signal,
+        const BlockFloat<SampleType>& kernel) {
+        using Sum = Accumulator<ProductType<SampleType, SampleType>, max_guard_bits<SampleType>()>;
+        std::size_t N = signal.size();
+        std::size_t M = kernel.size();
+        std::vector<typename Sum::RawType> sums(N + M - 1);
+
+        for (std::size_t n = 0; n < sums.size(); ++n) {
+            Sum sum;
+            for (std::size_t k = 0; k < M; ++k) {
+                if (n >= k && (n - k) < N) {
+                    sum.mac(signal.mantissas[n - k], kernel.mantissas[k]);
+                }
+            }
+            sums[n] = sum.raw();
+        }
+        return BlockFloat<SampleType>::from_wide(std::span<const typename Sum::RawType>(sums),
+            2 * SampleType::fractional_bits, signal.exponent + kernel.exponent);
+    }
 } // namespace dsp
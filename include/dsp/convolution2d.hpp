@@ -0,0 +1,150 @@
+#pragma once
+
+// Silence MSVC’s non-floating std::complex warning
+#ifndef _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#define _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#endif
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "accumulate.hpp"
+#include "concepts.hpp"
+#include "fft.hpp"
+#include "fft2d.hpp"
+#include "normalize.hpp"
+
+namespace dsp {
+
+    namespace detail {
+
+        inline void check_convolution_2d(std::size_t rows, std::size_t cols, std::size_t k_rows, std::size_t k_cols) {
+            if (rows == 0 || cols == 0 || k_rows == 0 || k_cols == 0) {
+                throw std::invalid_argument("2D convolution inputs must not be empty");
+            }
+        }
+
+    } // namespace detail
+
+    // Smallest length >= n whose only prime factors are 2, 3 and 5, so it runs one of the
+    // radix kernels rather than Bluestein (padding for FFT convolution)
+    constexpr std::size_t fft_fast_size(std::size_t n) {
+        std::size_t m = std::max<std::size_t>(n, 1);
+        while (!FFTPlan<double>::mixed_radix_size(m)) ++m;
+        return m;
+    }
+
+    // Full 2D linear convolution: (rows + k_rows - 1) x (cols + k_cols - 1) outputs, each one
+    // summed in a MacAccumulator (FixedPoint: exact with guard bits, rounded once). Costs
+    // k_rows * k_cols multiplies per output; see the separable overload and convolve2d_fft.
+    template<typename SampleType>
+    Array2D<SampleType> convolve2d(const Array2D<SampleType>& signal, const Array2D<SampleType>& kernel) {
+        detail::check_convolution_2d(signal.rows, signal.cols, kernel.rows, kernel.cols);
+        Array2D<SampleType> result(signal.rows + kernel.rows - 1, signal.cols + kernel.cols - 1, SampleType(0));
+
+        for (std::size_t y = 0; y < result.rows; ++y) {
+            // Kernel rows i with 0 <= y - i < signal.rows
+            std::size_t i0 = y >= signal.rows ? y - signal.rows + 1 : 0;
+            std::size_t i1 = std::min(kernel.rows, y + 1);
+            for (std::size_t x = 0; x < result.cols; ++x) {
+                std::size_t j0 = x >= signal.cols ? x - signal.cols + 1 : 0;
+                std::size_t j1 = std::min(kernel.cols, x + 1);
+                MacAccumulator<SampleType> sum;
+                for (std::size_t i = i0; i < i1; ++i) {
+                    const SampleType* s = signal.data.data() + (y - i) * signal.cols + x;
+                    const SampleType* k = kernel.data.data() + i * kernel.cols;
+                    for (std::size_t j = j0; j < j1; ++j) sum.mac(*(s - j), k[j]);
+                }
+                result(y, x) = sum.result();
+            }
+        }
+        return result;
+    }
+
+    // Separable kernel k(i, j) = column_taps[i] * row_taps[j] (box, Gaussian, Sobel, window
+    // products): every row is convolved with row_taps, then every column of that with
+    // column_taps, for k_rows + k_cols multiplies per output instead of k_rows * k_cols. Both
+    // passes run along rows of memory. FixedPoint outputs are rounded once per pass.
+    template<typename SampleType>
+    Array2D<SampleType> convolve2d(const Array2D<SampleType>& signal, const std::vector<SampleType>& column_taps,
+                                   const std::vector<SampleType>& row_taps) {
+        detail::check_convolution_2d(signal.rows, signal.cols, column_taps.size(), row_taps.size());
+        const std::size_t k_rows = column_taps.size(), k_cols = row_taps.size();
+
+        Array2D<SampleType> rows_done(signal.rows, signal.cols + k_cols - 1, SampleType(0));
+        for (std::size_t y = 0; y < signal.rows; ++y) {
+            const SampleType* s = signal.data.data() + y * signal.cols;
+            for (std::size_t x = 0; x < rows_done.cols; ++x) {
+                std::size_t j0 = x >= signal.cols ? x - signal.cols + 1 : 0;
+                std::size_t j1 = std::min(k_cols, x + 1);
+                MacAccumulator<SampleType> sum;
+                for (std::size_t j = j0; j < j1; ++j) sum.mac(s[x - j], row_taps[j]);
+                rows_done(y, x) = sum.result();
+            }
+        }
+
+        Array2D<SampleType> result(signal.rows + k_rows - 1, rows_done.cols, SampleType(0));
+        for (std::size_t y = 0; y < result.rows; ++y) {
+            std::size_t i0 = y >= signal.rows ? y - signal.rows + 1 : 0;
+            std::size_t i1 = std::min(k_rows, y + 1);
+            for (std::size_t x = 0; x < result.cols; ++x) {
+                MacAccumulator<SampleType> sum;
+                for (std::size_t i = i0; i < i1; ++i) sum.mac(rows_done(y - i, x), column_taps[i]);
+                result(y, x) = sum.result();
+            }
+        }
+        return result;
+    }
+
+    // Full 2D linear convolution through a 2D FFT, for kernels too large for convolve2d. Both
+    // inputs are zero-padded to fft_fast_size() of the output shape and packed into one complex
+    // array (signal in the real parts, kernel in the imaginary ones), so a single forward FFT
+    // gives both spectra: X[k] = (Z[k] + conj(Z[-k])) / 2, H[k] = (Z[k] - conj(Z[-k])) / 2j.
+    // FixedPoint formats need about log2(rows * cols) integer bits of headroom for the unscaled
+    // forward spectrum; convolve2d has no such limit. In FFTBenchmark (256x256 image, double)
+    // this overtakes convolve2d from about 11x11 kernels, and stays behind the separable path.
+    template<Arithmetic SampleType>
+    Array2D<SampleType> convolve2d_fft(const Array2D<SampleType>& signal, const Array2D<SampleType>& kernel) {
+        using Complex = complex_sample<SampleType>;
+        detail::check_convolution_2d(signal.rows, signal.cols, kernel.rows, kernel.cols);
+        const std::size_t out_rows = signal.rows + kernel.rows - 1, out_cols = signal.cols + kernel.cols - 1;
+        const std::size_t P = fft_fast_size(out_rows), Q = fft_fast_size(out_cols);
+
+        Array2D<Complex> z(P, Q, Complex(SampleType(0), SampleType(0)));
+        for (std::size_t r = 0; r < signal.rows; ++r) {
+            for (std::size_t c = 0; c < signal.cols; ++c) z(r, c) = Complex(signal(r, c), SampleType(0));
+        }
+        for (std::size_t r = 0; r < kernel.rows; ++r) {
+            for (std::size_t c = 0; c < kernel.cols; ++c) z(r, c) = Complex(z(r, c).real(), kernel(r, c));
+        }
+
+        FFT2DPlan<SampleType, Complex> plan(P, Q);
+        plan.forward(z);
+
+        // Y[k] = X[k] H[k]; both inputs are real, so Y[-k] = conj(Y[k]) and each pair is done once.
+        // Inputs are halved first so the separation cannot overflow.
+        using std::conj;
+        Normalizer<SampleType> halve(2);
+        for (std::size_t u = 0; u < P; ++u) {
+            const std::size_t nu = (P - u) % P;
+            for (std::size_t v = 0; v < Q; ++v) {
+                const std::size_t k = u * Q + v, m = nu * Q + (Q - v) % Q;
+                if (m < k) continue;
+                Complex a = halve(z.data[k]), b = halve(conj(z.data[m]));
+                Complex y = (a + b) * detail::times_neg_j(a - b);
+                z.data[k] = y;
+                z.data[m] = conj(y);
+            }
+        }
+
+        plan.inverse(z);
+        Array2D<SampleType> result(out_rows, out_cols);
+        for (std::size_t r = 0; r < out_rows; ++r) {
+            for (std::size_t c = 0; c < out_cols; ++c) result(r, c) = z(r, c).real();
+        }
+        return result;
+    }
+
+} // namespace dsp
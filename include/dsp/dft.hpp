@@ -5,52 +5,150 @@
 #define _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
 #endif
 
+#include <bit>
 #include <vector>
 #include <complex>
-#include <concepts>
 #include <cstddef>
-#include <cmath>
-#include <numbers>
+#include <memory>
+#include <span>
+#include <stdexcept>
 #include "concepts.hpp"
+#include "normalize.hpp"
+#include "cfixed.hpp"
+#include "fft.hpp"
+#include "fft_cache.hpp"
+#include "twiddle.hpp"
 
 namespace dsp {
-    // Alias for a complex sample
-    template<Arithmetic SampleType>
-    using complex_sample = std::complex<SampleType>;
 
-    // Helper to build e^{+-2*pi*i*m/N} in SampleType
-    template<Arithmetic SampleType>
-    complex_sample<SampleType>
-        make_twiddle(std::size_t N, std::size_t m, bool inverse = false)
-    {
-        double sign = inverse ? +1.0 : -1.0;
-        double phase = sign * 2.0 * std::numbers::pi * double(m % N) / double(N);
-        SampleType re{ std::cos(phase) };
-        SampleType im{ std::sin(phase) };
-        return complex_sample<SampleType>(re, im);
-    }
+    // dft() and idft() are O(N log N) wherever an FFTPlan runs radix kernels: N is handed to a
+    // plan from FFTPlanCache::global() when it is a power of two or 2^a * 3^b * 5^c. Other
+    // lengths (those FFTPlan would run through Bluestein) take the direct sum, as do
+    // dft_direct()/idft_direct() for every length. The direct sum reads W_N^((k*n) mod N)
+    // from a table of N twiddles, so it costs N sin/cos evaluations rather than N^2.
+    // dft_bins() evaluates only the requested bins, in O(N) each.
+
+    namespace detail {
+
+        // W_N^m for m=0..N-1, conjugated for the inverse
+        template<Arithmetic SampleType, typename Complex>
+        std::vector<Complex> dft_twiddle_table(std::size_t N, bool inverse)
+        {
+            std::vector<Complex> table;
+            table.reserve(N);
+            for (std::size_t m = 0; m < N; ++m) {
+                table.push_back(make_twiddle<SampleType, Complex>(N, m, inverse));
+            }
+            return table;
+        }
+
+        // One bin, sum_n x[n] W_N^((k*n) mod N), from a table of W_N^(m/stride) for m < N*stride;
+        // the index steps by k instead of being recomputed. Input is a real or a complex sample.
+        template<typename Complex, typename Input>
+        Complex dft_bin(const std::vector<Input>& signal, std::span<const Complex> table, std::size_t k)
+        {
+            using SampleType = typename Complex::value_type;
+            const std::size_t N = signal.size();
+            const std::size_t size = table.size();
+            const std::size_t step = (k % N) * (size / N);
+            auto sum = Complex(SampleType{ 0 }, SampleType{ 0 });
+            for (std::size_t n = 0, m = 0; n < N; ++n) {
+                sum = sum + signal[n] * table[m];
+                m += step;
+                if (m >= size) m -= size;
+            }
+            return sum;
+        }
+
+        // Every bin through the table, the inverse with 1/N scaling
+        template<Arithmetic SampleType, typename Complex, typename Input>
+        std::vector<Complex> direct_dft(const std::vector<Input>& signal, bool inverse)
+        {
+            std::size_t N = signal.size();
+            // Zero-filled explicitly: FixedPoint complex samples have no (0, 0) default
+            std::vector<Complex> result(N, Complex(SampleType{ 0 }, SampleType{ 0 }));
+            if (N == 0) return result;
+            auto table = dft_twiddle_table<SampleType, Complex>(N, inverse);
+            for (std::size_t k = 0; k < N; ++k) {
+                result[k] = dft_bin(signal, std::span<const Complex>(table), k);
+            }
+            if (inverse) {
+                Normalizer<SampleType> scale(N);
+                for (auto& x : result) x = scale(x);
+            }
+            return result;
+        }
+
+        // Lengths dft()/idft() hand to an FFT: those FFTPlan runs with radix kernels
+        template<Arithmetic SampleType, typename Complex>
+        bool dft_uses_fft(std::size_t N)
+        {
+            return N > 0 && FFTPlan<SampleType, Complex>::choose_kernel(N, FFTKernel::Auto) != FFTKernel::Bluestein;
+        }
+
+        // DFT on complex‐valued data, shared by the std::complex and cfixed overloads
+        template<Arithmetic SampleType, typename Complex>
+        std::vector<Complex> complex_dft(const std::vector<Complex>& signal)
+        {
+            if (!dft_uses_fft<SampleType, Complex>(signal.size())) {
+                return direct_dft<SampleType, Complex>(signal, /*inverse=*/false);
+            }
+            auto result = signal;
+            FFTPlanCache<SampleType, Complex>::global().plan(signal.size())->forward(result);
+            return result;
+        }
+
+        // Inverse DFT (complex in → complex out, with 1/N scaling)
+        template<Arithmetic SampleType, typename Complex>
+        std::vector<Complex> complex_idft(const std::vector<Complex>& X)
+        {
+            if (!dft_uses_fft<SampleType, Complex>(X.size())) {
+                return direct_dft<SampleType, Complex>(X, /*inverse=*/true);
+            }
+            auto result = X;
+            FFTPlanCache<SampleType, Complex>::global().plan(X.size())->inverse(result);
+            return result;
+        }
+
+        // Bins bins[i] of the DFT of signal, in the order asked for. Powers of two read the
+        // shared twiddle circle (the same values make_twiddle gives), so no sin/cos at all.
+        template<Arithmetic SampleType, typename Complex, typename Input>
+        std::vector<Complex> dft_bins(const std::vector<Input>& signal, const std::vector<std::size_t>& bins)
+        {
+            std::size_t N = signal.size();
+            if (N == 0 && !bins.empty()) {
+                throw std::invalid_argument("DFT bins need a non-empty signal");
+            }
+            std::vector<Complex> result;
+            result.reserve(bins.size());
+            if (bins.empty()) return result;
+            std::shared_ptr<const std::vector<Complex>> table;
+            if (std::has_single_bit(N)) {
+                table = FFTPlanCache<SampleType, Complex>::global().twiddle_circle(N);
+            } else {
+                table = std::make_shared<const std::vector<Complex>>(dft_twiddle_table<SampleType, Complex>(N, /*inverse=*/false));
+            }
+            for (std::size_t k : bins) {
+                result.push_back(dft_bin(signal, std::span<const Complex>(*table), k));
+            }
+            return result;
+        }
+
+    } // namespace detail
 
     // DFT on real‐valued data
     template<Arithmetic SampleType>
     std::vector< complex_sample<SampleType> >
         dft(const std::vector<SampleType>& signal)
     {
-        std::size_t N = signal.size();
-		// We need this to guarantee that the result vector is initialized to zero
-		// This is because the compiler does not recognize how to default initialize a FixedPoint type to (0, 0)
-        auto zero_cs = complex_sample<SampleType>(SampleType{ 0 }, SampleType{ 0 });
-        std::vector< complex_sample<SampleType> > result(N, zero_cs);
-
-        for (std::size_t k = 0; k < N; ++k) {
-            auto sum = complex_sample<SampleType>(SampleType{ 0 }, SampleType{ 0 });
-            for (std::size_t n = 0; n < N; ++n) {
-                auto W = make_twiddle<SampleType>(N, k * n, /*inverse=*/false);
-                auto xcn = complex_sample<SampleType>(signal[n], SampleType{ 0 });
-                sum = sum + xcn * W;
-            }
-            result[k] = sum;
+        using Complex = complex_sample<SampleType>;
+        if (!detail::dft_uses_fft<SampleType, Complex>(signal.size())) {
+            return detail::direct_dft<SampleType, Complex>(signal, /*inverse=*/false);
         }
-
+        std::vector<Complex> result;
+        result.reserve(signal.size());
+        for (const auto& x : signal) result.emplace_back(x, SampleType{ 0 });
+        FFTPlanCache<SampleType, Complex>::global().plan(signal.size())->forward(result);
         return result;
     }
 
@@ -59,20 +157,14 @@ namespace dsp {
     std::vector< complex_sample<SampleType> >
         dft(const std::vector< complex_sample<SampleType> >& signal)
     {
-        std::size_t N = signal.size();
-        auto zero_cs = complex_sample<SampleType>(SampleType{ 0 }, SampleType{ 0 });
-        std::vector< complex_sample<SampleType> > result(N, zero_cs);
-
-        for (std::size_t k = 0; k < N; ++k) {
-            auto sum = complex_sample<SampleType>(SampleType{ 0 }, SampleType{ 0 });
-            for (std::size_t n = 0; n < N; ++n) {
-                auto W = make_twiddle<SampleType>(N, k * n, /*inverse=*/false);
-                sum = sum + signal[n] * W;
-            }
-            result[k] = sum;
-        }
+        return detail::complex_dft<SampleType>(signal);
+    }
 
-        return result;
+    template<typename T>
+    std::vector< cfixed<T> >
+        dft(const std::vector< cfixed<T> >& signal)
+    {
+        return detail::complex_dft<T>(signal);
     }
 
     // Inverse DFT (complex in → complex out, with 1/N scaling)
@@ -80,21 +172,73 @@ namespace dsp {
     std::vector< complex_sample<SampleType> >
         idft(const std::vector< complex_sample<SampleType> >& X)
     {
-        std::size_t N = X.size();
-        auto zero_cs = complex_sample<SampleType>(SampleType{ 0 }, SampleType{ 0 });
-        std::vector< complex_sample<SampleType> > result(N, zero_cs);
+        return detail::complex_idft<SampleType>(X);
+    }
+
+    template<typename T>
+    std::vector< cfixed<T> >
+        idft(const std::vector< cfixed<T> >& X)
+    {
+        return detail::complex_idft<T>(X);
+    }
 
-        for (std::size_t n = 0; n < N; ++n) {
-            auto sum = complex_sample<SampleType>(SampleType{ 0 }, SampleType{ 0 });
-            for (std::size_t k = 0; k < N; ++k) {
-                auto W = make_twiddle<SampleType>(N, k * n, /*inverse=*/true);
-                sum = sum + X[k] * W;
-            }
-            // scale by 1/N
-            result[n] = sum / SampleType{ static_cast<double>(N) };
-        }
+    // The direct O(N^2) sums at every length: no plan, and a reference for the FFTs
+    template<Arithmetic SampleType>
+    std::vector< complex_sample<SampleType> >
+        dft_direct(const std::vector<SampleType>& signal)
+    {
+        return detail::direct_dft<SampleType, complex_sample<SampleType>>(signal, /*inverse=*/false);
+    }
 
-        return result;
+    template<Arithmetic SampleType>
+    std::vector< complex_sample<SampleType> >
+        dft_direct(const std::vector< complex_sample<SampleType> >& signal)
+    {
+        return detail::direct_dft<SampleType, complex_sample<SampleType>>(signal, /*inverse=*/false);
+    }
+
+    template<typename T>
+    std::vector< cfixed<T> >
+        dft_direct(const std::vector< cfixed<T> >& signal)
+    {
+        return detail::direct_dft<T, cfixed<T>>(signal, /*inverse=*/false);
+    }
+
+    template<Arithmetic SampleType>
+    std::vector< complex_sample<SampleType> >
+        idft_direct(const std::vector< complex_sample<SampleType> >& X)
+    {
+        return detail::direct_dft<SampleType, complex_sample<SampleType>>(X, /*inverse=*/true);
+    }
+
+    template<typename T>
+    std::vector< cfixed<T> >
+        idft_direct(const std::vector< cfixed<T> >& X)
+    {
+        return detail::direct_dft<T, cfixed<T>>(X, /*inverse=*/true);
+    }
+
+    // Only the bins listed (each taken mod N), in O(N) per bin. For a power of two this beats
+    // dft() for up to about log2(N)/2 bins (FFTBenchmark); other lengths also build a table.
+    template<Arithmetic SampleType>
+    std::vector< complex_sample<SampleType> >
+        dft_bins(const std::vector<SampleType>& signal, const std::vector<std::size_t>& bins)
+    {
+        return detail::dft_bins<SampleType, complex_sample<SampleType>>(signal, bins);
+    }
+
+    template<Arithmetic SampleType>
+    std::vector< complex_sample<SampleType> >
+        dft_bins(const std::vector< complex_sample<SampleType> >& signal, const std::vector<std::size_t>& bins)
+    {
+        return detail::dft_bins<SampleType, complex_sample<SampleType>>(signal, bins);
+    }
+
+    template<typename T>
+    std::vector< cfixed<T> >
+        dft_bins(const std::vector< cfixed<T> >& signal, const std::vector<std::size_t>& bins)
+    {
+        return detail::dft_bins<T, cfixed<T>>(signal, bins);
     }
 
 } // namespace dsp
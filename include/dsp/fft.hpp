@@ -6,105 +6,1432 @@
 #define _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
 #endif
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <vector>
 #include <complex>
 #include <concepts>
 #include <cstddef>
+#include <span>
 #include <stdexcept>
-#include "dft.hpp"
+#include <thread>
+#include <type_traits>
+#include "block_float.hpp"
 #include "concepts.hpp"
+#include "normalize.hpp"
+#include "twiddle.hpp"
+#include "fixed_point/simd.hpp"
 
 namespace dsp {
 
-    // Alias for a complex sample
-    template<Arithmetic SampleType>
-    using complex_sample = std::complex<SampleType>;
+    // Bit-reversal permutation for a power-of-two N, computed at compile time
+    template<std::size_t N>
+    constexpr std::array<std::size_t, N> make_bitrev_table() {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "FFT size must be a power of two");
+        std::size_t levels = 0;
+        while ((std::size_t(1) << levels) < N) ++levels;
 
-    // Plan for an in‐place radix-2 FFT of length N (power of two)
-    template<Arithmetic SampleType>
+        std::array<std::size_t, N> table{};
+        for (std::size_t i = 0; i < N; ++i) {
+            std::size_t r = 0;
+            for (std::size_t j = 0; j < levels; ++j) {
+                if (i & (std::size_t(1) << j)) {
+                    r |= (std::size_t(1) << (levels - 1 - j));
+                }
+            }
+            table[i] = r;
+        }
+        return table;
+    }
+
+    // Forward twiddles W_N^k for k=0..N/2−1, computed at compile time so they can live in .rodata
+    template<Arithmetic SampleType, std::size_t N, typename Complex = complex_sample<SampleType>>
+    constexpr std::array<Complex, N / 2> make_twiddle_table() {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "FFT size must be a power of two");
+        std::array<Complex, N / 2> table{};
+        for (std::size_t k = 0; k < N / 2; ++k) {
+            table[k] = make_twiddle<SampleType, Complex>(N, k, /*inverse=*/false);
+        }
+        return table;
+    }
+
+    // Butterfly kernel an FFTPlan runs. The power-of-two kernels all use the same bit-reversed
+    // input order and skip the multiplies for trivial twiddles (1 and -j).
+    enum class FFTKernel {
+        Auto,        // let the plan choose (Radix4, fastest in FFTBenchmark)
+        Radix2,      // log2(N) radix-2 passes
+        Radix4,      // radix-4 passes, 3 multiplies per 4 points (one radix-2 pass first for odd log2(N))
+        SplitRadix,  // recursive split-radix, the lowest multiply count
+        FourStep,    // cache-blocked four-step over ~sqrt(N)-point sub-plans (Auto above fft_four_step_min_bytes)
+        MixedRadix,  // radix-4/2/3/5 passes for N = 2^a * 3^b * 5^c (Auto for such N that are not powers of two)
+        Bluestein    // chirp-z: any N as a convolution through a power-of-two plan (Auto for all other N)
+    };
+
+    // How FFTPlan::forward(data, scaling) keeps a fixed-point spectrum in range. The result is
+    // data * 2^exponent, with the exponent returned by forward.
+    enum class FFTScaling {
+        None,        // no scaling, as forward(data): magnitudes grow by up to N and can saturate
+        PerStage,    // every radix-2 stage halves its inputs (radix-4 passes quarter them): exponent log2(N)
+        Conditional  // block floating point: a pass shifts only when the data lacks the headroom it needs
+    };
+
+    // Data size from which Auto plans switch to FourStep: around where one radix-2/4 pass over
+    // the array stops fitting in L2 and every pass (and the bit reversal) goes to DRAM
+    inline constexpr std::size_t fft_four_step_min_bytes = std::size_t(1) << 20;
+
+    // forward_batch: groups of transforms are run one per SIMD lane while a group's split
+    // re/im scratch stays within this many bytes (it still wins 5x from L3 in FFTBenchmark;
+    // the bound keeps the per-thread scratch modest)
+    inline constexpr std::size_t fft_batch_lane_max_bytes = std::size_t(1) << 22;
+
+    // forward_batch: batches with at least this many points in total use every core by default
+    inline constexpr std::size_t fft_batch_thread_min_points = std::size_t(1) << 16;
+
+    // forward_parallel: smallest piece of one transform (in points) a thread takes at a time
+    inline constexpr std::size_t fft_parallel_grain_points = std::size_t(1) << 15;
+
+    namespace detail {
+
+        // z * -j for std::complex and cfixed alike
+        template<typename Complex>
+        constexpr Complex times_neg_j(const Complex& z) {
+            return Complex(z.imag(), -z.real());
+        }
+
+        // W_4 in the transform's direction: z * -j forward, z * +j inverse
+        template<bool Inverse, typename Complex>
+        constexpr Complex quarter_turn(const Complex& z) {
+            if constexpr (Inverse) return Complex(-z.imag(), z.real());
+            else return times_neg_j(z);
+        }
+
+        // Inverse transforms use the conjugate twiddles (std::conj, or dsp::conj for cfixed)
+        template<bool Inverse, typename Complex>
+        constexpr Complex conj_if(const Complex& w) {
+            using std::conj;
+            if constexpr (Inverse) return conj(w);
+            else return w;
+        }
+
+        template<bool Inverse, typename Complex>
+        constexpr Complex twiddle_mul(const Complex& z, const Complex& w) {
+            return z * conj_if<Inverse>(w);
+        }
+
+        // Leaves samples as they are (forward passes, unscaled inverse passes)
+        struct NoScale {
+            template<typename T>
+            constexpr const T& operator()(const T& x) const { return x; }
+        };
+
+        // Rounding right shift of both components (FFTScaling: a pass's inputs)
+        template<int Shift>
+        struct ShiftRightBy {
+            template<typename Complex>
+            constexpr Complex operator()(const Complex& z) const {
+                return map_components(z, [](const auto& c) {
+                    return c.template scale_pow2<fixed_point::Rounding::Nearest>(-Shift);
+                });
+            }
+        };
+
+        struct ShiftRight {
+            int shift;
+
+            template<typename Complex>
+            constexpr Complex operator()(const Complex& z) const {
+                return map_components(z, [&](const auto& c) {
+                    return c.template scale_pow2<fixed_point::Rounding::Nearest>(-shift);
+                });
+            }
+        };
+
+        // Calls f with a right shift by `shift` bits: nothing for 0, a compile-time shift for
+        // the 1..3 bits a pass normally needs (a third faster in FFTBenchmark), run-time beyond
+        template<typename F>
+        constexpr void with_shift(int shift, F&& f) {
+            switch (shift) {
+            case 0: f(NoScale{}); break;
+            case 1: f(ShiftRightBy<1>{}); break;
+            case 2: f(ShiftRightBy<2>{}); break;
+            case 3: f(ShiftRightBy<3>{}); break;
+            default: f(ShiftRight{ shift }); break;
+            }
+        }
+
+        // Passes samples through and collects the bits their components use, so conditional
+        // scaling knows the headroom after a pass without another trip over the data
+        template<typename Complex>
+        struct TrackHeadroom {
+            using Component = typename mantissa_traits<Complex>::component;
+            std::make_unsigned_t<typename Component::StorageType>* used;
+
+            constexpr Complex operator()(const Complex& z) const {
+                for_each_component(z, [&](const Component& c) { *used |= magnitude_bits(c); });
+                return z;
+            }
+        };
+
+        // Calls f with the scaling an inverse applies to the outputs of one pass: the whole 1/N
+        // on the last pass (a shift for FixedPoint when N is a power of two), nothing before it.
+        // One rounding at the end keeps the precision of scaling after an unscaled transform.
+        template<Arithmetic SampleType, bool Inverse, typename F>
+        constexpr void with_pass_scale(std::size_t N, bool last, F&& f) {
+            if constexpr (Inverse) {
+                if (last) {
+                    f(Normalizer<SampleType>(N));
+                    return;
+                }
+            }
+            f(NoScale{});
+        }
+
+        // Power-of-two strides map a tile's column onto few cache sets, so tiles stay small
+        inline constexpr std::size_t transpose_tile = 16;
+
+        // Scratch for the kernels that cannot run in place (MixedRadix copies its input,
+        // Bluestein zero-pads to the convolution size): one buffer per thread and kernel, grown
+        // to the largest transform the thread has run and kept, so repeated transforms do not
+        // allocate. Neither kernel's passes call the other, so the buffers are never shared.
+        template<typename Complex, FFTKernel Kernel>
+        std::span<Complex> thread_scratch(std::size_t size) {
+            thread_local std::vector<Complex> buffer;
+            if (buffer.size() < size) buffer.resize(size);
+            return std::span<Complex>(buffer.data(), size);
+        }
+
+        // Rows [r_begin, r_end) of src (rows x cols) into dst (cols x rows), tile by tile
+        template<typename T>
+        constexpr void transpose_rows(const T* src, T* dst, std::size_t rows, std::size_t cols,
+                                      std::size_t r_begin, std::size_t r_end) {
+            constexpr std::size_t tile = transpose_tile;
+            for (std::size_t r0 = r_begin; r0 < r_end; r0 += tile) {
+                std::size_t r1 = std::min(r0 + tile, r_end);
+                for (std::size_t c0 = 0; c0 < cols; c0 += tile) {
+                    std::size_t c1 = std::min(c0 + tile, cols);
+                    for (std::size_t r = r0; r < r1; ++r) {
+                        for (std::size_t c = c0; c < c1; ++c) {
+                            dst[c * rows + r] = src[r * cols + c];
+                        }
+                    }
+                }
+            }
+        }
+
+        // dst (cols x rows) = transpose of src (rows x cols)
+        template<typename T>
+        constexpr void transpose(const T* src, T* dst, std::size_t rows, std::size_t cols) {
+            transpose_rows(src, dst, rows, cols, 0, rows);
+        }
+
+        // In-place transpose of an n x n matrix, swapping tiles across the diagonal; rows
+        // [r_begin, r_end) (tile-aligned) swap with the tiles right of the diagonal
+        template<typename T>
+        constexpr void transpose_square_rows(T* a, std::size_t n, std::size_t r_begin, std::size_t r_end) {
+            constexpr std::size_t tile = transpose_tile;
+            for (std::size_t r0 = r_begin; r0 < r_end; r0 += tile) {
+                std::size_t r1 = std::min(r0 + tile, n);
+                for (std::size_t c0 = r0; c0 < n; c0 += tile) {
+                    std::size_t c1 = std::min(c0 + tile, n);
+                    for (std::size_t r = r0; r < r1; ++r) {
+                        for (std::size_t c = std::max(c0, r + 1); c < c1; ++c) {
+                            std::swap(a[r * n + c], a[c * n + r]);
+                        }
+                    }
+                }
+            }
+        }
+
+        template<typename T>
+        constexpr void transpose_square(T* a, std::size_t n) {
+            transpose_square_rows(a, n, 0, n);
+        }
+
+        // fn(begin, end) over [0, count) in one call: the serial schedule for four_step
+        struct SerialFor {
+            template<typename F>
+            constexpr void operator()(std::size_t count, std::size_t, F&& fn) const {
+                if (count > 0) fn(std::size_t(0), count);
+            }
+        };
+
+        // fn(begin, end) over [0, count) in chunks of `chunk` items on up to `threads` threads,
+        // the calling one included. Chunks are handed out one at a time from a shared counter,
+        // so a thread that finishes early keeps taking work the others have not reached.
+        struct ParallelFor {
+            std::size_t threads;
+
+            template<typename F>
+            void operator()(std::size_t count, std::size_t chunk, F&& fn) const {
+                chunk = std::max<std::size_t>(chunk, 1);
+                const std::size_t chunks = (count + chunk - 1) / chunk;
+                const std::size_t n_threads = std::min(threads, chunks);
+                if (n_threads <= 1) {
+                    SerialFor{}(count, chunk, fn);
+                    return;
+                }
+                std::atomic<std::size_t> next{ 0 };
+                auto work = [&] {
+                    for (std::size_t c = next.fetch_add(1, std::memory_order_relaxed); c < chunks;
+                         c = next.fetch_add(1, std::memory_order_relaxed)) {
+                        fn(c * chunk, std::min(count, (c + 1) * chunk));
+                    }
+                };
+                std::vector<std::jthread> workers;
+                workers.reserve(n_threads - 1);
+                for (std::size_t t = 1; t < n_threads; ++t) workers.emplace_back(work);
+                work();
+            }
+        };
+
+    } // namespace detail
+
+    // x *= h, bin by bin: the spectrum of a circular convolution. Both spectra only need to be
+    // in the same order, so bit-reversed ones from FFTPlan::forward_bitreversed work as they are.
+    template<typename Complex>
+    constexpr void multiply_spectra(std::span<Complex> x, std::span<const Complex> h) {
+        if (x.size() != h.size()) {
+            throw std::invalid_argument("Spectra must have the same size");
+        }
+        for (std::size_t k = 0; k < x.size(); ++k) x[k] = x[k] * h[k];
+    }
+
+    // x *= conj(h): the spectrum of the circular cross-correlation of x with h
+    template<typename Complex>
+    constexpr void multiply_spectra_conj(std::span<Complex> x, std::span<const Complex> h) {
+        if (x.size() != h.size()) {
+            throw std::invalid_argument("Spectra must have the same size");
+        }
+        using std::conj;
+        for (std::size_t k = 0; k < x.size(); ++k) x[k] = x[k] * conj(h[k]);
+    }
+
+    template<Arithmetic SampleType, typename Complex>
+    class FFTPlanCache;
+
+    // Plan for an in‐place FFT of length N. Powers of two run the radix-2/4 kernels; other
+    // lengths run MixedRadix when N = 2^a * 3^b * 5^c and Bluestein otherwise, so every
+    // length costs O(N log N).
+    // Complex is the data/twiddle type: std::complex<SampleType> or cfixed<SampleType>.
+    template<Arithmetic SampleType, typename Complex = complex_sample<SampleType>>
     struct FFTPlan {
         std::size_t N;                                     ///< transform size
-        std::vector<std::size_t> bitrev;                   ///< bit-reversed indices
-        std::vector<complex_sample<SampleType>> twiddles;  ///< W_N^k = exp(−2*pi*i*k/N)
+        FFTKernel kernel;                                  ///< butterfly kernel in use (never Auto)
+        std::vector<std::size_t> bitrev;                   ///< bit-reversed indices (power-of-two kernels)
+        std::vector<Complex> twiddles;                     ///< W_N^k = exp(−2*pi*i*k/N), k < N/2 (MixedRadix: k < N; Bluestein: chirp)
+        std::vector<Complex> kernel_twiddles;              ///< per-pass twiddles in load order (Radix4/SplitRadix/FourStep; Bluestein: filter)
+        std::vector<FFTPlan> sub_plans;                    ///< FourStep: { N2-point column plan, N1-point row plan }; Bluestein: { convolution plan }
+        int filter_shift = 0;                              ///< Bluestein: kernel_twiddles hold the filter spectrum / M times 2^filter_shift
+
+        // Build tables for size N (a power of two, except for MixedRadix, Bluestein and Auto)
+        constexpr explicit FFTPlan(std::size_t N, FFTKernel kernel = FFTKernel::Auto)
+            : FFTPlan(N, kernel, std::span<const Complex>{}) {}
 
-        // Build tables for size N (must be a power of two)
-        explicit FFTPlan(std::size_t N) {
-            // Check power‐of‐two, this is required for FFT
-            if (N == 0 || (N & (N - 1)) != 0) {
+        // Same, but every twiddle is read from `circle` = W_M^k for k=0..M-1, with M a multiple
+        // of N (see FFTPlanCache), instead of evaluating sin/cos. W_n^k is exactly circle[k*M/n],
+        // so the tables are identical to the ones the plain constructor builds. Bluestein plans
+        // evaluate their chirp themselves and ignore the circle.
+        constexpr FFTPlan(std::size_t N, FFTKernel kernel, std::span<const Complex> circle) {
+            kernel = choose_kernel(N, kernel);
+            bool any_size = kernel == FFTKernel::MixedRadix || kernel == FFTKernel::Bluestein;
+            if (N == 0 || ((N & (N - 1)) != 0 && !any_size)) {
                 throw std::invalid_argument("FFT size must be a power of two");
+            }
+            if (kernel == FFTKernel::MixedRadix && !mixed_radix_size(N)) {
+                throw std::invalid_argument("Mixed-radix FFT size must have no prime factors other than 2, 3 and 5");
+            }
+            if (!circle.empty() && kernel != FFTKernel::Bluestein && circle.size() % N != 0) {
+                throw std::invalid_argument("Twiddle circle must be a multiple of the FFT size");
             }
 			this->N = N;
+            this->kernel = kernel;
+
+            auto twiddle = [&](std::size_t n, std::size_t k) {
+                if (circle.empty()) return make_twiddle<SampleType, Complex>(n, k, /*inverse=*/false);
+                return circle[(k % n) * (circle.size() / n)];
+            };
+
+            // Mixed-radix passes read W_N^(k*q) for all radices q < p, so they index the whole circle
+            if (kernel == FFTKernel::MixedRadix) {
+                twiddles.resize(N);
+                for (std::size_t k = 0; k < N; ++k) {
+                    twiddles[k] = twiddle(N, k);
+                }
+                return;
+            }
+
+            // Bluestein: with the chirp w_n = W_2N^(n^2), nk = (n^2 + k^2 - (k-n)^2) / 2 turns the
+            // DFT into X_k = w_k * sum_n (x_n w_n) conj(w_(k-n)), a circular convolution once it is
+            // zero-padded to M >= 2N-1 points. The filter conj(w) is transformed once, here, in
+            // double precision, and stored at full scale: times 2^-e for the smallest e with
+            // |re| + |im| <= 1 in every bin, so a spectrum bin times a filter bin cannot grow. The
+            // rest of the convolution's 1/M, 2^(e - log2 M), is a rounding shift of each product
+            // (filter_shift bits). Its bins are about 1/sqrt(M), so storing F/M itself would keep
+            // only a few bits of them in 16-bit formats. It is stored in the order the
+            // convolution's forward_bitreversed leaves its spectrum in.
+            if (kernel == FFTKernel::Bluestein) {
+                std::size_t M = bluestein_size(N);
+                sub_plans.emplace_back(M, FFTKernel::Auto);
+                twiddles.resize(N);
+                std::vector<std::complex<double>> filter(M);
+                // n^2 mod 2N, stepped by (n+1)^2 = n^2 + 2n + 1
+                for (std::size_t n = 0, n2 = 0; n < N; n2 = (n2 + 2 * n + 1) % (2 * N), ++n) {
+                    twiddles[n] = make_twiddle<SampleType, Complex>(2 * N, n2, /*inverse=*/false);
+                    filter[n] = make_twiddle<double>(2 * N, n2, /*inverse=*/true);
+                    if (n != 0) filter[M - n] = filter[n];
+                }
+                FFTPlan<double>(M).forward(filter);
+                // An even filter has an even spectrum; make it exactly so, since the inverse reads F[-k] as F[k]
+                for (std::size_t k = M / 2 + 1; k < M; ++k) filter[k] = filter[M - k];
+                double peak = 0.0;
+                for (const auto& f : filter) peak = std::max(peak, std::abs(f.real()) + std::abs(f.imag()));
+                const int log2_M = std::countr_zero(M);
+                int e = 0;
+                for (double bound = 1.0; bound < peak && e < log2_M; bound *= 2.0) ++e;
+                filter_shift = log2_M - e;
+                const double scale = 1.0 / double(std::size_t(1) << e);
+                const auto& convolution = sub_plans[0];
+                kernel_twiddles.resize(M);
+                for (std::size_t k = 0; k < M; ++k) {
+                    const auto& f = filter[convolution.bit_reversed_passes() ? convolution.bitrev[k] : k];
+                    kernel_twiddles[k] = Complex(SampleType{ f.real() * scale }, SampleType{ f.imag() * scale });
+                }
+                return;
+            }
+
+            // Four-step plans only need their sub-plans and the N1 x N2 twiddle matrix
+            if (kernel == FFTKernel::FourStep) {
+                std::size_t N1 = std::size_t(1) << (std::countr_zero(N) / 2);
+                std::size_t N2 = N / N1;
+                sub_plans.emplace_back(N2, FFTKernel::Auto, circle);
+                sub_plans.emplace_back(N1, FFTKernel::Auto, circle);
+                // W_N^(n1*k2), stored in the order the row pass reads it
+                kernel_twiddles.resize(N);
+                for (std::size_t n1 = 0; n1 < N1; ++n1) {
+                    for (std::size_t k2 = 0; k2 < N2; ++k2) {
+                        kernel_twiddles[n1 * N2 + k2] = twiddle(N, n1 * k2);
+                    }
+                }
+                return;
+            }
 
             // Compute log2(N) as an integer number of bits
             std::size_t levels = 0;
             while ((std::size_t(1) << levels) < N) ++levels;
 
-            // Build the bit-reversal table
+            // Build the bit-reversal table: i's reversal is (i/2)'s shifted down one bit,
+            // with i's lowest bit moved to the top
             bitrev.resize(N);
-            for (std::size_t i = 0; i < N; ++i) {
-                std::size_t r = 0;
-                for (std::size_t j = 0; j < levels; ++j) {
-                    // extract bit j of i, put it at position (levels-1-j)
-                    if (i & (std::size_t(1) << j)) {
-                        r |= (std::size_t(1) << (levels - 1 - j));
-                    }
-                }
-                bitrev[i] = r;
+            bitrev[0] = 0;
+            for (std::size_t i = 1; i < N; ++i) {
+                bitrev[i] = (bitrev[i >> 1] >> 1) | ((i & 1) << (levels - 1));
             }
 
             // Precompute forward twiddles W_N^k for k=0..N/2−1
             twiddles.resize(N / 2);
             for (std::size_t k = 0; k < N / 2; ++k) {
-                twiddles[k] = make_twiddle<SampleType>(N, k, /*inverse=*/false);
+                twiddles[k] = twiddle(N, k);
+            }
+
+            // Contiguous twiddles for the radix-4 passes: W^j, W^2j, W^3j of W_4q for j=1..q-1
+            if (this->kernel == FFTKernel::Radix4) {
+                kernel_twiddles.reserve(N);
+                for (std::size_t q = first_radix4_quarter(); 4 * q <= N; q *= 4) {
+                    for (std::size_t j = 1; j < q; ++j) {
+                        kernel_twiddles.push_back(twiddle(4 * q, j));
+                        kernel_twiddles.push_back(twiddle(4 * q, 2 * j));
+                        kernel_twiddles.push_back(twiddle(4 * q, 3 * j));
+                    }
+                }
+            }
+
+            // Split radix: W_n^k, W_n^3k for k=1..n/4-1, for n = 8, 16, ..., N (see split_offset)
+            if (this->kernel == FFTKernel::SplitRadix) {
+                kernel_twiddles.reserve(N);
+                for (std::size_t n = 8; n <= N; n *= 2) {
+                    for (std::size_t k = 1; k < n / 4; ++k) {
+                        kernel_twiddles.push_back(twiddle(n, k));
+                        kernel_twiddles.push_back(twiddle(n, 3 * k));
+                    }
+                }
+            }
+        }
+
+        // The kernel a plan of size N runs for `kernel` (resolves Auto)
+        static constexpr FFTKernel choose_kernel(std::size_t N, FFTKernel kernel) {
+            if (kernel != FFTKernel::Auto) return kernel;
+            if ((N & (N - 1)) != 0 || N == 0) {
+                return mixed_radix_size(N) ? FFTKernel::MixedRadix : FFTKernel::Bluestein;
+            }
+            return (N * sizeof(Complex) >= fft_four_step_min_bytes) ? FFTKernel::FourStep : FFTKernel::Radix4;
+        }
+
+        // True when N has no prime factors other than 2, 3 and 5
+        static constexpr bool mixed_radix_size(std::size_t N) {
+            if (N == 0) return false;
+            for (std::size_t p : { 2, 3, 5 }) {
+                while (N % p == 0) N /= p;
             }
+            return N == 1;
+        }
+
+        // Length of a Bluestein plan's convolution: the power of two >= 2N-1
+        static constexpr std::size_t bluestein_size(std::size_t N) {
+            return std::bit_ceil(2 * N - 1);
         }
 
         // In‐place forward FFT (no 1/N scaling)
-        void forward(std::vector<complex_sample<SampleType>>& data) const {
+        constexpr void forward(std::vector<Complex>& data) const {
+            forward(std::span<Complex>(data));
+        }
+
+        // Same on any contiguous buffer of N samples (rows of a larger array, scratch space, ...)
+        constexpr void forward(std::span<Complex> data) const {
             if (data.size() != N) {
 				throw std::invalid_argument("Data size must match FFT plan size");
             }
+            transform<false>(data);
+        }
 
-            // Bit reverse the input data
-            for (std::size_t i = 0; i < N; ++i) {
-                if (i < bitrev[i]) {
-                    std::swap(data[i], data[bitrev[i]]);
+        // Block-floating-point forward FFT. Before each pass the block is shifted right just
+        // enough to leave the headroom the pass can use (a radix-2 butterfly can grow a component
+        // by 1 + sqrt(2), a radix-4 one by 1 + 3*sqrt(2)), so nothing saturates; the shifts are
+        // added to block.exponent. Radix4 plans run radix-4 passes, the others radix-2 passes;
+        // FourStep plans (what Auto picks for large N) scale each sub-transform on its own and
+        // align the results to one exponent per step (see scaled_four_step).
+        constexpr void forward(BlockFloat<Complex>& block) const requires is_fixed_point_v<SampleType> {
+            block_transform<false>(block);
+        }
+
+        // Forward FFT that keeps a fixed-point spectrum in range (see FFTScaling) and returns its
+        // exponent: the transform is data * 2^exponent. PerStage is cheap and predictable but
+        // always gives up log2(N) bits; Conditional shifts only as far as the data needs, so
+        // small signals keep their precision. The scaled modes run a Radix4 plan's radix-4
+        // passes and radix-2 passes for Radix2 and SplitRadix plans. FourStep plans (what Auto
+        // picks from fft_four_step_min_bytes of data) scale their column and row sub-transforms,
+        // so Conditional may spend a bit more than a Radix4 plan would. MixedRadix and Bluestein
+        // plans take None only.
+        constexpr int forward(std::span<Complex> data, FFTScaling scaling) const requires is_fixed_point_v<SampleType> {
+            if (data.size() != N) {
+                throw std::invalid_argument("Data size must match FFT plan size");
+            }
+            if (scaling == FFTScaling::None) {
+                transform<false>(data);
+                return 0;
+            }
+            return scaled_transform<false>(data, scaling);
+        }
+
+        constexpr int forward(std::vector<Complex>& data, FFTScaling scaling) const requires is_fixed_point_v<SampleType> {
+            return forward(std::span<Complex>(data), scaling);
+        }
+
+        // In‐place inverse FFT (with 1/N scaling). This runs the forward kernel's passes with
+        // conjugate twiddles rather than conjugating around forward(), and the 1/N is applied to
+        // the outputs of the last pass, so there is no extra trip over the data.
+        constexpr void inverse(std::vector<Complex>& data) const {
+            inverse(std::span<Complex>(data));
+        }
+
+        constexpr void inverse(std::span<Complex> data) const {
+            if (data.size() != N) {
+                throw std::invalid_argument("Data size must match FFT plan size");
+            }
+            transform<true>(data);
+        }
+
+        // Block-floating-point inverse FFT: the 1/N scaling is only an exponent change
+        constexpr void inverse(BlockFloat<Complex>& block) const requires is_fixed_point_v<SampleType> {
+            block_transform<true>(block);
+            block.exponent -= static_cast<int>(std::countr_zero(N));
+        }
+
+        // Forward FFT that leaves the spectrum in bit-reversed order (X[bitrev[k]] at k). The passes
+        // are decimation-in-frequency, the DIT ones run backwards with the twiddles moved to the
+        // butterfly outputs, so no permutation is needed. When the spectrum is only an intermediate
+        // (fast convolution, correlation), multiply it by another bit-reversed spectrum with
+        // multiply_spectra and hand the product to inverse_bitreversed: neither of the two
+        // bit-reversal passes is run. Radix4 plans run radix-4 passes, Radix2 and SplitRadix plans
+        // radix-2 ones. FourStep plans (what Auto picks from fft_four_step_min_bytes of data) keep
+        // no bitrev table: they skip the final transpose instead, leaving X[(k % N1) * N2 + k / N1]
+        // at k (N1 = sub_plans[1].N, N2 = N / N1). MixedRadix and Bluestein plans throw.
+        constexpr void forward_bitreversed(std::span<Complex> data) const {
+            check_bitreversed(data);
+            if (kernel == FFTKernel::FourStep) {
+                four_step_transposed<false>(data, detail::SerialFor{}, N);
+                return;
+            }
+            dif_passes(data);
+        }
+
+        constexpr void forward_bitreversed(std::vector<Complex>& data) const {
+            forward_bitreversed(std::span<Complex>(data));
+        }
+
+        // Inverse FFT (with 1/N scaling) of a bit-reversed spectrum: inverse() without its permutation
+        constexpr void inverse_bitreversed(std::span<Complex> data) const {
+            check_bitreversed(data);
+            if (kernel == FFTKernel::FourStep) {
+                four_step_transposed_inverse(data);
+                return;
+            }
+            dit_passes<true>(data);
+        }
+
+        constexpr void inverse_bitreversed(std::vector<Complex>& data) const {
+            inverse_bitreversed(std::span<Complex>(data));
+        }
+
+        // Forward FFT of howmany transforms in one buffer: sample n of transform t is
+        // data[t * dist + n * stride] (stride 1, dist N for back-to-back buffers; stride
+        // howmany, dist 1 for interleaved channels). See the span-of-buffers overload.
+        void forward_batch(std::span<Complex> data, std::size_t howmany, std::size_t stride, std::size_t dist,
+                           std::size_t threads = 0) const {
+            if (howmany == 0) return;
+            if ((stride == 0 && N > 1) || (howmany - 1) * dist + (N - 1) * stride >= data.size()) {
+                throw std::invalid_argument("Batch layout exceeds the data buffer");
+            }
+            Complex* base = data.data();
+            run_batch(howmany, threads, [=](std::size_t t) { return base + t * dist; }, stride);
+        }
+
+        // Forward FFT of every buffer (each N samples). FixedPoint std::complex batches of a
+        // Radix2 or Radix4 plan are transformed a group at a time with one transform per SIMD lane: each group is
+        // gathered into split re/im arrays in bit-reversed order and every butterfly runs on
+        // the whole group through simd::butterfly. That path runs the plan's own stages or
+        // passes, so its output is bit-identical to forward(). Other kernels and types loop
+        // over forward(). The batch is split over `threads`
+        // workers; 0 picks std::thread::hardware_concurrency() for batches of at least
+        // fft_batch_thread_min_points points and one thread below that.
+        void forward_batch(std::span<const std::span<Complex>> buffers, std::size_t threads = 0) const {
+            for (const auto& b : buffers) {
+                if (b.size() != N) throw std::invalid_argument("Data size must match FFT plan size");
+            }
+            run_batch(buffers.size(), threads, [&](std::size_t t) { return buffers[t].data(); }, 1);
+        }
+
+        void forward_batch(std::span<std::vector<Complex>> buffers, std::size_t threads = 0) const {
+            for (const auto& b : buffers) {
+                if (b.size() != N) throw std::invalid_argument("Data size must match FFT plan size");
+            }
+            run_batch(buffers.size(), threads, [&](std::size_t t) { return buffers[t].data(); }, 1);
+        }
+
+        // Forward FFT of one large transform on `threads` threads (0: hardware_concurrency()).
+        // A FourStep plan splits each of its steps (the column sub-FFTs, the row sub-FFTs and
+        // the transpose) into tasks of at least `grain` points, which the threads take from a
+        // shared queue as they become free; the result is bit-identical to forward(). Plans
+        // with other kernels have no independent sub-transforms and run forward() as is.
+        void forward_parallel(std::span<Complex> data, std::size_t threads = 0,
+                              std::size_t grain = fft_parallel_grain_points) const {
+            parallel_transform<false>(data, threads, grain);
+        }
+
+        void forward_parallel(std::vector<Complex>& data, std::size_t threads = 0,
+                              std::size_t grain = fft_parallel_grain_points) const {
+            forward_parallel(std::span<Complex>(data), threads, grain);
+        }
+
+        // Inverse FFT (with 1/N scaling) on `threads` threads, as forward_parallel
+        void inverse_parallel(std::span<Complex> data, std::size_t threads = 0,
+                              std::size_t grain = fft_parallel_grain_points) const {
+            parallel_transform<true>(data, threads, grain);
+        }
+
+        void inverse_parallel(std::vector<Complex>& data, std::size_t threads = 0,
+                              std::size_t grain = fft_parallel_grain_points) const {
+            inverse_parallel(std::span<Complex>(data), threads, grain);
+        }
+
+    private:
+        constexpr void check_bitreversed(std::span<const Complex> data) const {
+            if (data.size() != N) {
+                throw std::invalid_argument("Data size must match FFT plan size");
+            }
+            if (!bit_reversed_passes() && kernel != FFTKernel::FourStep) {
+                throw std::invalid_argument("Bit-reversed FFT needs a Radix2, Radix4, SplitRadix or FourStep kernel");
+            }
+        }
+
+        template<bool Inverse>
+        void parallel_transform(std::span<Complex> data, std::size_t threads, std::size_t grain) const {
+            if (data.size() != N) {
+                throw std::invalid_argument("Data size must match FFT plan size");
+            }
+            if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+            if (kernel != FFTKernel::FourStep || threads == 1) {
+                transform<Inverse>(data);
+                return;
+            }
+            four_step<Inverse>(data, detail::ParallelFor{ threads }, grain);
+        }
+
+        // Filled in field by field when a plan is read back from a wisdom file
+        friend class FFTPlanCache<SampleType, Complex>;
+        FFTPlan() = default;
+
+        // Lane-interleaved batches need SIMD kernels for SampleType and std::complex's multiply
+        static constexpr bool lane_batchable = [] {
+            if constexpr (is_fixed_point_v<SampleType>) {
+                return fixed_point::simd::detail::batch_traits<SampleType>::vectorizable
+                       && std::is_same_v<Complex, std::complex<SampleType>>;
+            } else {
+                return false;
+            }
+        }();
+
+        // One AVX-512 register of lanes
+        static constexpr std::size_t batch_lanes = lane_batchable ? 64 / sizeof(SampleType) : 1;
+
+        // Transform t starts at base(t); its samples are stride apart
+        template<typename Base>
+        void run_batch(std::size_t howmany, std::size_t threads, Base base, std::size_t stride) const {
+            if (threads == 0) {
+                threads = howmany * N >= fft_batch_thread_min_points ? std::max(1u, std::thread::hardware_concurrency()) : 1;
+            }
+            // Whole lane groups per worker
+            std::size_t groups = (howmany + batch_lanes - 1) / batch_lanes;
+            threads = std::min(threads, groups);
+            if (threads <= 1) {
+                batch_range(base, stride, 0, howmany);
+                return;
+            }
+            std::vector<std::jthread> workers;
+            workers.reserve(threads - 1);
+            std::size_t per_worker = (groups + threads - 1) / threads * batch_lanes;
+            for (std::size_t t0 = per_worker; t0 < howmany; t0 += per_worker) {
+                workers.emplace_back([=, this] { batch_range(base, stride, t0, std::min(howmany, t0 + per_worker)); });
+            }
+            batch_range(base, stride, 0, std::min(howmany, per_worker));
+        }
+
+        template<typename Base>
+        void batch_range(Base base, std::size_t stride, std::size_t t0, std::size_t t1) const {
+            std::size_t t = t0;
+            if constexpr (lane_batchable) {
+                bool lanes_fit = 2 * N * batch_lanes * sizeof(SampleType) <= fft_batch_lane_max_bytes;
+                bool lane_kernel = kernel == FFTKernel::Radix2 || kernel == FFTKernel::Radix4;
+                if (lane_kernel && N >= 2 && lanes_fit) {
+                    std::vector<SampleType> re(N * batch_lanes), im(N * batch_lanes), work(4 * batch_lanes);
+                    // A short last group is still worth it once it fills a few lanes
+                    for (; t + 4 <= t1; t += batch_lanes) {
+                        std::size_t lanes = std::min(batch_lanes, t1 - t);
+                        lane_group(base, stride, t, lanes, re.data(), im.data(), work.data());
+                    }
+                }
+            }
+            if (t >= t1) return;
+            std::vector<Complex> scratch(stride == 1 ? 0 : N);
+            for (; t < t1; ++t) {
+                Complex* x = base(t);
+                if (stride == 1) {
+                    forward(std::span<Complex>(x, N));
+                    continue;
+                }
+                for (std::size_t n = 0; n < N; ++n) scratch[n] = x[n * stride];
+                forward(std::span<Complex>(scratch));
+                for (std::size_t n = 0; n < N; ++n) x[n * stride] = scratch[n];
+            }
+        }
+
+        // FFT of `lanes` transforms at once, with the plan's own radix-2 stages or radix-4 passes;
+        // sample n of lane l lives at re/im[n * lanes + l]. work holds four rows of lanes.
+        template<typename Base>
+        void lane_group(Base base, std::size_t stride, std::size_t t0, std::size_t lanes,
+                        SampleType* re, SampleType* im, SampleType* work) const {
+            namespace simd = fixed_point::simd;
+            for (std::size_t n = 0; n < N; ++n) {
+                std::size_t src = bitrev[n] * stride;
+                for (std::size_t l = 0; l < lanes; ++l) {
+                    const Complex& x = base(t0 + l)[src];
+                    re[n * lanes + l] = x.real();
+                    im[n * lanes + l] = x.imag();
                 }
             }
 
-            // Perform the iterative butterfly FFT algorithm
-            for (std::size_t len = 2; len <= N; len <<= 1) {
-                auto half = len >> 1;
-				auto step = N / len;
+            auto row = [&](SampleType* p, std::size_t n) { return std::span<SampleType>(p + n * lanes, lanes); };
+            auto radix2_stage = [&](std::size_t len) {
+                std::size_t half = len >> 1, quarter = half >> 1, step = N / len;
                 for (std::size_t i = 0; i < N; i += len) {
                     for (std::size_t j = 0; j < half; ++j) {
-                        auto u = data[i + j];
-                        auto v = data[i + j + half] * twiddles[j * step];
-                        data[i + j] = u + v;
-                        data[i + j + half] = u - v;
+                        std::size_t u = i + j, x = u + half;
+                        if (j == 0) {
+                            simd::butterfly_one(row(re, u), row(im, u), row(re, x), row(im, x));
+                        } else if (j == quarter) {
+                            simd::butterfly_minus_j(row(re, u), row(im, u), row(re, x), row(im, x));
+                        } else {
+                            const Complex& w = twiddles[j * step];
+                            simd::butterfly(row(re, u), row(im, u), row(re, x), row(im, x), w.real(), w.imag());
+                        }
                     }
-				}
+                }
+            };
+
+            if (kernel != FFTKernel::Radix4) {
+                for (std::size_t len = 2; len <= N; len <<= 1) radix2_stage(len);
+            } else {
+                if (first_radix4_quarter() == 2) radix2_stage(2);
+                // radix4_pass, butterfly by butterfly. A twiddle product on its own is a butterfly
+                // into a zeroed row (0 + v), which keeps every rounding step of std::complex's multiply.
+                auto c2r = row(work, 0), c2i = row(work, 1), c3r = row(work, 2), c3i = row(work, 3);
+                auto product = [&](std::span<SampleType> out_r, std::span<SampleType> out_i, std::size_t n,
+                                   const Complex& w) {
+                    std::fill(out_r.begin(), out_r.end(), SampleType(0));
+                    std::fill(out_i.begin(), out_i.end(), SampleType(0));
+                    simd::butterfly(out_r, out_i, row(re, n), row(im, n), w.real(), w.imag());
+                };
+                for (std::size_t q = first_radix4_quarter(), offset = 0; 4 * q <= N; offset += 3 * (q - 1), q *= 4) {
+                    for (std::size_t i = 0; i < N; i += 4 * q) {
+                        simd::butterfly_one(row(re, i), row(im, i), row(re, i + q), row(im, i + q));
+                        simd::butterfly_one(row(re, i + 2 * q), row(im, i + 2 * q), row(re, i + 3 * q), row(im, i + 3 * q));
+                        simd::butterfly_one(row(re, i), row(im, i), row(re, i + 2 * q), row(im, i + 2 * q));
+                        simd::butterfly_minus_j(row(re, i + q), row(im, i + q), row(re, i + 3 * q), row(im, i + 3 * q));
+                        for (std::size_t j = 1; j < q; ++j) {
+                            const Complex* wj = kernel_twiddles.data() + offset + 3 * (j - 1);
+                            std::size_t p = i + j;
+                            simd::butterfly(row(re, p), row(im, p), row(re, p + q), row(im, p + q), wj[1].real(), wj[1].imag());
+                            product(c2r, c2i, p + 2 * q, wj[0]);
+                            product(c3r, c3i, p + 3 * q, wj[2]);
+                            simd::butterfly_one(c2r, c2i, c3r, c3i);
+                            simd::butterfly_one(row(re, p), row(im, p), c2r, c2i);
+                            simd::butterfly_minus_j(row(re, p + q), row(im, p + q), c3r, c3i);
+                            std::ranges::copy(c2r, row(re, p + 2 * q).begin());
+                            std::ranges::copy(c2i, row(im, p + 2 * q).begin());
+                            std::ranges::copy(c3r, row(re, p + 3 * q).begin());
+                            std::ranges::copy(c3i, row(im, p + 3 * q).begin());
+                        }
+                    }
+                }
+            }
+
+            for (std::size_t l = 0; l < lanes; ++l) {
+                Complex* x = base(t0 + l);
+                for (std::size_t n = 0; n < N; ++n) {
+                    x[n * stride] = Complex(re[n * lanes + l], im[n * lanes + l]);
+                }
             }
         }
 
-        // In‐place inverse FFT (with 1/N scaling)
-        void inverse(std::vector<complex_sample<SampleType>>& data) const {
-            if (data.size() != N) {
+        // Kernels that run radix-2/4 passes over bit-reversed data in place
+        constexpr bool bit_reversed_passes() const {
+            return kernel == FFTKernel::Radix2 || kernel == FFTKernel::Radix4 || kernel == FFTKernel::SplitRadix;
+        }
+
+        constexpr void bit_reverse(std::span<Complex> data) const {
+            for (std::size_t i = 0; i < N; ++i) {
+                if (i < bitrev[i]) {
+                    std::swap(data[i], data[bitrev[i]]);
+                }
+            }
+        }
+
+        // Radix-4 passes start at quarter 1, or at 2 after a radix-2 pass when log2(N) is odd
+        constexpr std::size_t first_radix4_quarter() const {
+            return (std::countr_zero(N) % 2 == 0) ? 1 : 2;
+        }
+
+        // Forward transform, or the inverse: the same passes with conjugate twiddles and +j for
+        // -j, and the 1/N folded into the last pass (see detail::with_pass_scale)
+        template<bool Inverse>
+        constexpr void transform(std::span<Complex> data) const {
+            switch (kernel) {
+            case FFTKernel::FourStep:
+                four_step<Inverse>(data, detail::SerialFor{}, N);
+                return;
+            case FFTKernel::MixedRadix: {
+                std::vector<Complex> local;
+                auto input = scratch<FFTKernel::MixedRadix>(N, local);
+                std::ranges::copy(data, input.begin());
+                mixed_radix<Inverse>(data.data(), input.data(), 1, N);
+                return;
+            }
+            case FFTKernel::Bluestein:
+                bluestein<Inverse>(data);
+                return;
+            default:
+                break;
+            }
+
+            bit_reverse(data);
+            dit_passes<Inverse>(data);
+        }
+
+        // The passes of a Radix2, Radix4 or SplitRadix transform on bit-reversed data; Scaled
+        // inverses fold the 1/N into the last one
+        template<bool Inverse, bool Scaled = Inverse>
+        constexpr void dit_passes(std::span<Complex> data) const {
+            switch (kernel) {
+            case FFTKernel::Radix4:
+                if (first_radix4_quarter() == 2) {
+                    detail::with_pass_scale<SampleType, Inverse>(N, Scaled && N == 2, [&](auto scale) {
+                        butterfly_stage<Inverse>(data, 2, detail::NoScale{}, scale);
+                    });
+                }
+                for (std::size_t q = first_radix4_quarter(), offset = 0; 4 * q <= N; offset += 3 * (q - 1), q *= 4) {
+                    detail::with_pass_scale<SampleType, Inverse>(N, Scaled && 4 * q == N, [&](auto scale) {
+                        radix4_pass<Inverse>(data, q, kernel_twiddles.data() + offset, detail::NoScale{}, scale);
+                    });
+                }
+                break;
+            case FFTKernel::SplitRadix:
+                split_radix<Inverse, Scaled>(data.data(), N);
+                break;
+            default:
+                // Perform the iterative butterfly FFT algorithm
+                for (std::size_t len = 2; len <= N; len <<= 1) {
+                    detail::with_pass_scale<SampleType, Inverse>(N, Scaled && len == N, [&](auto scale) {
+                        butterfly_stage<Inverse>(data, len, detail::NoScale{}, scale);
+                    });
+                }
+                break;
+            }
+        }
+
+        // Forward DIF passes, natural order in and bit-reversed out: the Radix4 passes from the
+        // largest quarter down, then the radix-2 span-2 stage a DIT transform starts with when
+        // log2(N) is odd; Radix2 and SplitRadix plans run radix-2 stages from span N down
+        constexpr void dif_passes(std::span<Complex> data) const {
+            if (kernel != FFTKernel::Radix4) {
+                for (std::size_t len = N; len >= 2; len >>= 1) dif_butterfly_stage(data, len);
+                return;
+            }
+            const std::size_t first = first_radix4_quarter();
+            if (4 * first <= N) {
+                std::size_t q = first, offset = 0;
+                for (; 16 * q <= N; q *= 4) offset += 3 * (q - 1);
+                for (;;) {
+                    dif_radix4_pass(data, q, kernel_twiddles.data() + offset);
+                    if (q == first) break;
+                    q /= 4;
+                    offset -= 3 * (q - 1);
+                }
+            }
+            if (first == 2) dif_butterfly_stage(data, 2);
+        }
+
+        // Radix-2 DIF stage with span len: u + v, and u - v times W^j (none for W = 1 or -j)
+        constexpr void dif_butterfly_stage(std::span<Complex> data, std::size_t len) const {
+            auto half = len >> 1;
+            auto quarter = half >> 1;
+            auto step = N / len;
+            for (std::size_t i = 0; i < N; i += len) {
+                Complex* x = data.data() + i;
+                Complex* y = x + half;
+                auto difference = [&](std::size_t j) {
+                    auto u = x[j], v = y[j];
+                    x[j] = u + v;
+                    return u - v;
+                };
+                y[0] = difference(0);
+                if (quarter == 0) continue;
+                for (std::size_t j = 1; j < quarter; ++j) y[j] = difference(j) * twiddles[j * step];
+                y[quarter] = detail::quarter_turn<false>(difference(quarter));
+                for (std::size_t j = quarter + 1; j < half; ++j) y[j] = difference(j) * twiddles[j * step];
+            }
+        }
+
+        // The radix-4 DIF pass for quarter q: radix4_pass in reverse, with its twiddle table. Output
+        // r of the 4-point DFT goes to the quarter whose index is r's two bits reversed (0, 2, 1, 3),
+        // taking W^(rj) on the way out.
+        constexpr void dif_radix4_pass(std::span<Complex> data, std::size_t q, const Complex* w) const {
+            auto butterfly = [&](std::size_t p, const auto& rotate) {
+                auto a0 = data[p], a1 = data[p + q], a2 = data[p + 2 * q], a3 = data[p + 3 * q];
+                auto s0 = a0 + a2, d0 = a0 - a2;
+                auto s1 = a1 + a3;
+                auto d1 = detail::quarter_turn<false>(a1 - a3);
+                data[p] = s0 + s1;
+                data[p + q] = rotate(s0 - s1, 1);
+                data[p + 2 * q] = rotate(d0 + d1, 0);
+                data[p + 3 * q] = rotate(d0 - d1, 2);
+            };
+            for (std::size_t i = 0; i < N; i += 4 * q) {
+                butterfly(i, [](const Complex& z, std::size_t) { return z; });
+                for (std::size_t j = 1; j < q; ++j) {
+                    const Complex* wj = w + 3 * (j - 1);
+                    butterfly(i + j, [wj](const Complex& z, std::size_t t) { return z * wj[t]; });
+                }
+            }
+        }
+
+        // Block-floating-point passes: unscaled, with headroom made before each one
+        template<bool Inverse>
+        constexpr void block_transform(BlockFloat<Complex>& block) const {
+            if (block.size() != N) {
                 throw std::invalid_argument("Data size must match FFT plan size");
             }
+            block.exponent += scaled_transform<Inverse>(block.mantissas, FFTScaling::Conditional);
+        }
 
-            // Conjugate the input for inverse FFT
-			for (auto& x : data) x = std::conj(x);  
+        // Bit-reversed radix-2/4 passes with PerStage or Conditional scaling; returns the exponent.
+        // Conditional shifts a pass's inputs by what the previous pass's outputs lacked of the
+        // headroom this one needs (a radix-2 butterfly can grow a component by 1 + sqrt(2), a
+        // radix-4 one by 1 + 3*sqrt(2)), so it matches BlockFloat::ensure_headroom before each pass.
+        // FourStep plans scale their sub-transforms instead (see scaled_four_step).
+        template<bool Inverse>
+        constexpr int scaled_transform(std::span<Complex> data, FFTScaling scaling) const {
+            if (kernel == FFTKernel::FourStep) {
+                return scaled_four_step<Inverse>(data, scaling);
+            }
+            if (!bit_reversed_passes()) {
+                throw std::invalid_argument("Scaled FFT needs a Radix2, Radix4, SplitRadix or FourStep kernel");
+            }
+            using Component = typename detail::mantissa_traits<Complex>::component;
+            const bool conditional = scaling == FFTScaling::Conditional;
+            std::make_unsigned_t<typename Component::StorageType> used = 0;
+            int headroom = conditional ? detail::block_headroom(std::span<const Complex>(data)) : 0;
+            int exponent = 0;
 
-            // Reuse the forward FFT
-			forward(data); 
+            // One pass: radix-2 stages shift by one bit, radix-4 passes by two
+            auto pass = [&](int needed, int per_stage, auto&& run) {
+                int shift = conditional ? std::max(needed - headroom, 0) : per_stage;
+                exponent += shift;
+                detail::with_shift(shift, [&](const auto& in) {
+                    if (conditional) {
+                        used = 0;
+                        run(in, detail::TrackHeadroom<Complex>{ &used });
+                        headroom = detail::headroom_of_bits<Component>(used);
+                    } else {
+                        run(in, detail::NoScale{});
+                    }
+                });
+            };
 
-            // Conjugate back to get the correct inverse
-			for (auto& x : data) x = std::conj(x);
+            bit_reverse(data);
+            if (kernel == FFTKernel::Radix4) {
+                if (first_radix4_quarter() == 2) {
+                    pass(2, 1, [&](const auto& in, const auto& out) { butterfly_stage<Inverse>(data, 2, in, out); });
+                }
+                for (std::size_t q = first_radix4_quarter(), offset = 0; 4 * q <= N; offset += 3 * (q - 1), q *= 4) {
+                    pass(3, 2, [&](const auto& in, const auto& out) {
+                        radix4_pass<Inverse>(data, q, kernel_twiddles.data() + offset, in, out);
+                    });
+                }
+            } else {
+                for (std::size_t len = 2; len <= N; len <<= 1) {
+                    pass(2, 1, [&](const auto& in, const auto& out) { butterfly_stage<Inverse>(data, len, in, out); });
+                }
+            }
+            return exponent;
+        }
+
+        // All radix-2 butterflies of one stage with span len; W = 1 and W = -j need no multiply.
+        // in scales the stage's inputs and scale its outputs (FFTScaling, inverse 1/N).
+        template<bool Inverse, typename In, typename Scale>
+        constexpr void butterfly_stage(std::span<Complex> data, std::size_t len, const In& in, const Scale& scale) const {
+            auto half = len >> 1;
+            auto quarter = half >> 1;
+            auto step = N / len;
+            for (std::size_t i = 0; i < N; i += len) {
+                auto butterfly = [&](std::size_t j, const Complex& v) {
+                    auto u = in(data[i + j]);
+                    data[i + j] = scale(u + v);
+                    data[i + j + half] = scale(u - v);
+                };
+                butterfly(0, in(data[i + half]));
+                if (quarter == 0) continue;
+                for (std::size_t j = 1; j < quarter; ++j) {
+                    butterfly(j, detail::twiddle_mul<Inverse>(in(data[i + j + half]), twiddles[j * step]));
+                }
+                butterfly(quarter, detail::quarter_turn<Inverse>(in(data[i + quarter + half])));
+                for (std::size_t j = quarter + 1; j < half; ++j) {
+                    butterfly(j, detail::twiddle_mul<Inverse>(in(data[i + j + half]), twiddles[j * step]));
+                }
+            }
+        }
+
+        // Two radix-2 stages (spans 2q and 4q) fused into one radix-4 pass on bit-reversed data.
+        // With W = W_4q the four inputs take twiddles 1, W^2j, W^j, W^3j (three multiplies, none at
+        // j = 0) and the pass needs one trip over memory instead of two.
+        template<bool Inverse, typename In, typename Scale>
+        constexpr void radix4_pass(std::span<Complex> data, std::size_t q, const Complex* w, const In& in,
+                                   const Scale& scale) const {
+            for (std::size_t i = 0; i < N; i += 4 * q) {
+                radix4_butterfly<Inverse>(data, i, q, scale, in(data[i]), in(data[i + q]), in(data[i + 2 * q]),
+                                          in(data[i + 3 * q]));
+                for (std::size_t j = 1; j < q; ++j) {
+                    const Complex* wj = w + 3 * (j - 1);
+                    std::size_t p = i + j;
+                    radix4_butterfly<Inverse>(data, p, q, scale, in(data[p]),
+                                              detail::twiddle_mul<Inverse>(in(data[p + q]), wj[1]),
+                                              detail::twiddle_mul<Inverse>(in(data[p + 2 * q]), wj[0]),
+                                              detail::twiddle_mul<Inverse>(in(data[p + 3 * q]), wj[2]));
+                }
+            }
+        }
+
+        template<bool Inverse, typename Scale>
+        constexpr void radix4_butterfly(std::span<Complex> data, std::size_t p, std::size_t q, const Scale& scale,
+                                        const Complex& c0, const Complex& c1, const Complex& c2, const Complex& c3) const {
+            auto s0 = c0 + c1, d0 = c0 - c1;
+            auto s1 = c2 + c3;
+            auto d1 = detail::quarter_turn<Inverse>(c2 - c3);
+            data[p] = scale(s0 + s1);
+            data[p + q] = scale(d0 + d1);
+            data[p + 2 * q] = scale(s0 - s1);
+            data[p + 3 * q] = scale(d0 - d1);
+        }
+
+        // In-place split-radix DIT on bit-reversed data: the first half holds the even-index
+        // transform, the last two quarters the 4n+1 and 4n+3 ones
+        template<bool Inverse, bool Scaled = Inverse>
+        constexpr void split_radix(Complex* x, std::size_t n) const {
+            if (n == 1) return;
+            if (n == 2) {
+                detail::with_pass_scale<SampleType, Inverse>(N, Scaled && n == N, [&](auto scale) {
+                    auto u = x[0], v = x[1];
+                    x[0] = scale(u + v);
+                    x[1] = scale(u - v);
+                });
+                return;
+            }
+            split_radix<Inverse, Scaled>(x, n / 2);
+            split_radix<Inverse, Scaled>(x + n / 2, n / 4);
+            split_radix<Inverse, Scaled>(x + 3 * n / 4, n / 4);
+
+            std::size_t q = n / 4;
+            detail::with_pass_scale<SampleType, Inverse>(N, Scaled && n == N, [&](auto scale) {
+                auto combine = [&](std::size_t k, const Complex& z, const Complex& z3) {
+                    auto s = z + z3;
+                    auto d = detail::quarter_turn<Inverse>(z - z3);
+                    auto u0 = x[k], u1 = x[k + q];
+                    x[k] = scale(u0 + s);
+                    x[k + 2 * q] = scale(u0 - s);
+                    x[k + q] = scale(u1 + d);
+                    x[k + 3 * q] = scale(u1 - d);
+                };
+                combine(0, x[2 * q], x[3 * q]);
+                const Complex* w = kernel_twiddles.data() + split_offset(n);
+                for (std::size_t k = 1; k < q; ++k, w += 2) {
+                    combine(k, detail::twiddle_mul<Inverse>(x[2 * q + k], w[0]),
+                            detail::twiddle_mul<Inverse>(x[3 * q + k], w[1]));
+                }
+            });
+        }
+
+        // Bailey's four-step FFT for N = N1 * N2, with the input read as an N2 x N1 matrix
+        // (n = n1 + N1*n2) and the output index k = k2 + N2*k1:
+        //   1. N2-point FFT down every column n1, then multiply by W_N^(n1*k2)
+        //   2. N1-point FFT along every row k2
+        //   3. transpose, so X[k1*N2 + k2] ends up in natural order
+        // Columns are copied out a cache line's worth at a time into a small panel, transformed
+        // there and copied back, so every sub-FFT runs in cache and the array itself is only
+        // streamed through a few times instead of log2(N) times plus a bit-reversal.
+        // The inverse runs inverse sub-transforms, whose 1/N2 and 1/N1 make 1/N.
+        // Each step is a loop of independent pieces run through for_each(count, chunk, fn),
+        // which calls fn(begin, end) on ranges of at most chunk pieces: all at once when serial,
+        // spread over threads (chunks of about `grain` points) for forward_parallel.
+        template<bool Inverse, typename ForEach>
+        constexpr void four_step(std::span<Complex> data, const ForEach& for_each, std::size_t grain) const {
+            four_step_transposed<Inverse>(data, for_each, grain);
+            four_step_transpose(data, for_each, grain);
+        }
+
+        // Steps 1 and 2 of four_step: leaves bin k1*N2 + k2 at k2*N1 + k1, the order
+        // forward_bitreversed gives a FourStep spectrum
+        template<bool Inverse, typename ForEach>
+        constexpr void four_step_transposed(std::span<Complex> data, const ForEach& for_each, std::size_t grain) const {
+            const auto& columns = sub_plans[0];
+            const auto& rows = sub_plans[1];
+            four_step_columns(data, for_each, grain, [&](std::span<Complex> column, std::size_t n1) {
+                columns.template transform<Inverse>(column);
+                four_step_twiddle<Inverse>(column, n1);
+            });
+            four_step_rows(data, for_each, grain, [&](std::span<Complex> row, std::size_t) {
+                rows.template transform<Inverse>(row);
+            });
+        }
+
+        // Inverse FFT (with 1/N scaling) of a spectrum in four_step_transposed's order: inverse
+        // row FFTs, the conjugate twiddles, then inverse column FFTs, with no transpose
+        constexpr void four_step_transposed_inverse(std::span<Complex> data) const {
+            const auto& columns = sub_plans[0];
+            const auto& rows = sub_plans[1];
+            four_step_rows(data, detail::SerialFor{}, N, [&](std::span<Complex> row, std::size_t) {
+                rows.template transform<true>(row);
+            });
+            four_step_columns(data, detail::SerialFor{}, N, [&](std::span<Complex> column, std::size_t n1) {
+                four_step_twiddle<true>(column, n1);
+                columns.template transform<true>(column);
+            });
+        }
+
+        // FFTScaling for FourStep plans: every column and row sub-transform is scaled on its own
+        // by its plan's scaled_transform, then shifted right to the largest exponent of its step,
+        // so the whole step shares one. Under Conditional a column left without headroom takes
+        // one more bit before its twiddles, which can turn a component up by sqrt(2). PerStage
+        // columns and rows all come out at log2(N2) and log2(N1) and need no alignment.
+        template<bool Inverse>
+        constexpr int scaled_four_step(std::span<Complex> data, FFTScaling scaling) const {
+            const auto& columns = sub_plans[0];
+            const auto& rows = sub_plans[1];
+            const std::size_t N1 = rows.N, N2 = columns.N;
+            const bool conditional = scaling == FFTScaling::Conditional;
+
+            std::vector<int> column_exponent(N1);
+            int column_common = 0;
+            four_step_columns(data, detail::SerialFor{}, N, [&](std::span<Complex> column, std::size_t n1) {
+                int e = columns.template scaled_transform<Inverse>(column, scaling);
+                column_exponent[n1] = e;
+                if (conditional && n1 != 0 && detail::block_headroom(std::span<const Complex>(column)) == 0) ++e;
+                column_common = std::max(column_common, e);
+            });
+
+            // The alignment and twiddles of step 1 move to the rows, once the common exponent is known
+            std::vector<int> row_exponent(N2);
+            int row_common = 0;
+            four_step_rows(data, detail::SerialFor{}, N, [&](std::span<Complex> row, std::size_t k2) {
+                for (std::size_t n1 = 0; n1 < N1; ++n1) {
+                    if (int shift = column_common - column_exponent[n1]; shift != 0) row[n1] = detail::ShiftRight{ shift }(row[n1]);
+                    if (n1 != 0 && k2 != 0) row[n1] = detail::twiddle_mul<Inverse>(row[n1], kernel_twiddles[n1 * N2 + k2]);
+                }
+                row_exponent[k2] = rows.template scaled_transform<Inverse>(row, scaling);
+                row_common = std::max(row_common, row_exponent[k2]);
+            });
+            for (std::size_t k2 = 0; k2 < N2; ++k2) {
+                if (int shift = row_common - row_exponent[k2]; shift != 0) {
+                    for (auto& z : data.subspan(k2 * N1, N1)) z = detail::ShiftRight{ shift }(z);
+                }
+            }
+
+            four_step_transpose(data, detail::SerialFor{}, N);
+            return column_common + row_common;
+        }
+
+        // Chunks of `grain` points for a four-step loop whose pieces are points_per_piece points
+        static constexpr std::size_t four_step_chunk(std::size_t grain, std::size_t points_per_piece) {
+            return (grain + points_per_piece - 1) / points_per_piece;
+        }
+
+        // fn(column, n1) on every column of the N2 x N1 matrix, each copied out of its panel
+        // into contiguous memory and back
+        template<typename ForEach, typename Fn>
+        constexpr void four_step_columns(std::span<Complex> data, const ForEach& for_each, std::size_t grain, Fn&& fn) const {
+            const std::size_t N1 = sub_plans[1].N, N2 = sub_plans[0].N;
+            const std::size_t panel_width = std::min(N1, std::max<std::size_t>(1, 64 / sizeof(Complex)));
+            const std::size_t panels = (N1 + panel_width - 1) / panel_width;
+
+            for_each(panels, four_step_chunk(grain, panel_width * N2), [&](std::size_t p0, std::size_t p1) {
+                std::vector<Complex> panel(panel_width * N2);
+                for (std::size_t c0 = p0 * panel_width; c0 < std::min(N1, p1 * panel_width); c0 += panel_width) {
+                    for (std::size_t n2 = 0; n2 < N2; ++n2) {
+                        for (std::size_t b = 0; b < panel_width; ++b) panel[b * N2 + n2] = data[n2 * N1 + c0 + b];
+                    }
+                    for (std::size_t b = 0; b < panel_width; ++b) {
+                        fn(std::span<Complex>(panel.data() + b * N2, N2), c0 + b);
+                    }
+                    for (std::size_t n2 = 0; n2 < N2; ++n2) {
+                        for (std::size_t b = 0; b < panel_width; ++b) data[n2 * N1 + c0 + b] = panel[b * N2 + n2];
+                    }
+                }
+            });
+        }
+
+        // fn(row, k2) on every row of the N2 x N1 matrix
+        template<typename ForEach, typename Fn>
+        constexpr void four_step_rows(std::span<Complex> data, const ForEach& for_each, std::size_t grain, Fn&& fn) const {
+            const std::size_t N1 = sub_plans[1].N, N2 = sub_plans[0].N;
+            for_each(N2, four_step_chunk(grain, N1), [&](std::size_t k2_begin, std::size_t k2_end) {
+                for (std::size_t k2 = k2_begin; k2 < k2_end; ++k2) fn(data.subspan(k2 * N1, N1), k2);
+            });
+        }
+
+        // Column n1 times W_N^(n1*k2), bin by bin (W^0 = 1 is left alone)
+        template<bool Inverse>
+        constexpr void four_step_twiddle(std::span<Complex> column, std::size_t n1) const {
+            if (n1 == 0) return;
+            const Complex* w = kernel_twiddles.data() + n1 * column.size();
+            for (std::size_t k2 = 1; k2 < column.size(); ++k2) column[k2] = detail::twiddle_mul<Inverse>(column[k2], w[k2]);
+        }
+
+        // Step 3 of four_step: the N2 x N1 matrix of bins to natural order
+        template<typename ForEach>
+        constexpr void four_step_transpose(std::span<Complex> data, const ForEach& for_each, std::size_t grain) const {
+            const std::size_t N1 = sub_plans[1].N, N2 = sub_plans[0].N;
+            // Transposes go by tile rows; the square one's rows shorten towards the bottom,
+            // which the chunked schedule evens out
+            constexpr std::size_t tile = detail::transpose_tile;
+            if (N1 == N2) {
+                for_each((N1 + tile - 1) / tile, four_step_chunk(grain, tile * N1), [&](std::size_t t0, std::size_t t1) {
+                    detail::transpose_square_rows(data.data(), N1, t0 * tile, std::min(N1, t1 * tile));
+                });
+            } else {
+                std::vector<Complex> scratch(N);
+                for_each((N2 + tile - 1) / tile, four_step_chunk(grain, tile * N1), [&](std::size_t t0, std::size_t t1) {
+                    detail::transpose_rows(data.data(), scratch.data(), N2, N1, t0 * tile, std::min(N2, t1 * tile));
+                });
+                for_each(N, grain, [&](std::size_t i0, std::size_t i1) {
+                    std::copy(scratch.begin() + i0, scratch.begin() + i1, data.begin() + i0);
+                });
+            }
+        }
+
+        // Recursive out-of-place DIT for n = p * m points, p = 4 while 4 divides n, then 2, 3, 5.
+        // Input points are stride apart (stride = N/n); the p decimated m-point transforms are
+        // written to consecutive blocks of out, then one pass of radix-p butterflies combines
+        // them in place, reading every stride-th twiddle of the W_N circle.
+        template<bool Inverse>
+        constexpr void mixed_radix(Complex* out, const Complex* in, std::size_t stride, std::size_t n) const {
+            if (n == 1) {
+                out[0] = in[0];
+                return;
+            }
+            const std::size_t p = (n % 4 == 0) ? 4 : (n % 2 == 0) ? 2 : (n % 3 == 0) ? 3 : 5;
+            const std::size_t m = n / p;
+            for (std::size_t q = 0; q < p; ++q) {
+                mixed_radix<Inverse>(out + q * m, in + q * stride, stride * p, m);
+            }
+            const bool last = n == N;
+            switch (p) {
+            case 2:
+                detail::with_pass_scale<SampleType, Inverse>(N, last, [&](auto scale) { radix2_butterflies<Inverse>(out, stride, m, scale); });
+                break;
+            case 3:
+                detail::with_pass_scale<SampleType, Inverse>(N, last, [&](auto scale) { radix3_butterflies<Inverse>(out, stride, m, scale); });
+                break;
+            case 4:
+                detail::with_pass_scale<SampleType, Inverse>(N, last, [&](auto scale) { radix4_butterflies<Inverse>(out, stride, m, scale); });
+                break;
+            default:
+                detail::with_pass_scale<SampleType, Inverse>(N, last, [&](auto scale) { radix5_butterflies<Inverse>(out, stride, m, scale); });
+                break;
+            }
+        }
+
+        // z * W_N^k (conjugated for inverses); the multiply is skipped for k = 0, since a quantized
+        // W^0 is not exactly 1
+        template<bool Inverse>
+        constexpr Complex rotate(const Complex& z, std::size_t k) const {
+            return k == 0 ? z : detail::twiddle_mul<Inverse>(z, twiddles[k]);
+        }
+
+        template<bool Inverse, typename Scale>
+        constexpr void radix2_butterflies(Complex* x, std::size_t stride, std::size_t m, const Scale& scale) const {
+            for (std::size_t k = 0; k < m; ++k) {
+                auto u = x[k];
+                auto v = rotate<Inverse>(x[k + m], k * stride);
+                x[k] = scale(u + v);
+                x[k + m] = scale(u - v);
+            }
+        }
+
+        // W_3 = -1/2 - j*sqrt(3)/2: X1,2 = c0 - (c1 + c2)/2 -+ j*sqrt(3)/2 * (c1 - c2)
+        // (the inverse is the same with W_3 conjugated)
+        template<bool Inverse, typename Scale>
+        constexpr void radix3_butterflies(Complex* x, std::size_t stride, std::size_t m, const Scale& scale) const {
+            const Complex w3 = detail::conj_if<Inverse>(twiddles[stride * m]);
+            for (std::size_t k = 0; k < m; ++k) {
+                auto c0 = x[k];
+                auto c1 = rotate<Inverse>(x[k + m], k * stride);
+                auto c2 = rotate<Inverse>(x[k + 2 * m], 2 * k * stride);
+                auto s = c1 + c2;
+                auto t = c0 + s * w3.real();
+                auto u = detail::times_neg_j((c1 - c2) * w3.imag());
+                x[k] = scale(c0 + s);
+                x[k + m] = scale(t - u);
+                x[k + 2 * m] = scale(t + u);
+            }
+        }
+
+        template<bool Inverse, typename Scale>
+        constexpr void radix4_butterflies(Complex* x, std::size_t stride, std::size_t m, const Scale& scale) const {
+            for (std::size_t k = 0; k < m; ++k) {
+                auto c0 = x[k];
+                auto c1 = rotate<Inverse>(x[k + m], k * stride);
+                auto c2 = rotate<Inverse>(x[k + 2 * m], 2 * k * stride);
+                auto c3 = rotate<Inverse>(x[k + 3 * m], 3 * k * stride);
+                auto s0 = c0 + c2, d0 = c0 - c2;
+                auto s1 = c1 + c3;
+                auto d1 = detail::quarter_turn<Inverse>(c1 - c3);
+                x[k] = scale(s0 + s1);
+                x[k + m] = scale(d0 + d1);
+                x[k + 2 * m] = scale(s0 - s1);
+                x[k + 3 * m] = scale(d0 - d1);
+            }
+        }
+
+        // Pairs c1/c4 and c2/c3 share W_5^1 and W_5^2 up to conjugation, so each output needs
+        // only the real and imaginary parts of those two twiddles
+        template<bool Inverse, typename Scale>
+        constexpr void radix5_butterflies(Complex* x, std::size_t stride, std::size_t m, const Scale& scale) const {
+            const Complex w1 = detail::conj_if<Inverse>(twiddles[stride * m]);
+            const Complex w2 = detail::conj_if<Inverse>(twiddles[2 * stride * m]);
+            for (std::size_t k = 0; k < m; ++k) {
+                auto c0 = x[k];
+                auto c1 = rotate<Inverse>(x[k + m], k * stride);
+                auto c2 = rotate<Inverse>(x[k + 2 * m], 2 * k * stride);
+                auto c3 = rotate<Inverse>(x[k + 3 * m], 3 * k * stride);
+                auto c4 = rotate<Inverse>(x[k + 4 * m], 4 * k * stride);
+                auto s14 = c1 + c4, d14 = c1 - c4;
+                auto s23 = c2 + c3, d23 = c2 - c3;
+                auto a1 = c0 + s14 * w1.real() + s23 * w2.real();
+                auto b1 = detail::times_neg_j(d14 * w1.imag() + d23 * w2.imag());
+                auto a2 = c0 + s14 * w2.real() + s23 * w1.real();
+                auto b2 = detail::times_neg_j(d23 * w1.imag() - d14 * w2.imag());
+                x[k] = scale(c0 + s14 + s23);
+                x[k + m] = scale(a1 - b1);
+                x[k + 2 * m] = scale(a2 + b2);
+                x[k + 3 * m] = scale(a2 - b2);
+                x[k + 4 * m] = scale(a1 + b1);
+            }
+        }
+
+        // X = w * IDFT_M(DFT_M(x w) * DFT_M(conj w)). The convolution runs DIF forward and DIT
+        // inverse passes around a bit-reversed filter, so it never permutes; the part of its 1/M
+        // not in the stored filter is a rounding shift of each spectrum product. The inverse DFT swaps w and conj(w), whose filter spectrum is
+        // conj(F[-k]) = conj(F[k]) (the filter is even), and applies its 1/N in the last chirp
+        // multiply (scaling the input instead would leave a fixed-point convolution almost
+        // nothing to work with). Four-step convolutions have no bit-reversed passes and take the
+        // inverse as a forward transform between conjugations.
+        template<bool Inverse>
+        constexpr void bluestein(std::span<Complex> data) const {
+            const auto& convolution = sub_plans[0];
+            const std::size_t M = convolution.N;
+            using std::conj;
+            std::vector<Complex> local;
+            std::span<Complex> a = scratch<FFTKernel::Bluestein>(M, local);
+            for (std::size_t n = 0; n < N; ++n) a[n] = detail::twiddle_mul<Inverse>(data[n], twiddles[n]);
+            std::fill(a.begin() + N, a.end(), Complex(SampleType{ 0 }, SampleType{ 0 }));
+            std::span<Complex> spectrum(a);
+            // Spectrum bin times filter bin, then the rest of the 1/M with one rounding
+            Normalizer<SampleType> unshift(std::size_t(1) << filter_shift);
+            auto filtered = [&](std::size_t k) {
+                return unshift(a[k] * detail::conj_if<Inverse>(kernel_twiddles[k]));
+            };
+            if (convolution.bit_reversed_passes()) {
+                convolution.dif_passes(spectrum);
+                for (std::size_t k = 0; k < M; ++k) a[k] = filtered(k);
+                convolution.template dit_passes<true, false>(spectrum);
+            } else {
+                convolution.forward(spectrum);
+                for (std::size_t k = 0; k < M; ++k) a[k] = conj(filtered(k));
+                convolution.forward(spectrum);
+                for (std::size_t k = 0; k < N; ++k) a[k] = conj(a[k]);
+            }
+            if constexpr (Inverse) {
+                Normalizer<SampleType> scale(N);
+                for (std::size_t k = 0; k < N; ++k) data[k] = scale(detail::twiddle_mul<true>(a[k], twiddles[k]));
+            } else {
+                for (std::size_t k = 0; k < N; ++k) data[k] = a[k] * twiddles[k];
+            }
+        }
+
+        // size elements of the calling thread's scratch for Kernel (detail::thread_scratch), or of
+        // local during constant evaluation, which has no thread_local storage
+        template<FFTKernel Kernel>
+        constexpr std::span<Complex> scratch(std::size_t size, std::vector<Complex>& local) const {
+            if consteval {
+                local.resize(size);
+                return local;
+            } else {
+                return detail::thread_scratch<Complex, Kernel>(size);
+            }
+        }
 
-            // Scale by 1/N
-			SampleType invN = SampleType(1.0) / SampleType(double(N));
-			for (auto& x : data) x *= invN; 
+        // Sizes 8..n/2 store 2*(m/4 - 1) twiddles each before size n: n/2 - 2*log2(n) + 2 in total
+        static constexpr std::size_t split_offset(std::size_t n) {
+            return n / 2 + 2 - 2 * static_cast<std::size_t>(std::countr_zero(n));
         }
     };
 
@@ -0,0 +1,179 @@
+#pragma once
+
+// Silence MSVC’s non-floating std::complex warning
+#ifndef _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#define _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#endif
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "concepts.hpp"
+#include "fft.hpp"
+#include "fft_cache.hpp"
+
+namespace dsp {
+
+    // FFT2DPlan: the column transforms run on strips of adjacent columns copied out to scratch;
+    // a strip is sized to stay in L2 (this many bytes) while its columns are transformed
+    inline constexpr std::size_t fft_2d_strip_bytes = std::size_t(1) << 18;
+
+    // Row-major rows x cols array (an image tile, a range-Doppler map, a 2D kernel)
+    template<typename T>
+    struct Array2D {
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+        std::vector<T> data;    ///< element (r, c) at data[r * cols + c]
+
+        Array2D() = default;
+
+        Array2D(std::size_t rows, std::size_t cols, const T& value = T{})
+            : rows(rows), cols(cols), data(rows * cols, value) {}
+
+        T& operator()(std::size_t r, std::size_t c) { return data[r * cols + c]; }
+        const T& operator()(std::size_t r, std::size_t c) const { return data[r * cols + c]; }
+
+        std::span<T> row(std::size_t r) { return std::span<T>(data).subspan(r * cols, cols); }
+        std::span<const T> row(std::size_t r) const { return std::span<const T>(data).subspan(r * cols, cols); }
+    };
+
+    // 2D FFT of a row-major rows x cols array: a cols-point FFT along every row, then a rows-point
+    // FFT down every column. Both 1D plans come from the FFTPlanCache, so any sizes the 1D
+    // transform takes work here too. The row transforms go through forward_batch (one SIMD lane
+    // per row for FixedPoint data). The columns are never read with a stride of cols: a strip of
+    // adjacent columns is copied into contiguous scratch tile by tile, transformed there as a
+    // batch while it is still in cache, and copied back. That replaces the two full transposes of
+    // a row-transpose-row-transpose scheme with one read and one write of each strip.
+    template<Arithmetic SampleType, typename Complex = complex_sample<SampleType>>
+    struct FFT2DPlan {
+        using Plan = FFTPlan<SampleType, Complex>;
+
+        std::size_t rows;                       ///< transform size down a column
+        std::size_t cols;                       ///< transform size along a row
+        std::shared_ptr<const Plan> row_plan;   ///< cols-point plan
+        std::shared_ptr<const Plan> col_plan;   ///< rows-point plan
+
+        // The kernel applies to both axes (Auto picks one per size)
+        FFT2DPlan(std::size_t rows, std::size_t cols, FFTKernel kernel = FFTKernel::Auto)
+            : rows(rows), cols(cols) {
+            if (rows == 0 || cols == 0) {
+                throw std::invalid_argument("2D FFT dimensions must be positive");
+            }
+            row_plan = cached_fft_plan<SampleType, Complex>(cols, kernel);
+            col_plan = cached_fft_plan<SampleType, Complex>(rows, kernel);
+        }
+
+        // In-place forward 2D FFT (no scaling). Rows and strips are split over `threads` workers;
+        // 0 picks std::thread::hardware_concurrency() for arrays of at least
+        // fft_batch_thread_min_points points and one thread below that.
+        void forward(std::span<Complex> data, std::size_t threads = 0) const {
+            transform<false>(data, threads);
+        }
+
+        void forward(Array2D<Complex>& data, std::size_t threads = 0) const {
+            check_shape(data);
+            forward(std::span<Complex>(data.data), threads);
+        }
+
+        // In-place inverse 2D FFT (with 1/(rows*cols) scaling, 1/cols in the row transforms and
+        // 1/rows in the column ones)
+        void inverse(std::span<Complex> data, std::size_t threads = 0) const {
+            transform<true>(data, threads);
+        }
+
+        void inverse(Array2D<Complex>& data, std::size_t threads = 0) const {
+            check_shape(data);
+            inverse(std::span<Complex>(data.data), threads);
+        }
+
+    private:
+        void check_shape(const Array2D<Complex>& data) const {
+            if (data.rows != rows || data.cols != cols) {
+                throw std::invalid_argument("Array shape must match the 2D FFT plan");
+            }
+        }
+
+        // Columns per strip: as many as fit in fft_2d_strip_bytes, but at least one transpose
+        // tile so every row of the strip is read a cache line or more at a time
+        std::size_t strip_width() const {
+            std::size_t width = fft_2d_strip_bytes / (rows * sizeof(Complex));
+            return std::min(cols, std::max(width, detail::transpose_tile));
+        }
+
+        template<bool Inverse>
+        void transform(std::span<Complex> data, std::size_t threads) const {
+            if (data.size() != rows * cols) {
+                throw std::invalid_argument("Data size must match 2D FFT plan size");
+            }
+            if (threads == 0) {
+                threads = rows * cols >= fft_batch_thread_min_points ? std::max(1u, std::thread::hardware_concurrency()) : 1;
+            }
+            detail::ParallelFor pfor{ threads };
+            Complex* base = data.data();
+
+            std::size_t row_chunk = std::max<std::size_t>(1, fft_parallel_grain_points / cols);
+            pfor(rows, row_chunk, [&](std::size_t r0, std::size_t r1) {
+                run_rows<Inverse>(*row_plan, base + r0 * cols, r1 - r0);
+            });
+
+            const std::size_t width = strip_width();
+            const std::size_t strips = (cols + width - 1) / width;
+            pfor(strips, 1, [&](std::size_t s0, std::size_t s1) {
+                std::vector<Complex> strip(width * rows);
+                for (std::size_t s = s0; s < s1; ++s) {
+                    std::size_t c0 = s * width;
+                    std::size_t w = std::min(width, cols - c0);
+                    gather_strip(base, strip.data(), c0, w);
+                    run_rows<Inverse>(*col_plan, strip.data(), w);
+                    scatter_strip(strip.data(), base, c0, w);
+                }
+            });
+        }
+
+        // count back-to-back transforms of plan.N points each
+        template<bool Inverse>
+        static void run_rows(const Plan& plan, Complex* first, std::size_t count) {
+            const std::size_t n = plan.N;
+            if constexpr (Inverse) {
+                for (std::size_t t = 0; t < count; ++t) plan.inverse(std::span<Complex>(first + t * n, n));
+            } else {
+                plan.forward_batch(std::span<Complex>(first, count * n), count, 1, n, 1);
+            }
+        }
+
+        // Columns [c0, c0 + w) of data -> strip (w x rows), in transpose tiles
+        void gather_strip(const Complex* data, Complex* strip, std::size_t c0, std::size_t w) const {
+            constexpr std::size_t tile = detail::transpose_tile;
+            for (std::size_t r0 = 0; r0 < rows; r0 += tile) {
+                std::size_t r1 = std::min(r0 + tile, rows);
+                for (std::size_t b0 = 0; b0 < w; b0 += tile) {
+                    std::size_t b1 = std::min(b0 + tile, w);
+                    for (std::size_t r = r0; r < r1; ++r) {
+                        const Complex* src = data + r * cols + c0;
+                        for (std::size_t b = b0; b < b1; ++b) strip[b * rows + r] = src[b];
+                    }
+                }
+            }
+        }
+
+        void scatter_strip(const Complex* strip, Complex* data, std::size_t c0, std::size_t w) const {
+            constexpr std::size_t tile = detail::transpose_tile;
+            for (std::size_t r0 = 0; r0 < rows; r0 += tile) {
+                std::size_t r1 = std::min(r0 + tile, rows);
+                for (std::size_t b0 = 0; b0 < w; b0 += tile) {
+                    std::size_t b1 = std::min(b0 + tile, w);
+                    for (std::size_t r = r0; r < r1; ++r) {
+                        Complex* dst = data + r * cols + c0;
+                        for (std::size_t b = b0; b < b1; ++b) dst[b] = strip[b * rows + r];
+                    }
+                }
+            }
+        }
+    };
+
+} // namespace dsp
@@ -0,0 +1,323 @@
+#pragma once
+
+// Silence MSVC’s non-floating std::complex warning
+#ifndef _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#define _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#endif
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include "fft.hpp"
+
+namespace dsp {
+
+    namespace detail {
+
+        // FNV-1a, to tag wisdom files with the plan's complex type
+        inline std::uint64_t wisdom_type_hash(const char* name) {
+            std::uint64_t h = 14695981039346656037ull;
+            for (; *name; ++name) {
+                h = (h ^ static_cast<unsigned char>(*name)) * 1099511628211ull;
+            }
+            return h;
+        }
+
+    } // namespace detail
+
+    // Thread-safe registry of FFT plans for one sample/complex type, keyed by (N, kernel).
+    // Every power-of-two plan shares one process-wide twiddle source: the full circle W_M^k
+    // (k < M) for the largest size requested so far, which contains the twiddles of every
+    // smaller power of two, so a new plan copies table entries instead of evaluating sin/cos
+    // (the tables come out identical). The circle only ever grows, and reuses its old entries
+    // when it does. Plans for other sizes build their own tables.
+    //
+    // Plans (not the circle) can be saved to a wisdom file and loaded back, so restarted or
+    // forked processes skip planning. The file is a flat, 8-byte aligned image of the tables
+    // (header, then per plan its sizes and raw arrays), tied to the writer's byte order,
+    // compiler and sample type; load() rejects files written for another type. It is not
+    // memory-mapped: FFTPlan owns its tables, so load() reads the file through a stream into
+    // each plan's own vectors. That is a copy of every table (still far cheaper than
+    // planning), and processes loading the same file do not share its pages.
+    //
+    // FFTPlan has no separate inverse tables (inverse() reuses the forward ones), so plans are
+    // not keyed by direction.
+    template<Arithmetic SampleType, typename Complex = complex_sample<SampleType>>
+    class FFTPlanCache {
+    public:
+        using Plan = FFTPlan<SampleType, Complex>;
+
+        // The cache shared by the whole process
+        static FFTPlanCache& global() {
+            static FFTPlanCache cache;
+            return cache;
+        }
+
+        // Plan for N points, built on first use. Auto is resolved first, so it shares the plan
+        // of the kernel it picks. Plans are built without holding the lock, so a large one does
+        // not hold up lookups and other sizes; threads that ask for the same new plan at once
+        // may each build it, and all of them get the one inserted first.
+        std::shared_ptr<const Plan> plan(std::size_t N, FFTKernel kernel = FFTKernel::Auto) {
+            kernel = Plan::choose_kernel(N, kernel);
+            {
+                std::lock_guard lock(mutex_);
+                auto it = plans_.find({ N, kernel });
+                if (it != plans_.end()) return it->second;
+            }
+            auto built = std::has_single_bit(N)
+                ? std::make_shared<const Plan>(N, kernel, std::span<const Complex>(*twiddle_circle(N)))
+                : std::make_shared<const Plan>(N, kernel);
+            std::lock_guard lock(mutex_);
+            return plans_.try_emplace(std::pair{ N, kernel }, std::move(built)).first->second;
+        }
+
+        // W_M^k for k=0..M-1, for some power of two M >= N. A circle that is too small is grown
+        // outside the lock, like a plan, and replaces the shared one unless that grew meanwhile.
+        std::shared_ptr<const std::vector<Complex>> twiddle_circle(std::size_t N) {
+            if (N == 0 || (N & (N - 1)) != 0) {
+                throw std::invalid_argument("FFT size must be a power of two");
+            }
+            std::shared_ptr<const std::vector<Complex>> old;
+            {
+                std::lock_guard lock(mutex_);
+                if (circle_ && circle_->size() >= N) return circle_;
+                old = circle_;
+            }
+            auto grown = grow_circle(old, N);
+            std::lock_guard lock(mutex_);
+            if (!circle_ || circle_->size() < N) circle_ = std::move(grown);
+            return circle_;
+        }
+
+        std::size_t size() const {
+            std::lock_guard lock(mutex_);
+            return plans_.size();
+        }
+
+        // Drops the cache's references; plans handed out stay valid
+        void clear() {
+            std::lock_guard lock(mutex_);
+            plans_.clear();
+            circle_.reset();
+        }
+
+        // Write every cached plan as wisdom
+        void save(std::ostream& out) const {
+            std::lock_guard lock(mutex_);
+            Header header{};
+            std::memcpy(header.magic, magic, sizeof(header.magic));
+            header.version = version;
+            header.complex_bytes = sizeof(Complex);
+            header.type_hash = type_hash();
+            header.plan_count = plans_.size();
+            write_raw(out, &header, sizeof(header));
+            for (const auto& [key, plan] : plans_) write_plan(out, *plan);
+            if (!out) throw std::runtime_error("Failed to write FFT wisdom");
+        }
+
+        void save(const std::string& path) const {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out) throw std::runtime_error("Cannot open FFT wisdom file " + path);
+            save(out);
+        }
+
+        // Add the plans from a wisdom stream (plans already in the cache are kept)
+        void load(std::istream& in) {
+            Header header{};
+            read_raw(in, &header, sizeof(header));
+            if (std::memcmp(header.magic, magic, sizeof(header.magic)) != 0 || header.version != version) {
+                throw std::runtime_error("Not an FFT wisdom file");
+            }
+            if (header.complex_bytes != sizeof(Complex) || header.type_hash != type_hash()) {
+                throw std::runtime_error("FFT wisdom was written for a different sample type");
+            }
+            // Read everything first, so a damaged file leaves the cache untouched
+            std::vector<std::shared_ptr<const Plan>> loaded;
+            for (std::uint64_t i = 0; i < header.plan_count; ++i) {
+                loaded.push_back(std::make_shared<const Plan>(read_plan(in, 0)));
+            }
+
+            std::lock_guard lock(mutex_);
+            for (auto& plan : loaded) plans_.emplace(std::pair{ plan->N, plan->kernel }, std::move(plan));
+        }
+
+        void load(const std::string& path) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in) throw std::runtime_error("Cannot open FFT wisdom file " + path);
+            load(in);
+        }
+
+    private:
+        static_assert(std::is_trivially_copyable_v<Complex>, "Wisdom files store raw twiddle bytes");
+
+        static constexpr char magic[8] = { 'F', 'X', 'P', 'W', 'I', 'S', 'D', 'M' };
+        static constexpr std::uint32_t version = 3;
+        // Deepest FourStep nesting a valid file can have (each level halves log2 N)
+        static constexpr int max_depth = 8;
+
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t complex_bytes;
+            std::uint64_t type_hash;
+            std::uint64_t plan_count;
+        };
+
+        // Followed by bitrev (uint64 each), twiddles, kernel_twiddles, each padded to 8 bytes,
+        // then the sub-plans
+        struct PlanRecord {
+            std::uint64_t N;
+            std::uint64_t kernel;
+            std::uint64_t bitrev_count;
+            std::uint64_t twiddle_count;
+            std::uint64_t kernel_twiddle_count;
+            std::uint64_t sub_plan_count;
+            std::uint64_t filter_shift;
+        };
+
+        mutable std::mutex mutex_;
+        std::map<std::pair<std::size_t, FFTKernel>, std::shared_ptr<const Plan>> plans_;
+        std::shared_ptr<const std::vector<Complex>> circle_;
+
+        static std::uint64_t type_hash() {
+            return detail::wisdom_type_hash(typeid(Complex).name());
+        }
+
+        // The N-point circle, taking every entry it shares with old (entry k of old is entry
+        // k * (N / old size) of the new one) and evaluating the rest
+        static std::shared_ptr<const std::vector<Complex>> grow_circle(const std::shared_ptr<const std::vector<Complex>>& old,
+                                                                       std::size_t N) {
+            auto grown = std::make_shared<std::vector<Complex>>(N);
+            std::size_t ratio = old ? N / old->size() : 0;
+            for (std::size_t k = 0; k < N; ++k) {
+                (*grown)[k] = (ratio && k % ratio == 0) ? (*old)[k / ratio]
+                                                        : make_twiddle<SampleType, Complex>(N, k, /*inverse=*/false);
+            }
+            return grown;
+        }
+
+        static void write_raw(std::ostream& out, const void* data, std::size_t bytes) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            static constexpr char zeros[8] = {};
+            out.write(zeros, static_cast<std::streamsize>((8 - bytes % 8) % 8));
+        }
+
+        static void read_raw(std::istream& in, void* data, std::size_t bytes) {
+            char pad[8];
+            if (!in.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes))
+                || !in.read(pad, static_cast<std::streamsize>((8 - bytes % 8) % 8))) {
+                throw std::runtime_error("Truncated FFT wisdom file");
+            }
+        }
+
+        static void write_plan(std::ostream& out, const Plan& plan) {
+            PlanRecord record{ plan.N, static_cast<std::uint64_t>(plan.kernel), plan.bitrev.size(),
+                               plan.twiddles.size(), plan.kernel_twiddles.size(), plan.sub_plans.size(),
+                               static_cast<std::uint64_t>(plan.filter_shift) };
+            write_raw(out, &record, sizeof(record));
+            std::vector<std::uint64_t> bitrev(plan.bitrev.begin(), plan.bitrev.end());
+            write_raw(out, bitrev.data(), bitrev.size() * sizeof(std::uint64_t));
+            write_raw(out, plan.twiddles.data(), plan.twiddles.size() * sizeof(Complex));
+            write_raw(out, plan.kernel_twiddles.data(), plan.kernel_twiddles.size() * sizeof(Complex));
+            for (const auto& sub : plan.sub_plans) write_plan(out, sub);
+        }
+
+        static Plan read_plan(std::istream& in, int depth) {
+            PlanRecord record{};
+            read_raw(in, &record, sizeof(record));
+            // Table sizes must be exactly what the kernel indexes; checked before allocating
+            const std::uint64_t N = record.N;
+            bool valid = depth < max_depth && N != 0 && N <= std::numeric_limits<std::size_t>::max() / 4
+                && record.kernel > static_cast<std::uint64_t>(FFTKernel::Auto)
+                && record.kernel <= static_cast<std::uint64_t>(FFTKernel::Bluestein);
+            if (valid) {
+                auto kernel = static_cast<FFTKernel>(record.kernel);
+                bool four_step = kernel == FFTKernel::FourStep;
+                bool mixed_radix = kernel == FFTKernel::MixedRadix;
+                bool bluestein = kernel == FFTKernel::Bluestein;
+                bool bit_reversed = !four_step && !mixed_radix && !bluestein;
+                valid = (mixed_radix ? Plan::mixed_radix_size(static_cast<std::size_t>(N)) : bluestein || (N & (N - 1)) == 0)
+                    && record.bitrev_count == (bit_reversed ? N : 0)
+                    && record.twiddle_count == (four_step ? 0 : bit_reversed ? N / 2 : N)
+                    && record.kernel_twiddle_count == kernel_twiddle_count(static_cast<std::size_t>(N), kernel)
+                    && record.sub_plan_count == (four_step ? 2u : bluestein ? 1u : 0u)
+                    && record.filter_shift <= (bluestein
+                           ? static_cast<std::uint64_t>(std::countr_zero(Plan::bluestein_size(static_cast<std::size_t>(N))))
+                           : 0u);
+            }
+            if (!valid) throw std::runtime_error("Corrupt FFT wisdom file");
+
+            Plan plan;
+            plan.N = static_cast<std::size_t>(N);
+            plan.kernel = static_cast<FFTKernel>(record.kernel);
+            plan.filter_shift = static_cast<int>(record.filter_shift);
+            std::vector<std::uint64_t> bitrev(record.bitrev_count);
+            read_raw(in, bitrev.data(), bitrev.size() * sizeof(std::uint64_t));
+            plan.bitrev.assign(bitrev.begin(), bitrev.end());
+            for (auto r : plan.bitrev) {
+                if (r >= N) throw std::runtime_error("Corrupt FFT wisdom file");
+            }
+            plan.twiddles.resize(record.twiddle_count);
+            read_raw(in, plan.twiddles.data(), plan.twiddles.size() * sizeof(Complex));
+            plan.kernel_twiddles.resize(record.kernel_twiddle_count);
+            read_raw(in, plan.kernel_twiddles.data(), plan.kernel_twiddles.size() * sizeof(Complex));
+            for (std::uint64_t i = 0; i < record.sub_plan_count; ++i) {
+                plan.sub_plans.push_back(read_plan(in, depth + 1));
+            }
+            if (plan.kernel == FFTKernel::FourStep) {
+                std::size_t N1 = std::size_t(1) << (std::countr_zero(plan.N) / 2);
+                if (plan.sub_plans[0].N != plan.N / N1 || plan.sub_plans[1].N != N1) {
+                    throw std::runtime_error("Corrupt FFT wisdom file");
+                }
+            }
+            if (plan.kernel == FFTKernel::Bluestein && plan.sub_plans[0].N != Plan::bluestein_size(plan.N)) {
+                throw std::runtime_error("Corrupt FFT wisdom file");
+            }
+            return plan;
+        }
+
+        // Size of FFTPlan::kernel_twiddles for each kernel (see the FFTPlan constructor)
+        static std::size_t kernel_twiddle_count(std::size_t N, FFTKernel kernel) {
+            std::size_t count = 0;
+            switch (kernel) {
+            case FFTKernel::Radix4:
+                for (std::size_t q = (std::countr_zero(N) % 2 == 0) ? 1 : 2; 4 * q <= N; q *= 4) count += 3 * (q - 1);
+                break;
+            case FFTKernel::SplitRadix:
+                for (std::size_t n = 8; n <= N; n *= 2) count += 2 * (n / 4 - 1);
+                break;
+            case FFTKernel::FourStep:
+                count = N;
+                break;
+            case FFTKernel::Bluestein:
+                count = Plan::bluestein_size(N);
+                break;
+            default:
+                break;
+            }
+            return count;
+        }
+    };
+
+    // Plan from the process-wide cache for this sample type
+    template<Arithmetic SampleType, typename Complex = complex_sample<SampleType>>
+    std::shared_ptr<const FFTPlan<SampleType, Complex>> cached_fft_plan(std::size_t N, FFTKernel kernel = FFTKernel::Auto) {
+        return FFTPlanCache<SampleType, Complex>::global().plan(N, kernel);
+    }
+
+} // namespace dsp
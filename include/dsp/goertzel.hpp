@@ -0,0 +1,318 @@
+#pragma once
+
+// Silence MSVC’s non-floating std::complex warning
+#ifndef _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#define _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "concepts.hpp"
+#include "twiddle.hpp"
+#include "fixed_point/fixed_point.hpp"
+#include "fixed_point/int128.hpp"
+#include "fixed_point/rounding.hpp"
+
+namespace dsp {
+
+    // Extra fractional bits the fixed-point sliding DFT keeps on its bins
+    inline constexpr int sliding_dft_guard_bits = 4;
+
+    // Sliding DFT damping r: every bin decays by r per sample, so rounding errors die out
+    // instead of piling up, and the quantized r*e^(jw) stays strictly inside the unit circle.
+    // The window is weighted by r^m, which costs 0.05% of amplitude at N = 1024.
+    inline constexpr double sliding_dft_damping = 1.0 - 1.0 / double(1 << 20);
+
+    namespace detail {
+
+        // Detector state and coefficients: SampleType itself, or for FixedPoint (up to 32 bits)
+        // raw integers. The sliding DFT's bins hold at most N samples' worth, so 16-bit samples
+        // run in 64 bits with coeff_bits = 24 and wider ones in 128 bits with 48. The Goertzel
+        // resonator grows to N^2 / 2 samples' worth (a DC input on bin 0), far past 64 bits
+        // for 16-bit samples at N = 4096, so it asks for the 128-bit state (Wide) throughout.
+        template<typename SampleType, bool Wide = false, bool = is_fixed_point_v<SampleType>>
+        struct detector_value {
+            using type = SampleType;
+            static constexpr bool supported = true;
+            static constexpr int coeff_bits = 0;
+        };
+
+        template<typename SampleType, bool Wide>
+        struct detector_value<SampleType, Wide, true> {
+            static constexpr bool narrow = !Wide && SampleType::total_bits <= 16;
+            using type = std::conditional_t<narrow, int64_t, fixed_point::wide_int128>;
+            static constexpr bool supported = SampleType::total_bits <= 32;
+            static constexpr int coeff_bits = narrow ? 24 : 48;
+        };
+
+        // Throws unless a state of `growth` full-scale samples, multiplied by a coefficient of
+        // magnitude up to 2, fits the detector's raw integers
+        template<typename SampleType, bool Wide>
+        void check_detector_growth(double growth, const char* message) {
+            if constexpr (is_fixed_point_v<SampleType>) {
+                using Traits = detector_value<SampleType, Wide>;
+                constexpr int value_bits = Traits::narrow ? 64 : 128;
+                double bits = std::log2(growth) + (SampleType::total_bits - 1) + (Traits::coeff_bits + 1);
+                if (bits >= value_bits - 1) {
+                    throw std::invalid_argument(message);
+                }
+            }
+        }
+
+        // x with `bits` fractional bits
+        template<typename Wide>
+        Wide detector_coeff(double x, int bits) {
+            return Wide(std::llround(std::ldexp(x, bits)));
+        }
+
+        // v / d rounded to nearest, d > 0
+        template<typename Wide>
+        constexpr Wide divide_rounded(Wide v, Wide d) {
+            Wide half = d / Wide(2);
+            return (v >= Wide(0) ? v + half : v - half) / d;
+        }
+
+        // A raw value in SampleType's units, saturated (only the most negative value can be out)
+        template<typename SampleType, typename Wide>
+        constexpr SampleType detector_narrow(Wide v) {
+            using Storage = typename SampleType::StorageType;
+            v = std::clamp(v, Wide(std::numeric_limits<Storage>::min()), Wide(std::numeric_limits<Storage>::max()));
+            return SampleType::from_raw(static_cast<Storage>(v));
+        }
+
+    } // namespace detail
+
+    // Goertzel bank: a few DFT bins of N-sample frames in O(N) each. Every bin runs the
+    // resonator s[n] = x[n] + 2cos(w) s[n-1] - s[n-2], one real multiply per sample, and then
+    // X(w) = e^(-jw(N-1)) s[N-1] - e^(-jwN) s[N-2]. Bins are in units of fs/N and need not be
+    // integers (DTMF tones fall between bins). Results are X/N, so an integer bin equals
+    // dft()'s value there divided by N, up to rounding: a tone a*cos(wn) on a bin reads a/2,
+    // and nothing can overflow.
+    // FixedPoint samples (up to 32 bits) run the resonator on 128-bit raw integers (see
+    // detail::detector_value); 32-bit samples limit N to below 2^24.
+    template<Arithmetic SampleType, typename Complex = complex_sample<SampleType>>
+    class GoertzelBank {
+        static constexpr bool fixed = is_fixed_point_v<SampleType>;
+        static_assert(detail::detector_value<SampleType, true>::supported, "Goertzel state needs samples of at most 32 bits");
+
+    public:
+        GoertzelBank(std::size_t N, std::vector<double> bins) : N_(N), bins_(std::move(bins)) {
+            if (N == 0) {
+                throw std::invalid_argument("Goertzel frame size must be positive");
+            }
+            // |s[n]| <= (n + 1)(n + 2) / 2 samples, since |sin((n + 1)w) / sin(w)| <= n + 1
+            detail::check_detector_growth<SampleType, true>(double(N) * double(N + 1) / 2.0,
+                                                            "Goertzel frame too long for the fixed-point state");
+            for (double k : bins_) {
+                double w = 2.0 * std::numbers::pi * k / double(N);
+                coeffs_.push_back({ make_coeff(2.0 * std::cos(w)),
+                                    make_coeff(std::cos(w * double(N - 1))), make_coeff(-std::sin(w * double(N - 1))),
+                                    make_coeff(std::cos(w * double(N))), make_coeff(-std::sin(w * double(N))) });
+            }
+        }
+
+        std::size_t size() const { return N_; }
+        const std::vector<double>& bins() const { return bins_; }
+
+        // X[k]/N for every bin, from one frame of N samples
+        std::vector<Complex> analyze(std::span<const SampleType> frame) const {
+            if (frame.size() != N_) {
+                throw std::invalid_argument("Frame size must match the Goertzel frame size");
+            }
+            std::vector<Complex> result;
+            result.reserve(coeffs_.size());
+            for (const auto& c : coeffs_) result.push_back(bin(frame, c));
+            return result;
+        }
+
+        std::vector<Complex> analyze(const std::vector<SampleType>& frame) const {
+            return analyze(std::span<const SampleType>(frame));
+        }
+
+        // |X[k]/N|^2 for every bin: the usual detection statistic
+        std::vector<SampleType> power(std::span<const SampleType> frame) const {
+            std::vector<SampleType> result;
+            result.reserve(coeffs_.size());
+            for (const auto& X : analyze(frame)) result.push_back(X.real() * X.real() + X.imag() * X.imag());
+            return result;
+        }
+
+        std::vector<SampleType> power(const std::vector<SampleType>& frame) const {
+            return power(std::span<const SampleType>(frame));
+        }
+
+    private:
+        using Value = typename detail::detector_value<SampleType, true>::type;
+        static constexpr int coeff_bits = detail::detector_value<SampleType, true>::coeff_bits;
+
+        // 2cos(w) for the resonator, then e^(-jw(N-1)) and e^(-jwN) for the output
+        struct Coeffs {
+            Value feedback, a_re, a_im, b_re, b_im;
+        };
+
+        static Value make_coeff(double x) {
+            if constexpr (fixed) return detail::detector_coeff<Value>(x, coeff_bits);
+            else return SampleType(x);
+        }
+
+        Complex bin(std::span<const SampleType> frame, const Coeffs& c) const {
+            using fixed_point::Rounding;
+            Value s1{ 0 }, s2{ 0 };
+            if constexpr (fixed) {
+                for (const auto& x : frame) {
+                    Value s0 = Value(x.raw()) + fixed_point::shift_right_rounded<Rounding::Nearest>(c.feedback * s1, coeff_bits) - s2;
+                    s2 = s1;
+                    s1 = s0;
+                }
+                auto out = [&](Value a, Value b) {
+                    Value v = fixed_point::shift_right_rounded<Rounding::Nearest>(a * s1 - b * s2, coeff_bits);
+                    return detail::detector_narrow<SampleType>(detail::divide_rounded(v, Value(N_)));
+                };
+                return Complex(out(c.a_re, c.b_re), out(c.a_im, c.b_im));
+            } else {
+                for (const auto& x : frame) {
+                    Value s0 = x + c.feedback * s1 - s2;
+                    s2 = s1;
+                    s1 = s0;
+                }
+                SampleType scale = SampleType(1) / SampleType(N_);
+                return Complex((c.a_re * s1 - c.b_re * s2) * scale, (c.a_im * s1 - c.b_im * s2) * scale);
+            }
+        }
+
+        std::size_t N_;
+        std::vector<double> bins_;
+        std::vector<Coeffs> coeffs_;
+    };
+
+    // Sliding DFT: a few bins of the last N samples, updated in O(1) per bin per sample, so a
+    // detector can decide on every sample instead of every frame. Each bin runs
+    //   S[n] = r e^(jw) (S[n-1] + x[n] - r^N x[n-N]),  w = 2*pi*k/N,
+    // which for r = 1 is the DFT of the window x[n-N+1..n]. A bare recursion has a pole on the
+    // unit circle, so rounding errors (and a quantized e^(jw) slightly outside the circle)
+    // would build up without limit; the damping r < 1 (sliding_dft_damping) makes them decay.
+    // Bins are integers, taken mod N, and bin() returns S/N like GoertzelBank.
+    // FixedPoint samples (up to 32 bits) keep the bins on raw integers (see
+    // detail::detector_value) with sliding_dft_guard_bits extra fractional bits; 16-bit
+    // samples limit N to below 2^19.
+    template<Arithmetic SampleType, typename Complex = complex_sample<SampleType>>
+    class SlidingDFT {
+        static constexpr bool fixed = is_fixed_point_v<SampleType>;
+        static_assert(detail::detector_value<SampleType>::supported, "Sliding DFT state needs samples of at most 32 bits");
+
+    public:
+        SlidingDFT(std::size_t N, std::vector<std::size_t> bins, double damping = sliding_dft_damping)
+            : N_(N), bins_(std::move(bins)), history_(N, SampleType{ 0 }) {
+            if (N == 0) {
+                throw std::invalid_argument("Sliding DFT size must be positive");
+            }
+            if (!(damping > 0.0 && damping <= 1.0)) {
+                throw std::invalid_argument("Sliding DFT damping must be in (0, 1]");
+            }
+            // A bin plus the next input: N + 2 samples, with the guard bits
+            detail::check_detector_growth<SampleType, false>(double(N + 2) * double(1 << sliding_dft_guard_bits),
+                                                             "Sliding DFT too long for the fixed-point state");
+            for (auto& k : bins_) {
+                k %= N;
+                double w = 2.0 * std::numbers::pi * double(k) / double(N);
+                rotations_.push_back({ make_coeff(damping * std::cos(w)), make_coeff(damping * std::sin(w)) });
+            }
+            decay_ = make_coeff(std::pow(damping, double(N)));
+            reset();
+        }
+
+        std::size_t size() const { return N_; }
+        const std::vector<std::size_t>& bins() const { return bins_; }
+
+        // Push one sample and update every bin
+        void process(SampleType x) {
+            SampleType old = history_[next_];
+            history_[next_] = x;
+            next_ = (next_ + 1 == N_) ? 0 : next_ + 1;
+
+            using fixed_point::Rounding;
+            if constexpr (fixed) {
+                constexpr int G = sliding_dft_guard_bits;
+                Value in = (Value(x.raw()) << G)
+                           - fixed_point::shift_right_rounded<Rounding::Nearest>(decay_ * Value(old.raw()), coeff_bits - G);
+                for (std::size_t m = 0; m < state_.size(); ++m) {
+                    const auto& w = rotations_[m];
+                    Value a = state_[m].re + in, b = state_[m].im;
+                    state_[m].re = fixed_point::shift_right_rounded<Rounding::Nearest>(a * w.re - b * w.im, coeff_bits);
+                    state_[m].im = fixed_point::shift_right_rounded<Rounding::Nearest>(a * w.im + b * w.re, coeff_bits);
+                }
+            } else {
+                Value in = x - decay_ * old;
+                for (std::size_t m = 0; m < state_.size(); ++m) {
+                    const auto& w = rotations_[m];
+                    Value a = state_[m].re + in, b = state_[m].im;
+                    state_[m].re = a * w.re - b * w.im;
+                    state_[m].im = a * w.im + b * w.re;
+                }
+            }
+        }
+
+        void process(std::span<const SampleType> samples) {
+            for (const auto& x : samples) process(x);
+        }
+
+        // X[k]/N of the last N samples (zeros before the first ones) for bin m
+        Complex bin(std::size_t m) const {
+            const auto& s = state_.at(m);
+            if constexpr (fixed) {
+                Value scale = Value(N_) << sliding_dft_guard_bits;
+                return Complex(detail::detector_narrow<SampleType>(detail::divide_rounded(s.re, scale)),
+                               detail::detector_narrow<SampleType>(detail::divide_rounded(s.im, scale)));
+            } else {
+                SampleType scale = SampleType(1) / SampleType(N_);
+                return Complex(s.re * scale, s.im * scale);
+            }
+        }
+
+        // Every bin, in the order they were given
+        std::vector<Complex> values() const {
+            std::vector<Complex> result;
+            result.reserve(state_.size());
+            for (std::size_t m = 0; m < state_.size(); ++m) result.push_back(bin(m));
+            return result;
+        }
+
+        // Clear the window and the bins
+        void reset() {
+            std::fill(history_.begin(), history_.end(), SampleType{ 0 });
+            state_.assign(bins_.size(), Bin{ Value{ 0 }, Value{ 0 } });
+            next_ = 0;
+        }
+
+    private:
+        using Value = typename detail::detector_value<SampleType>::type;
+        static constexpr int coeff_bits = detail::detector_value<SampleType>::coeff_bits;
+
+        struct Bin {
+            Value re, im;
+        };
+
+        static Value make_coeff(double x) {
+            if constexpr (fixed) return detail::detector_coeff<Value>(x, coeff_bits);
+            else return SampleType(x);
+        }
+
+        std::size_t N_;
+        std::vector<std::size_t> bins_;
+        std::vector<SampleType> history_;  ///< the last N samples, oldest at next_
+        std::vector<Bin> rotations_;       ///< r e^(jw) per bin
+        std::vector<Bin> state_;
+        Value decay_{ 0 };                 ///< r^N
+        std::size_t next_{ 0 };
+    };
+
+} // namespace dsp
@@ -0,0 +1,64 @@
+#pragma once
+
+// Silence the MSVC warning about non‐floating std::complex<T>
+#ifndef _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#define _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#endif
+
+#include <bit>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include "concepts.hpp"
+#include "fixed_point/fixed_point.hpp"
+#include "fixed_point/reciprocal.hpp"
+
+namespace dsp {
+
+    // Multiplies samples by 1/N (inverse transforms, averaging) without a divide per sample.
+    // FixedPoint: a rounding shift when N is a power of two, otherwise a precomputed Reciprocal;
+    // both round to nearest (half away from zero), so the bias does not depend on N.
+    // Floating point: multiply by the exact 1/N for powers of two, otherwise divide.
+    template<Arithmetic SampleType>
+    class Normalizer {
+    public:
+        constexpr explicit Normalizer(std::size_t N)
+            : N_(N), pow2_(std::has_single_bit(N)), log2N_(static_cast<int>(std::bit_width(N)) - 1),
+              reciprocal_(make_reciprocal(N)) {}
+
+        constexpr SampleType operator()(const SampleType& x) const {
+            if constexpr (is_fixed_point_v<SampleType>) {
+                if (pow2_) return x.template scale_pow2<fixed_point::Rounding::Nearest>(-log2N_);
+                return reciprocal_.apply_rounded(x);
+            } else if constexpr (std::is_floating_point_v<SampleType>) {
+                if (pow2_) return x * (SampleType(1) / SampleType(N_));
+                return x / SampleType(N_);
+            } else {
+                return x * (SampleType(1.0) / SampleType(double(N_)));
+            }
+        }
+
+        // std::complex<SampleType> or cfixed<SampleType>
+        template<typename Complex>
+            requires requires(const Complex& z) { { z.real() } -> std::convertible_to<SampleType>; }
+        constexpr Complex operator()(const Complex& x) const {
+            return Complex((*this)(x.real()), (*this)(x.imag()));
+        }
+
+    private:
+        struct NoReciprocal {};
+        using ReciprocalType = std::conditional_t<is_fixed_point_v<SampleType>, Reciprocal<SampleType>, NoReciprocal>;
+
+        std::size_t N_;
+        bool pow2_;
+        int log2N_;
+        ReciprocalType reciprocal_;
+
+        static constexpr ReciprocalType make_reciprocal(std::size_t N) {
+            if constexpr (is_fixed_point_v<SampleType>) return ReciprocalType::from_count(N);
+            else return ReciprocalType{};
+        }
+    };
+
+} // namespace dsp
@@ -0,0 +1,121 @@
+#pragma once
+
+// Silence MSVC’s non-floating std::complex warning
+#ifndef _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#define _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#endif
+
+#include <complex>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "fft.hpp"
+#include "normalize.hpp"
+
+namespace dsp {
+
+    // FFT of N real samples through one N/2-point complex FFT.
+    // forward() packs x[2n] + j*x[2n+1] straight into the output buffer, transforms it
+    // in place and separates the even/odd spectra with one twiddle pass, giving the
+    // N/2+1 non-redundant bins X[0..N/2] (the rest are conj(X[N-k])). inverse() runs
+    // the same steps backwards. Neither widens the input to N complex samples.
+    template<Arithmetic SampleType, typename Complex = complex_sample<SampleType>>
+    struct RealFFTPlan {
+        std::size_t N;                          ///< number of real samples
+        FFTPlan<SampleType, Complex> half;      ///< N/2-point complex transform
+        std::vector<Complex> twiddles;          ///< W_N^k for k=0..N/4
+
+        // N must be a power of two, at least 2
+        constexpr explicit RealFFTPlan(std::size_t N, FFTKernel kernel = FFTKernel::Auto)
+            : N(N), half(checked_half(N), kernel) {
+            twiddles.resize(N / 4 + 1);
+            for (std::size_t k = 0; k <= N / 4; ++k) {
+                twiddles[k] = make_twiddle<SampleType, Complex>(N, k, /*inverse=*/false);
+            }
+        }
+
+        // N real samples -> N/2+1 bins (spectrum is resized, so reusing it does not allocate)
+        constexpr void forward(std::span<const SampleType> signal, std::vector<Complex>& spectrum) const {
+            if (signal.size() != N) {
+                throw std::invalid_argument("Data size must match FFT plan size");
+            }
+            const std::size_t M = N / 2;
+            spectrum.resize(M + 1);
+            for (std::size_t n = 0; n < M; ++n) {
+                spectrum[n] = Complex(signal[2 * n], signal[2 * n + 1]);
+            }
+
+            half.forward(std::span<Complex>(spectrum).first(M));
+
+            // Z = E + jO with E, O the spectra of the even and odd samples; X[k] = E[k] + W^k O[k].
+            // Inputs are halved first so the separation cannot overflow.
+            using std::conj;
+            Normalizer<SampleType> halve(2);
+            auto z0 = spectrum[0];
+            spectrum[0] = Complex(z0.real() + z0.imag(), SampleType{ 0 });
+            spectrum[M] = Complex(z0.real() - z0.imag(), SampleType{ 0 });
+            for (std::size_t k = 1; k <= M / 2; ++k) {
+                std::size_t m = M - k;
+                auto a = halve(spectrum[k]);
+                auto b = halve(spectrum[m]);
+                auto even = a + conj(b);
+                auto odd = detail::times_neg_j(a - conj(b)) * twiddles[k];
+                // X[M-k] = conj(E[k] - W^k O[k])
+                spectrum[k] = even + odd;
+                spectrum[m] = conj(even - odd);
+            }
+        }
+
+        constexpr void forward(const std::vector<SampleType>& signal, std::vector<Complex>& spectrum) const {
+            forward(std::span<const SampleType>(signal), spectrum);
+        }
+
+        // N/2+1 bins -> N real samples (with 1/N scaling). spectrum is used as scratch space.
+        constexpr void inverse(std::vector<Complex>& spectrum, std::span<SampleType> signal) const {
+            const std::size_t M = N / 2;
+            if (spectrum.size() != M + 1 || signal.size() != N) {
+                throw std::invalid_argument("Data size must match FFT plan size");
+            }
+
+            // Rebuild Z[k] = E[k] + jO[k] with E = (X[k] + conj X[M-k]) / 2 and
+            // O = (X[k] - conj X[M-k]) conj(W^k) / 2; the halves and the 1/M below give 1/N
+            using std::conj;
+            Normalizer<SampleType> halve(2);
+            auto x0 = halve(spectrum[0]);
+            auto xm = halve(spectrum[M]);
+            spectrum[0] = Complex(x0.real() + xm.real(), x0.real() - xm.real());
+            for (std::size_t k = 1; k <= M / 2; ++k) {
+                std::size_t m = M - k;
+                auto a = halve(spectrum[k]);
+                auto b = halve(spectrum[m]);
+                auto even = a + conj(b);
+                auto odd = (a - conj(b)) * conj(twiddles[k]);
+                // Z[M-k] = conj(E[k]) + j conj(O[k])
+                spectrum[k] = even - detail::times_neg_j(odd);
+                spectrum[m] = conj(even) - detail::times_neg_j(conj(odd));
+            }
+
+            auto z = std::span<Complex>(spectrum).first(M);
+            half.inverse(z);
+            for (std::size_t n = 0; n < M; ++n) {
+                signal[2 * n] = z[n].real();
+                signal[2 * n + 1] = z[n].imag();
+            }
+        }
+
+        constexpr void inverse(std::vector<Complex>& spectrum, std::vector<SampleType>& signal) const {
+            signal.resize(N);
+            inverse(spectrum, std::span<SampleType>(signal));
+        }
+
+    private:
+        static constexpr std::size_t checked_half(std::size_t N) {
+            if (N < 2 || (N & (N - 1)) != 0) {
+                throw std::invalid_argument("Real FFT size must be a power of two, at least 2");
+            }
+            return N / 2;
+        }
+    };
+
+} // namespace dsp
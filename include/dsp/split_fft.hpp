@@ -0,0 +1,217 @@
+#pragma once
+
+// Silence MSVC’s non-floating std::complex warning
+#ifndef _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#define _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#endif
+
+#include <complex>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "concepts.hpp"
+#include "fft.hpp"
+#include "twiddle.hpp"
+#include "fixed_point/simd.hpp"
+
+namespace dsp {
+
+    // Interleaved complex samples (std::complex or cfixed) -> separate real/imaginary arrays
+    template<typename Complex, typename SampleType>
+    constexpr void deinterleave(std::span<const Complex> data, std::span<SampleType> re, std::span<SampleType> im) {
+        if (re.size() != data.size() || im.size() != data.size()) {
+            throw std::invalid_argument("Real and imaginary arrays must match the complex data size");
+        }
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            re[i] = data[i].real();
+            im[i] = data[i].imag();
+        }
+    }
+
+    // Separate real/imaginary arrays -> interleaved complex samples
+    template<typename Complex, typename SampleType>
+    constexpr void interleave(std::span<const SampleType> re, std::span<const SampleType> im, std::span<Complex> data) {
+        if (re.size() != data.size() || im.size() != data.size()) {
+            throw std::invalid_argument("Real and imaginary arrays must match the complex data size");
+        }
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            data[i] = Complex(re[i], im[i]);
+        }
+    }
+
+    // Radix-2 FFT on split-complex (structure-of-arrays) data: the real and imaginary
+    // parts live in two arrays, and so do the twiddles. Every butterfly then loads whole
+    // vectors of real and of imaginary parts, so FixedPoint stages go through the
+    // simd::butterfly kernels with no shuffles. The arithmetic is the same as a Radix2
+    // FFTPlan<SampleType> on std::complex data, so the results are bit-identical to it.
+    template<Arithmetic SampleType>
+    struct SplitFFTPlan {
+        std::size_t N;                          ///< transform size
+        std::vector<std::size_t> bitrev;        ///< bit-reversed indices
+        std::vector<SampleType> twiddle_re;     ///< per stage of span len: Re W^j, j=0..len/2-1, at offset len/2-1
+        std::vector<SampleType> twiddle_im;     ///< matching imaginary parts
+        std::vector<SampleType> twiddle_im_conj; ///< -twiddle_im, for the inverse passes
+
+        // Build tables for size N (must be a power of two)
+        explicit SplitFFTPlan(std::size_t N) : N(N) {
+            if (N == 0 || (N & (N - 1)) != 0) {
+                throw std::invalid_argument("FFT size must be a power of two");
+            }
+
+            std::size_t levels = 0;
+            while ((std::size_t(1) << levels) < N) ++levels;
+            bitrev.resize(N);
+            for (std::size_t i = 0; i < N; ++i) {
+                std::size_t r = 0;
+                for (std::size_t j = 0; j < levels; ++j) {
+                    if (i & (std::size_t(1) << j)) {
+                        r |= (std::size_t(1) << (levels - 1 - j));
+                    }
+                }
+                bitrev[i] = r;
+            }
+
+            // Each stage reads its twiddles contiguously; W_N^(j*N/len), as FFTPlan computes them
+            twiddle_re.resize(N > 1 ? N - 1 : 0);
+            twiddle_im.resize(N > 1 ? N - 1 : 0);
+            for (std::size_t len = 2; len <= N; len <<= 1) {
+                std::size_t half = len / 2;
+                for (std::size_t j = 0; j < half; ++j) {
+                    auto w = make_twiddle<SampleType>(N, j * (N / len), /*inverse=*/false);
+                    twiddle_re[half - 1 + j] = w.real();
+                    twiddle_im[half - 1 + j] = w.imag();
+                }
+            }
+            twiddle_im_conj.resize(twiddle_im.size());
+            for (std::size_t i = 0; i < twiddle_im.size(); ++i) twiddle_im_conj[i] = -twiddle_im[i];
+        }
+
+        // In-place forward FFT (no 1/N scaling)
+        void forward(std::span<SampleType> re, std::span<SampleType> im) const {
+            if (re.size() != N || im.size() != N) {
+                throw std::invalid_argument("Data size must match FFT plan size");
+            }
+
+            transform<false>(re, im);
+        }
+
+        void forward(std::vector<SampleType>& re, std::vector<SampleType>& im) const {
+            forward(std::span<SampleType>(re), std::span<SampleType>(im));
+        }
+
+        // In-place inverse FFT (with 1/N scaling)
+        void inverse(std::span<SampleType> re, std::span<SampleType> im) const {
+            if (re.size() != N || im.size() != N) {
+                throw std::invalid_argument("Data size must match FFT plan size");
+            }
+
+            transform<true>(re, im);
+        }
+
+        void inverse(std::vector<SampleType>& re, std::vector<SampleType>& im) const {
+            inverse(std::span<SampleType>(re), std::span<SampleType>(im));
+        }
+
+    private:
+        // Shorter blocks (the first few stages) are cheaper in scalar code than through the dispatcher
+        static constexpr std::size_t min_vector_half = 8;
+
+        // Forward passes, or the inverse ones: conjugate twiddles, +j for -j and the 1/N folded
+        // into the last pass exactly as FFTPlan::inverse does it
+        template<bool Inverse>
+        void transform(std::span<SampleType> re, std::span<SampleType> im) const {
+            for (std::size_t i = 0; i < N; ++i) {
+                if (i < bitrev[i]) {
+                    std::swap(re[i], re[bitrev[i]]);
+                    std::swap(im[i], im[bitrev[i]]);
+                }
+            }
+            for (std::size_t len = 2; len <= N; len <<= 1) {
+                detail::with_pass_scale<SampleType, Inverse>(N, len == N, [&](const auto& scale) {
+                    butterfly_stage<Inverse>(re, im, len, scale);
+                });
+            }
+        }
+
+        // One stage of span len; W = 1 (j = 0) and W = -j (j = len/4, +j inverse) need no multiply.
+        // The scale applies to the stage's outputs, after the kernels have run on the block.
+        template<bool Inverse, typename Scale>
+        void butterfly_stage(std::span<SampleType> re, std::span<SampleType> im, std::size_t len,
+                             const Scale& scale) const {
+            const std::size_t half = len >> 1;
+            const SampleType* wr = twiddle_re.data() + half - 1;
+            const SampleType* wi = (Inverse ? twiddle_im_conj : twiddle_im).data() + half - 1;
+            for (std::size_t i = 0; i < N; i += len) {
+                SampleType* ur = re.data() + i;
+                SampleType* ui = im.data() + i;
+                SampleType* xr = ur + half;
+                SampleType* xi = ui + half;
+                butterfly_block<Inverse>(ur, ui, xr, xi, wr, wi, half);
+                if constexpr (!std::is_same_v<Scale, detail::NoScale>) {
+                    for (std::size_t j = 0; j < len; ++j) {
+                        ur[j] = scale(ur[j]);
+                        ui[j] = scale(ui[j]);
+                    }
+                }
+            }
+        }
+
+        template<bool Inverse>
+        static void butterfly_block(SampleType* ur, SampleType* ui, SampleType* xr, SampleType* xi,
+                                    const SampleType* wr, const SampleType* wi, std::size_t half) {
+            const std::size_t quarter = half >> 1;
+            if constexpr (is_fixed_point_v<SampleType>) {
+                if (half >= min_vector_half) {
+                    // The kernels run the whole block; the two trivial butterflies are then redone
+                    // from their inputs, since a quantized W^0 is not exactly 1
+                    SampleType in[8] = { ur[0], ui[0], xr[0], xi[0],
+                                         ur[quarter], ui[quarter], xr[quarter], xi[quarter] };
+                    fixed_point::simd::butterfly(std::span<SampleType>(ur, half), std::span<SampleType>(ui, half),
+                                                 std::span<SampleType>(xr, half), std::span<SampleType>(xi, half),
+                                                 std::span<const SampleType>(wr, half), std::span<const SampleType>(wi, half));
+                    trivial_butterfly(ur[0], ui[0], xr[0], xi[0], in[0], in[1], in[2], in[3]);
+                    if constexpr (Inverse) {
+                        trivial_butterfly(ur[quarter], ui[quarter], xr[quarter], xi[quarter], in[4], in[5], -in[7], in[6]);
+                    } else {
+                        trivial_butterfly(ur[quarter], ui[quarter], xr[quarter], xi[quarter], in[4], in[5], in[7], -in[6]);
+                    }
+                    return;
+                }
+            }
+            trivial_butterfly(ur[0], ui[0], xr[0], xi[0], ur[0], ui[0], xr[0], xi[0]);
+            if (quarter == 0) return;
+            twiddle_run(ur, ui, xr, xi, wr, wi, 1, quarter);
+            // (xr + j*xi) * -j = xi - j*xr, and * +j = -xi + j*xr
+            if constexpr (Inverse) {
+                trivial_butterfly(ur[quarter], ui[quarter], xr[quarter], xi[quarter],
+                                  ur[quarter], ui[quarter], -xi[quarter], xr[quarter]);
+            } else {
+                trivial_butterfly(ur[quarter], ui[quarter], xr[quarter], xi[quarter],
+                                  ur[quarter], ui[quarter], xi[quarter], -xr[quarter]);
+            }
+            twiddle_run(ur, ui, xr, xi, wr, wi, quarter + 1, half);
+        }
+
+        // (ur, ui) = u + v, (xr, xi) = u - v
+        static void trivial_butterfly(SampleType& ur, SampleType& ui, SampleType& xr, SampleType& xi,
+                                      SampleType u_r, SampleType u_i, SampleType vr, SampleType vi) {
+            ur = u_r + vr;
+            ui = u_i + vi;
+            xr = u_r - vr;
+            xi = u_i - vi;
+        }
+
+        static void twiddle_run(SampleType* ur, SampleType* ui, SampleType* xr, SampleType* xi,
+                                const SampleType* wr, const SampleType* wi, std::size_t begin, std::size_t end) {
+            for (std::size_t j = begin; j < end; ++j) {
+                SampleType vr = xr[j] * wr[j] - xi[j] * wi[j];
+                SampleType vi = xr[j] * wi[j] + xi[j] * wr[j];
+                trivial_butterfly(ur[j], ui[j], xr[j], xi[j], ur[j], ui[j], vr, vi);
+            }
+        }
+    };
+
+} // namespace dsp
@@ -0,0 +1,209 @@
+#pragma once
+
+// Silence MSVC’s non-floating std::complex warning
+#ifndef _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#define _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#endif
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include "fft.hpp"
+
+namespace dsp {
+
+    // Radix-4 passes up to this span are fully unrolled; longer ones keep their butterfly loop
+    // (in FFTBenchmark, unrolling the 32- and 64-point passes too made them slower, not faster)
+    inline constexpr std::size_t static_fft_unroll_max = 16;
+
+    // Sizes up to this get an unrolled bit-reversal permutation
+    inline constexpr std::size_t static_fft_unroll_swaps_max = 256;
+
+    // FFT whose size is part of the type. The bit-reversal and twiddle tables are constexpr,
+    // there is no size check at run time, and the work is straight-line code: sizes 2, 4 and 8
+    // are hand-written codelets that keep all points in registers, and every larger size
+    // combines four quarter-size transforms with one unrolled radix-4 pass. That is the
+    // structure of the Radix4 kernel (a radix-2 step first when log2(N) is odd, the same
+    // twiddle values and multiplies), so the results are bit-identical to an Auto FFTPlan
+    // below the four-step size. Everything is constexpr, so spectra can be computed at
+    // compile time.
+    template<Arithmetic SampleType, std::size_t N, typename Complex = complex_sample<SampleType>>
+    struct StaticFFT {
+        static_assert(N >= 1 && (N & (N - 1)) == 0, "FFT size must be a power of two");
+
+        static constexpr std::size_t size = N;
+        static constexpr std::array<std::size_t, N> bitrev = make_bitrev_table<N>();
+
+        // W_N^k for k=0..N-1 (radix-4 passes reach W^3j, past the half circle)
+        static constexpr std::array<Complex, N> twiddles = [] {
+            std::array<Complex, N> table{};
+            for (std::size_t k = 0; k < N; ++k) table[k] = make_twiddle<SampleType, Complex>(N, k, /*inverse=*/false);
+            return table;
+        }();
+
+        // In-place forward FFT (no 1/N scaling)
+        static constexpr void forward(std::span<Complex, N> data) {
+            permute(data);
+            transform<N, false>(data.data());
+        }
+
+        static constexpr void forward(std::array<Complex, N>& data) {
+            forward(std::span<Complex, N>(data));
+        }
+
+        // In-place inverse FFT (with 1/N scaling): the forward passes with conjugate twiddles and
+        // the 1/N in the last one, as FFTPlan::inverse runs them, so the results match it too
+        static constexpr void inverse(std::span<Complex, N> data) {
+            permute(data);
+            transform<N, true>(data.data());
+        }
+
+        static constexpr void inverse(std::array<Complex, N>& data) {
+            inverse(std::span<Complex, N>(data));
+        }
+
+    private:
+        // W_M^k, M | N
+        template<std::size_t M>
+        static constexpr const Complex& twiddle(std::size_t k) {
+            return twiddles[k * (N / M)];
+        }
+
+        static constexpr void permute(std::span<Complex, N> data) {
+            // For small N the swap list is spelled out at compile time: no index loads or compares
+            if constexpr (N <= static_fft_unroll_swaps_max) {
+                [&]<std::size_t... I>(std::index_sequence<I...>) {
+                    (swap_if_reversed<I>(data.data()), ...);
+                }(std::make_index_sequence<N>{});
+            } else {
+                for (std::size_t i = 0; i < N; ++i) {
+                    if (i < bitrev[i]) std::swap(data[i], data[bitrev[i]]);
+                }
+            }
+        }
+
+        template<std::size_t I>
+        static constexpr void swap_if_reversed(Complex* x) {
+            if constexpr (I < bitrev[I]) std::swap(x[I], x[bitrev[I]]);
+        }
+
+        // Calls f with the input scaling of the pass that ends an M-point transform
+        template<bool Inverse, std::size_t M, typename F>
+        static constexpr void with_scale(F&& f) {
+            detail::with_pass_scale<SampleType, Inverse>(N, M == N, std::forward<F>(f));
+        }
+
+        // M-point DIT on bit-reversed data
+        template<std::size_t M, bool Inverse>
+        static constexpr void transform(Complex* x) {
+            if constexpr (M == 1) {
+                return;
+            } else if constexpr (M == 2) {
+                with_scale<Inverse, M>([&](const auto& scale) { codelet2(x, scale); });
+            } else if constexpr (M == 4) {
+                with_scale<Inverse, M>([&](const auto& scale) { codelet4<Inverse>(x, scale); });
+            } else if constexpr (M == 8) {
+                with_scale<Inverse, M>([&](const auto& scale) { codelet8<Inverse>(x, scale); });
+            } else {
+                constexpr std::size_t q = M / 4;
+                transform<q, Inverse>(x);
+                transform<q, Inverse>(x + q);
+                transform<q, Inverse>(x + 2 * q);
+                transform<q, Inverse>(x + 3 * q);
+                with_scale<Inverse, M>([&](const auto& scale) {
+                    if constexpr (M <= static_fft_unroll_max) {
+                        [&]<std::size_t... J>(std::index_sequence<J...>) {
+                            (radix4_column<M, J, Inverse>(x, scale), ...);
+                        }(std::make_index_sequence<q>{});
+                    } else {
+                        radix4_butterfly<Inverse>(x, q, scale, x[0], x[q], x[2 * q], x[3 * q]);
+                        for (std::size_t j = 1; j < q; ++j) {
+                            radix4_butterfly<Inverse>(x + j, q, scale, x[j],
+                                                      detail::twiddle_mul<Inverse>(x[j + q], twiddle<M>(2 * j)),
+                                                      detail::twiddle_mul<Inverse>(x[j + 2 * q], twiddle<M>(j)),
+                                                      detail::twiddle_mul<Inverse>(x[j + 3 * q], twiddle<M>(3 * j)));
+                        }
+                    }
+                });
+            }
+        }
+
+        // Butterfly J of the radix-4 pass that finishes an M-point transform (as FFTPlan::radix4_pass)
+        template<std::size_t M, std::size_t J, bool Inverse, typename Scale>
+        static constexpr void radix4_column(Complex* x, const Scale& scale) {
+            constexpr std::size_t q = M / 4;
+            if constexpr (J == 0) {
+                radix4_butterfly<Inverse>(x, q, scale, x[0], x[q], x[2 * q], x[3 * q]);
+            } else {
+                radix4_butterfly<Inverse>(x + J, q, scale, x[J],
+                                          detail::twiddle_mul<Inverse>(x[J + q], twiddle<M>(2 * J)),
+                                          detail::twiddle_mul<Inverse>(x[J + 2 * q], twiddle<M>(J)),
+                                          detail::twiddle_mul<Inverse>(x[J + 3 * q], twiddle<M>(3 * J)));
+            }
+        }
+
+        template<bool Inverse, typename Scale>
+        static constexpr void radix4_butterfly(Complex* p, std::size_t q, const Scale& scale, const Complex& c0,
+                                               const Complex& c1, const Complex& c2, const Complex& c3) {
+            Complex s0 = c0 + c1, d0 = c0 - c1;
+            Complex s1 = c2 + c3;
+            Complex d1 = detail::quarter_turn<Inverse>(c2 - c3);
+            p[0] = scale(s0 + s1);
+            p[q] = scale(d0 + d1);
+            p[2 * q] = scale(s0 - s1);
+            p[3 * q] = scale(d0 - d1);
+        }
+
+        template<typename Scale>
+        static constexpr void codelet2(Complex* x, const Scale& scale) {
+            Complex a = x[0], b = x[1];
+            x[0] = scale(a + b);
+            x[1] = scale(a - b);
+        }
+
+        // One radix-4 butterfly with trivial twiddles
+        template<bool Inverse, typename Scale>
+        static constexpr void codelet4(Complex* x, const Scale& scale) {
+            Complex a0 = x[0], a1 = x[1], a2 = x[2], a3 = x[3];
+            Complex s0 = a0 + a1, d0 = a0 - a1;
+            Complex s1 = a2 + a3;
+            Complex d1 = detail::quarter_turn<Inverse>(a2 - a3);
+            x[0] = scale(s0 + s1);
+            x[1] = scale(d0 + d1);
+            x[2] = scale(s0 - s1);
+            x[3] = scale(d0 - d1);
+        }
+
+        // Four 2-point transforms, then a radix-4 pass with q = 2 (W8^2, W8^1, W8^3 on column 1);
+        // scale is the radix-4 pass's
+        template<bool Inverse, typename Scale>
+        static constexpr void codelet8(Complex* x, const Scale& scale) {
+            Complex a0 = x[0], a1 = x[1], a2 = x[2], a3 = x[3];
+            Complex a4 = x[4], a5 = x[5], a6 = x[6], a7 = x[7];
+            Complex b0 = a0 + a1, b1 = a0 - a1, b2 = a2 + a3, b3 = a2 - a3;
+            Complex b4 = a4 + a5, b5 = a4 - a5, b6 = a6 + a7, b7 = a6 - a7;
+
+            Complex s0 = b0 + b2, d0 = b0 - b2;
+            Complex s1 = b4 + b6;
+            Complex d1 = detail::quarter_turn<Inverse>(b4 - b6);
+            x[0] = scale(s0 + s1);
+            x[2] = scale(d0 + d1);
+            x[4] = scale(s0 - s1);
+            x[6] = scale(d0 - d1);
+
+            Complex c1 = detail::twiddle_mul<Inverse>(b3, twiddle<8>(2));
+            Complex c2 = detail::twiddle_mul<Inverse>(b5, twiddle<8>(1));
+            Complex c3 = detail::twiddle_mul<Inverse>(b7, twiddle<8>(3));
+            Complex t0 = b1 + c1, e0 = b1 - c1;
+            Complex t1 = c2 + c3;
+            Complex e1 = detail::quarter_turn<Inverse>(c2 - c3);
+            x[1] = scale(t0 + t1);
+            x[3] = scale(e0 + e1);
+            x[5] = scale(t0 - t1);
+            x[7] = scale(e0 - e1);
+        }
+    };
+
+} // namespace dsp
@@ -0,0 +1,43 @@
+#pragma once
+
+// Silence MSVC’s non-floating std::complex warning
+#ifndef _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#define _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#endif
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include "concepts.hpp"
+#include "constexpr_math.hpp"
+#include "cfixed.hpp"
+
+namespace dsp {
+
+    // Alias for a complex sample
+    template<Arithmetic SampleType>
+    using complex_sample = std::complex<SampleType>;
+
+    // Helper to build e^{+-2*pi*i*m/N} in SampleType (usable in constant expressions).
+    // Complex is std::complex<SampleType> or cfixed<SampleType>.
+    template<Arithmetic SampleType, typename Complex = complex_sample<SampleType>>
+    constexpr Complex
+        make_twiddle(std::size_t N, std::size_t m, bool inverse = false)
+    {
+        double sign = inverse ? +1.0 : -1.0;
+        double phase = sign * 2.0 * std::numbers::pi * double(m % N) / double(N);
+        double re = constexpr_cos(phase);
+        double im = constexpr_sin(phase);
+        if constexpr (is_fixed_point_v<SampleType>) {
+            // Formats without integer bits cannot hold 1.0, and cosines that round up to it would
+            // wrap to -1, so clamp to the largest representable value
+            constexpr double top = SampleType::from_raw(std::numeric_limits<typename SampleType::StorageType>::max()).to_double();
+            re = std::min(re, top);
+            im = std::min(im, top);
+        }
+        return Complex(SampleType{ re }, SampleType{ im });
+    }
+
+} // namespace dsp
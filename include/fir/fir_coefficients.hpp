@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <span>
 #include <vector>
 #include <cmath>
 #include <numeric>
@@ -7,6 +9,7 @@
 #include <stdexcept>
 #include <algorithm>
 #include "fir_filter.hpp"
+#include "dsp/constexpr_math.hpp"
 
 namespace dsp {
 
@@ -16,100 +19,134 @@ namespace dsp {
         HighPass
     };
 
-	// Specific helper for low-pass filter generation
-    template<typename SampleType>
-    std::vector<SampleType> generate_lowpass_coefficients(std::size_t num_taps,
-        double sample_rate,
-        double cutoff_freq) {
+    namespace detail {
+
+        // Windowed-sinc low-pass design written into an existing range, usable in constant expressions
+        template<typename SampleType>
+        constexpr void fill_lowpass_coefficients(std::span<SampleType> coefficients,
+            double sample_rate,
+            double cutoff_freq) {
+
+            std::size_t num_taps = coefficients.size();
+            double nyquist = sample_rate / 2.0;
+            double normalized_cutoff = cutoff_freq / nyquist;
+
+            for (std::size_t n = 0; n < num_taps; ++n) {
+                int centered_n = static_cast<int>(n) - static_cast<int>((num_taps - 1) / 2);
+
+                if (centered_n == 0) {
+                    coefficients[n] = static_cast<SampleType>(2 * normalized_cutoff);
+                }
+                else {
+                    double x = static_cast<double>(centered_n);
+                    coefficients[n] = static_cast<SampleType>(
+                        constexpr_sin(std::numbers::pi * 2 * normalized_cutoff * x) / (std::numbers::pi * x)
+                        );
+                }
+            }
 
-        std::vector<SampleType> coefficients(num_taps);
-        double nyquist = sample_rate / 2.0;
-        double normalized_cutoff = cutoff_freq / nyquist;
+            // Apply Hamming window
+            for (std::size_t n = 0; n < num_taps; ++n) {
+                coefficients[n] *= static_cast<SampleType>(
+                    0.54 - 0.46 * constexpr_cos(2 * std::numbers::pi * n / (num_taps - 1))
+                    );
+            }
 
-        for (std::size_t n = 0; n < num_taps; ++n) {
-            int centered_n = static_cast<int>(n) - static_cast<int>((num_taps - 1) / 2);
+            // Normalize
+            SampleType sum = std::accumulate(coefficients.begin(), coefficients.end(), SampleType(0));
+            for (auto& coeff : coefficients) {
+                coeff /= sum;
+            }
+        }
 
-            if (centered_n == 0) {
-                coefficients[n] = static_cast<SampleType>(2 * normalized_cutoff);
+        // Windowed-sinc high-pass design written into an existing range, usable in constant expressions
+        template<typename SampleType>
+        constexpr void fill_highpass_coefficients(std::span<SampleType> coefficients,
+            double sample_rate,
+            double cutoff_freq) {
+
+            std::size_t num_taps = coefficients.size();
+            double nyquist = sample_rate / 2.0;
+            double normalized_cutoff = cutoff_freq / nyquist;
+
+            for (std::size_t n = 0; n < num_taps; ++n) {
+                int centered_n = static_cast<int>(n) - static_cast<int>((num_taps - 1) / 2);
+
+                if (centered_n == 0) {
+                    coefficients[n] = static_cast<SampleType>(1 - 2 * normalized_cutoff);
+                }
+                else {
+                    double x = static_cast<double>(centered_n);
+                    coefficients[n] = static_cast<SampleType>(
+                        -constexpr_sin(std::numbers::pi * 2 * normalized_cutoff * x) / (std::numbers::pi * x)
+                        );
+                }
             }
-            else {
-                double x = static_cast<double>(centered_n);
-                coefficients[n] = static_cast<SampleType>(
-                    std::sin(std::numbers::pi * 2 * normalized_cutoff * x) / (std::numbers::pi * x)
+
+            // Apply Hamming window
+            for (std::size_t n = 0; n < num_taps; ++n) {
+                coefficients[n] *= static_cast<SampleType>(
+                    0.54 - 0.46 * constexpr_cos(2 * std::numbers::pi * n / (num_taps - 1))
                     );
             }
         }
 
-        // Apply Hamming window
-        for (std::size_t n = 0; n < num_taps; ++n) {
-            coefficients[n] *= static_cast<SampleType>(
-                0.54 - 0.46 * std::cos(2 * std::numbers::pi * n / (num_taps - 1))
-                );
-        }
+    } // namespace detail
 
-        // Normalize
-        SampleType sum = std::accumulate(coefficients.begin(), coefficients.end(), SampleType(0));
-        for (auto& coeff : coefficients) {
-            coeff /= sum;
-        }
+	// Specific helper for low-pass filter generation
+    template<typename SampleType>
+    constexpr std::vector<SampleType> generate_lowpass_coefficients(std::size_t num_taps,
+        double sample_rate,
+        double cutoff_freq) {
 
+        std::vector<SampleType> coefficients(num_taps);
+        detail::fill_lowpass_coefficients<SampleType>(coefficients, sample_rate, cutoff_freq);
+        return coefficients;
+    }
+
+    // Fixed-size low-pass coefficients, e.g.
+    //   static constexpr auto taps = generate_lowpass_coefficients<Fixed, 31>(48000.0, 1000.0);
+    template<typename SampleType, std::size_t Taps>
+    constexpr std::array<SampleType, Taps> generate_lowpass_coefficients(double sample_rate,
+        double cutoff_freq) {
+
+        std::array<SampleType, Taps> coefficients{};
+        detail::fill_lowpass_coefficients<SampleType>(coefficients, sample_rate, cutoff_freq);
         return coefficients;
     }
 
     // Specific helper for high-pass filter generation
     template<typename SampleType>
-    std::vector<SampleType> generate_highpass_coefficients(std::size_t num_taps,
+    constexpr std::vector<SampleType> generate_highpass_coefficients(std::size_t num_taps,
         double sample_rate,
         double cutoff_freq) {
 
         std::vector<SampleType> coefficients(num_taps);
-        double nyquist = sample_rate / 2.0;
-        double normalized_cutoff = cutoff_freq / nyquist;
-
-        for (std::size_t n = 0; n < num_taps; ++n) {
-            int centered_n = static_cast<int>(n) - static_cast<int>((num_taps - 1) / 2);
-
-            if (centered_n == 0) {
-                coefficients[n] = static_cast<SampleType>(1 - 2 * normalized_cutoff);
-            }
-            else {
-                double x = static_cast<double>(centered_n);
-                coefficients[n] = static_cast<SampleType>(
-                    -std::sin(std::numbers::pi * 2 * normalized_cutoff * x) / (std::numbers::pi * x)
-                    );
-            }
-        }
+        detail::fill_highpass_coefficients<SampleType>(coefficients, sample_rate, cutoff_freq);
+        return coefficients;
+    }
 
-        // Apply Hamming window
-        for (std::size_t n = 0; n < num_taps; ++n) {
-            coefficients[n] *= static_cast<SampleType>(
-                0.54 - 0.46 * std::cos(2 * std::numbers::pi * n / (num_taps - 1))
-                );
-        }
+    // Fixed-size high-pass coefficients, usable in constant expressions
+    template<typename SampleType, std::size_t Taps>
+    constexpr std::array<SampleType, Taps> generate_highpass_coefficients(double sample_rate,
+        double cutoff_freq) {
 
+        std::array<SampleType, Taps> coefficients{};
+        detail::fill_highpass_coefficients<SampleType>(coefficients, sample_rate, cutoff_freq);
         return coefficients;
     }
 
 
     template<typename SampleType, std::size_t Taps>
-    FIRFilter<SampleType, Taps> make_lowpass_filter(double sample_rate, double cutoff_freq) {
-        // Generate a vector of length Taps
-        auto vec = generate_lowpass_coefficients<SampleType>(Taps, sample_rate, cutoff_freq);
-
-        // Copy into a std::array<SampleType,Taps>
-        std::array<SampleType, Taps> arr{};
-        std::copy_n(vec.begin(), Taps, arr.begin());
-
-        // Now call the FIRFilter constructor that takes an array
-        return FIRFilter<SampleType, Taps>(arr);
+    constexpr FIRFilter<SampleType, Taps> make_lowpass_filter(double sample_rate, double cutoff_freq) {
+        return FIRFilter<SampleType, Taps>(
+            generate_lowpass_coefficients<SampleType, Taps>(sample_rate, cutoff_freq));
     }
 
     template<typename SampleType, std::size_t Taps>
-    FIRFilter<SampleType, Taps> make_highpass_filter(double sample_rate, double cutoff_freq) {
-        auto vec = generate_highpass_coefficients<SampleType>(Taps, sample_rate, cutoff_freq);
-        std::array<SampleType, Taps> arr{};
-        std::copy_n(vec.begin(), Taps, arr.begin());
-        return FIRFilter<SampleType, Taps>(arr);
+    constexpr FIRFilter<SampleType, Taps> make_highpass_filter(double sample_rate, double cutoff_freq) {
+        return FIRFilter<SampleType, Taps>(
+            generate_highpass_coefficients<SampleType, Taps>(sample_rate, cutoff_freq));
     }
 
     // General coefficient generator for any FIR filter
@@ -1,8 +1,18 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
 #include "fixed_point/fixed_point.hpp"
+#include "fixed_point/int128.hpp"
+#include "fixed_point/rounding.hpp"
+#include "dsp/accumulate.hpp"
+#include "dsp/block_float.hpp"
 
 namespace dsp {
 
@@ -12,32 +22,33 @@ namespace dsp {
         using CoeffArray = std::array<SampleType, Taps>;
 
         // Constructors
-        FIRFilter() {
+        constexpr FIRFilter() {
             reset();
         }
 
 		// Constructor with coefficients
-        explicit FIRFilter(const CoeffArray& coeffs) {
+        constexpr explicit FIRFilter(const CoeffArray& coeffs) {
 			set_coefficients(coeffs);
         }
 
         // Set coefficients after construction
-        void set_coefficients(const CoeffArray& coeffs) {
+        constexpr void set_coefficients(const CoeffArray& coeffs) {
             coeffs_ = coeffs;
 			reset();
         }
 
         // Process one input sample and return the filtered output
-        SampleType process(SampleType input_sample) {
+        constexpr SampleType process(SampleType input_sample) {
             // Add new sample to the buffer
             buffer_[buffer_index_] = input_sample;
 
-            SampleType output = 0;
+            // Enough guard bits for Taps full-scale products; saturates once per output
+            MacAccumulator<SampleType, static_cast<int>(std::bit_width(Taps))> output;
             std::size_t tap_index = buffer_index_;
 
             for (std::size_t i = 0; i < Taps; ++i) {
 				// Calculate the filtered output output[n] = sum(c[k] * x[n-k])
-                output += coeffs_[i] * buffer_[tap_index];
+                output.mac(coeffs_[i], buffer_[tap_index]);
 				// Move to the next tap index, go around if necessary
                 tap_index = (tap_index == 0) ? Taps - 1 : tap_index - 1;
 			}
@@ -45,17 +56,78 @@ namespace dsp {
 			// Move the buffer index forward
 			buffer_index_ = (buffer_index_ + 1) % Taps;
 
-            return output;
+            return output.result();
+        }
+
+        // Process a block-floating-point block and return the outputs with one shared exponent.
+        // The delay line keeps the exponent of the block it came from; each product is formed
+        // exactly and brought to a common exponent in a wide sum, so a quiet block following a
+        // loud one keeps its own precision once the loud history has left the delay line.
+        // Don't mix with per-sample process() between resets.
+        constexpr BlockFloat<SampleType> process(const BlockFloat<SampleType>& input)
+            requires (is_fixed_point_v<SampleType> && 2 * SampleType::total_bits <= 64)
+        {
+            using fixed_point::Rounding;
+            using Wide = std::conditional_t<(2 * SampleType::total_bits <= 32), int64_t, fixed_point::wide_int128>;
+            constexpr std::size_t History = Taps - 1;
+            // Left shift the wide sum can take on top of Taps full-scale products
+            constexpr int budget = static_cast<int>(sizeof(Wide) * 8) - 1 - 2 * SampleType::total_bits
+                                   - static_cast<int>(std::bit_width(Taps));
+
+            // Oldest-first history followed by the block: line[j] with j < History is at buffer_exponent_
+            std::vector<SampleType> line(History + input.size());
+            for (std::size_t j = 0; j < History; ++j) line[j] = buffer_[(buffer_index_ + 1 + j) % Taps];
+            std::copy(input.mantissas.begin(), input.mantissas.end(), line.begin() + History);
+
+            // Sum at the smaller exponent unless the gap exceeds the budget
+            int high = std::max(buffer_exponent_, input.exponent);
+            int exponent = std::max(std::min(buffer_exponent_, input.exponent), high - budget);
+            // Products are below 2^(2 * total_bits), so right shifts past bits(Wide) - 1 round them
+            // to zero all the same; shift_right_rounded needs its shift below bits(Wide)
+            constexpr int max_right = static_cast<int>(sizeof(Wide) * 8) - 1;
+            int history_shift = std::max(buffer_exponent_ - exponent, -max_right);
+            int block_shift = std::max(input.exponent - exponent, -max_right);
+
+            std::vector<Wide> sums(input.size());
+            for (std::size_t n = 0; n < input.size(); ++n) {
+                Wide sum = 0;
+                for (std::size_t k = 0; k < Taps; ++k) {
+                    std::size_t j = History + n - k;
+                    Wide product = static_cast<Wide>(coeffs_[k].raw()) * static_cast<Wide>(line[j].raw());
+                    int shift = (j < History) ? history_shift : block_shift;
+                    sum += (shift >= 0) ? (product << shift)
+                                        : fixed_point::shift_right_rounded<Rounding::Nearest>(product, -shift);
+                }
+                sums[n] = sum;
+            }
+
+            // Keep the last History inputs; a block shorter than that shares the delay line
+            // with older samples, so both go to the larger exponent
+            auto tail = std::span<SampleType>(line).last(History);
+            if (input.size() >= History) {
+                buffer_exponent_ = input.exponent;
+            } else {
+                std::size_t old = History - input.size();
+                detail::block_shift_right(tail.first(old), high - buffer_exponent_);
+                detail::block_shift_right(tail.last(input.size()), high - input.exponent);
+                buffer_exponent_ = high;
+            }
+            buffer_index_ = (buffer_index_ + input.size()) % Taps;
+            for (std::size_t j = 0; j < History; ++j) buffer_[(buffer_index_ + 1 + j) % Taps] = tail[j];
+
+            return BlockFloat<SampleType>::from_wide(std::span<const Wide>(sums),
+                2 * SampleType::fractional_bits, exponent);
         }
 
         // Reset internal buffer/state
-        void reset() {
+        constexpr void reset() {
             buffer_.fill(SampleType(0));
 			buffer_index_ = 0;
+            buffer_exponent_ = 0;
         }
 
         // Get internal coefficients (helper)
-        const CoeffArray& coefficients() const {
+        constexpr const CoeffArray& coefficients() const {
             return coeffs_;
         }
 
@@ -63,6 +135,7 @@ namespace dsp {
         CoeffArray coeffs_{};
         std::array<SampleType, Taps> buffer_{};
         std::size_t buffer_index_{0};
+        int buffer_exponent_{0};  ///< shared exponent of buffer_ for block processing
     };
 
 } // namespace dsp
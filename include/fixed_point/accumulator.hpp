@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include "fixed_point.hpp"
+#include "rounding.hpp"
+
+// ----------------- Guard-Bit Accumulator -----------------
+
+// Sums exact products with GuardBits of headroom and no per-term overflow checks
+// (in a 128-bit raw value when the product plus guard bits exceed 64 bits).
+// Up to 2^GuardBits full-scale products can be added before the raw value can overflow.
+// The result is brought back to a FixedPoint format once, with narrow<Target, Rounding>().
+template<typename Product, int GuardBits = 8>
+class Accumulator {
+	static_assert(is_fixed_point_v<Product>, "Accumulator needs a FixedPoint product type");
+	static_assert(GuardBits >= 0, "Guard bits must be non-negative");
+	static_assert(Product::total_bits + GuardBits <= 128, "Accumulator does not fit in 128 bits");
+
+public:
+	using RawType = std::conditional_t<(Product::total_bits + GuardBits <= 32), int32_t,
+	                std::conditional_t<(Product::total_bits + GuardBits <= 64), int64_t, fixed_point::wide_int128>>;
+
+	static constexpr int total_bits = Product::total_bits + GuardBits;
+	static constexpr int fractional_bits = Product::fractional_bits;
+
+	constexpr Accumulator() = default;
+
+	constexpr explicit Accumulator(const Product& initial) : value_(initial.raw()) {}
+
+	// value += a * b, exactly
+	template<typename A, typename B>
+	constexpr void mac(const A& a, const B& b) {
+		static_assert(A::fractional_bits + B::fractional_bits == fractional_bits, "Product scale does not match the accumulator");
+		static_assert(A::total_bits + B::total_bits <= Product::total_bits, "Product is wider than the accumulator's product type");
+		value_ += static_cast<RawType>(a.raw()) * static_cast<RawType>(b.raw());
+	}
+
+	constexpr Accumulator& operator+=(const Product& p) {
+		value_ += p.raw();
+		return *this;
+	}
+
+	constexpr Accumulator& operator-=(const Product& p) {
+		value_ -= p.raw();
+		return *this;
+	}
+
+	constexpr void reset() {
+		value_ = 0;
+	}
+
+	constexpr RawType raw() const {
+		return value_;
+	}
+
+	// Rescale to Target's fractional bits, round, then apply Target's overflow policy once
+	template<typename Target, fixed_point::Rounding R = fixed_point::Rounding::Nearest>
+	constexpr Target narrow() const {
+		static_assert(is_fixed_point_v<Target>, "narrow() needs a FixedPoint target");
+		constexpr int shift = fractional_bits - Target::fractional_bits;
+		RawType scaled;
+		if constexpr (shift >= 0) {
+			scaled = fixed_point::shift_right_rounded<R>(value_, shift);
+		} else {
+			// Left shift: clamp first so the intermediate cannot overflow; the policy sees the direction
+			constexpr RawType raw_min = RawType(1) << (8 * sizeof(RawType) - 1);
+			constexpr RawType raw_max = ~raw_min;
+			if (value_ > (raw_max >> -shift)) scaled = raw_max;
+			else if (value_ < (raw_min >> -shift)) scaled = raw_min;
+			else scaled = value_ * (RawType(1) << -shift);
+		}
+		return Target::from_raw(Target::PolicyType::narrow(scaled));
+	}
+
+private:
+	RawType value_{ 0 };
+};
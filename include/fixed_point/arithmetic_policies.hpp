@@ -12,7 +12,7 @@ template<typename StorageType, template<typename> class Promote, int FractionalB
 struct WrapAroundPolicy {
     using Wide = typename Promote<StorageType>::type;
 
-    static StorageType add(StorageType a, StorageType b) {
+    static constexpr StorageType add(StorageType a, StorageType b) {
         Wide r = static_cast<Wide>(a) + static_cast<Wide>(b);
         constexpr auto min = std::numeric_limits<StorageType>::min();
         constexpr auto max = std::numeric_limits<StorageType>::max();
@@ -21,7 +21,7 @@ struct WrapAroundPolicy {
         return static_cast<StorageType>(r);
     }
 
-    static StorageType sub(StorageType a, StorageType b) {
+    static constexpr StorageType sub(StorageType a, StorageType b) {
         Wide r = static_cast<Wide>(a) - static_cast<Wide>(b);
         constexpr auto min = std::numeric_limits<StorageType>::min();
         constexpr auto max = std::numeric_limits<StorageType>::max();
@@ -30,7 +30,7 @@ struct WrapAroundPolicy {
         return static_cast<StorageType>(r);
     }
 
-    static StorageType mul(StorageType a, StorageType b) {
+    static constexpr StorageType mul(StorageType a, StorageType b) {
         // full-precision multiply, then shift off fractional bits
         Wide r = (static_cast<Wide>(a) * static_cast<Wide>(b)) >> FractionalBits;
         constexpr auto min = std::numeric_limits<StorageType>::min();
@@ -40,7 +40,7 @@ struct WrapAroundPolicy {
         return static_cast<StorageType>(r);
     }
 
-    static StorageType div(StorageType a, StorageType b) {
+    static constexpr StorageType div(StorageType a, StorageType b) {
         if (b == 0) throw std::runtime_error("Division by zero");
         Wide r = (static_cast<Wide>(a) << FractionalBits) / static_cast<Wide>(b);
         constexpr auto min = std::numeric_limits<StorageType>::min();
@@ -49,6 +49,16 @@ struct WrapAroundPolicy {
         if (r < min) return max;
         return static_cast<StorageType>(r);
     }
+
+    // Bring an already-scaled wide result (e.g. an accumulator) back into StorageType
+    template<typename Int>
+    static constexpr StorageType narrow(Int r) {
+        constexpr auto min = std::numeric_limits<StorageType>::min();
+        constexpr auto max = std::numeric_limits<StorageType>::max();
+        if (r > max) return min;
+        if (r < min) return max;
+        return static_cast<StorageType>(r);
+    }
 };
 
 
@@ -57,7 +67,7 @@ template<typename StorageType, template<typename> class Promote, int FractionalB
 struct SaturationPolicy {
 	using Wide = typename Promote<StorageType>::type;
 	
-	static StorageType add(StorageType a, StorageType b) {
+	static constexpr StorageType add(StorageType a, StorageType b) {
 
 		Wide result = static_cast<Wide>(a) + static_cast<Wide>(b);
 
@@ -71,7 +81,7 @@ struct SaturationPolicy {
 		return static_cast<StorageType>(result);
 	}
 
-	static StorageType sub(StorageType a, StorageType b) {
+	static constexpr StorageType sub(StorageType a, StorageType b) {
 
 		Wide result = static_cast<Wide>(a) - static_cast<Wide>(b);
 
@@ -85,7 +95,7 @@ struct SaturationPolicy {
 		return static_cast<StorageType>(result);
 	}
 
-	static StorageType mul(StorageType a, StorageType b) {
+	static constexpr StorageType mul(StorageType a, StorageType b) {
 
 		Wide result = (static_cast<Wide>(a) * static_cast<Wide>(b)) >> FractionalBits;
 
@@ -98,7 +108,7 @@ struct SaturationPolicy {
 		return static_cast<StorageType>(result);
 	}
 
-	static StorageType div(StorageType a, StorageType b) {
+	static constexpr StorageType div(StorageType a, StorageType b) {
         if (b == 0) throw std::runtime_error("Division by zero");
 
         constexpr auto min = std::numeric_limits<StorageType>::min();
@@ -115,4 +125,49 @@ struct SaturationPolicy {
         else if (result < min) return min;
         else                   return static_cast<StorageType>(result);
 	}
-};
\ No newline at end of file
+
+	// Bring an already-scaled wide result (e.g. an accumulator) back into StorageType
+	template<typename Int>
+	static constexpr StorageType narrow(Int result) {
+		if (result > std::numeric_limits<StorageType>::max()) {
+			return std::numeric_limits<StorageType>::max();
+		} else if (result < std::numeric_limits<StorageType>::min()) {
+			return std::numeric_limits<StorageType>::min();
+		}
+
+		return static_cast<StorageType>(result);
+	}
+};
+
+// No-throw division variants: x / 0 is treated as an overflow toward the sign of x
+// (so it saturates, or wraps, exactly like any other out-of-range quotient) and 0 / 0 is 0.
+// Every other operation is inherited unchanged.
+template<typename StorageType, template<typename> class Promote, int FractionalBits>
+struct WrapAroundNoThrowPolicy : WrapAroundPolicy<StorageType, Promote, FractionalBits> {
+    using Base = WrapAroundPolicy<StorageType, Promote, FractionalBits>;
+    using typename Base::Wide;
+
+    static constexpr StorageType div(StorageType a, StorageType b) {
+        if (b == 0) {
+            if (a == 0) return 0;
+            constexpr Wide beyond = static_cast<Wide>(std::numeric_limits<StorageType>::max()) + 1;
+            return Base::narrow(a > 0 ? beyond : -beyond - 1);
+        }
+        return Base::div(a, b);
+    }
+};
+
+template<typename StorageType, template<typename> class Promote, int FractionalBits>
+struct SaturationNoThrowPolicy : SaturationPolicy<StorageType, Promote, FractionalBits> {
+    using Base = SaturationPolicy<StorageType, Promote, FractionalBits>;
+    using typename Base::Wide;
+
+    static constexpr StorageType div(StorageType a, StorageType b) {
+        if (b == 0) {
+            if (a == 0) return 0;
+            constexpr Wide beyond = static_cast<Wide>(std::numeric_limits<StorageType>::max()) + 1;
+            return Base::narrow(a > 0 ? beyond : -beyond - 1);
+        }
+        return Base::div(a, b);
+    }
+};
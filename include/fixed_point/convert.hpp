@@ -0,0 +1,608 @@
+#pragma once
+
+// Silence the MSVC warning about non-floating std::complex<T>
+#ifndef _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#define _SILENCE_NONFLOATING_COMPLEX_DEPRECATION_WARNING
+#endif
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include "fixed_point.hpp"
+#include "rounding.hpp"
+#include "simd.hpp"
+
+// ----------------- Bulk float/double/PCM <-> FixedPoint conversion -----------------
+//
+// quantize() scales by 2^F, rounds with the requested mode and then applies the
+// type's overflow policy as its arithmetic does: SaturationPolicy clamps,
+// WrapAroundPolicy maps overflow to min and underflow to max (the bitwise NOT of
+// the clamped value). NaN quantizes to zero.
+// dequantize() is bit-exact with FixedPoint::to_float()/to_double().
+// float/double paths use the same SSE4.1/AVX2/AVX-512 dispatch as simd.hpp.
+
+namespace fixed_point {
+
+    namespace detail {
+
+        template<typename Fixed>
+        inline constexpr bool wraps_on_convert = simd::detail::batch_traits<Fixed>::wrap;
+
+        // Narrow an integer to S: clamped, or with Wrap overflow to min and underflow to max
+        template<bool Wrap, typename S>
+        constexpr S narrow_integer(long long v) {
+            constexpr S min = std::numeric_limits<S>::min();
+            constexpr S max = std::numeric_limits<S>::max();
+            if (v > max) return Wrap ? min : max;
+            if (v < min) return Wrap ? max : min;
+            return static_cast<S>(v);
+        }
+
+        // Scalar reference for one sample; the vector kernels reproduce it bit for bit
+        template<Rounding R, bool Wrap, typename S, typename Float>
+        inline S quantize_one(Float x, Float scale) {
+            Float v = round_float<R>(x * scale);
+            if (v != v) return 0;
+            constexpr Float lo = static_cast<Float>(std::numeric_limits<S>::min());  // -2^(bits-1), exact
+            if (v >= lo && v < -lo) return static_cast<S>(v);
+            S clamped = v > 0 ? std::numeric_limits<S>::max() : std::numeric_limits<S>::min();
+            return Wrap ? static_cast<S>(~clamped) : clamped;
+        }
+
+        template<typename Float, int F>
+        constexpr Float pow2() {
+            Float p = 1;
+            for (int i = 0; i < (F < 0 ? -F : F); ++i) p *= 2;
+            return F < 0 ? 1 / p : p;
+        }
+
+#if FIXED_POINT_SIMD_X86
+
+        // ----------------- SSE4.1 -----------------
+        namespace sse41 {
+
+            template<Rounding R>
+            FIXED_POINT_TARGET("sse4.1") inline __m128 round_ps(__m128 v) {
+                if constexpr (R == Rounding::Nearest) {
+                    __m128 t = _mm_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                    __m128 sign = _mm_and_ps(v, _mm_set1_ps(-0.0f));
+                    __m128 frac = _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_sub_ps(v, t));
+                    __m128 bump = _mm_and_ps(_mm_cmpge_ps(frac, _mm_set1_ps(0.5f)), _mm_or_ps(sign, _mm_set1_ps(1.0f)));
+                    return _mm_add_ps(t, bump);
+                }
+                else if constexpr (R == Rounding::NearestEven) return _mm_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                else if constexpr (R == Rounding::TowardZero) return _mm_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                else return _mm_round_ps(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            }
+
+            template<Rounding R>
+            FIXED_POINT_TARGET("sse4.1") inline __m128d round_pd(__m128d v) {
+                if constexpr (R == Rounding::Nearest) {
+                    __m128d t = _mm_round_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                    __m128d sign = _mm_and_pd(v, _mm_set1_pd(-0.0));
+                    __m128d frac = _mm_andnot_pd(_mm_set1_pd(-0.0), _mm_sub_pd(v, t));
+                    __m128d bump = _mm_and_pd(_mm_cmpge_pd(frac, _mm_set1_pd(0.5)), _mm_or_pd(sign, _mm_set1_pd(1.0)));
+                    return _mm_add_pd(t, bump);
+                }
+                else if constexpr (R == Rounding::NearestEven) return _mm_round_pd(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                else if constexpr (R == Rounding::TowardZero) return _mm_round_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                else return _mm_round_pd(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            }
+
+            // Store 4 int32 lanes as S, saturating
+            template<typename S>
+            FIXED_POINT_TARGET("sse4.1") inline void store4(S* out, __m128i q) {
+                if constexpr (sizeof(S) == 4) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), q);
+                } else {
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packs_epi32(q, q));
+                }
+            }
+
+            // Lanes of v outside S's range, as an all-ones mask: the ones WrapAroundPolicy
+            // flips from the clamped value to the other end
+            template<typename S>
+            FIXED_POINT_TARGET("sse4.1") inline __m128 out_of_range_ps(__m128 v) {
+                const __m128 lo = _mm_set1_ps(static_cast<float>(std::numeric_limits<S>::min()));
+                return _mm_or_ps(_mm_cmplt_ps(v, lo), _mm_cmpge_ps(v, _mm_sub_ps(_mm_setzero_ps(), lo)));
+            }
+
+            template<typename S>
+            FIXED_POINT_TARGET("sse4.1") inline __m128d out_of_range_pd(__m128d v) {
+                const __m128d lo = _mm_set1_pd(static_cast<double>(std::numeric_limits<S>::min()));
+                return _mm_or_pd(_mm_cmplt_pd(v, lo), _mm_cmpge_pd(v, _mm_sub_pd(_mm_setzero_pd(), lo)));
+            }
+
+            template<Rounding R, bool Wrap, typename S>
+            FIXED_POINT_TARGET("sse4.1")
+            std::size_t quantize(const float* in, S* out, std::size_t n, float scale) {
+                const __m128 vscale = _mm_set1_ps(scale);
+                const __m128 lim = _mm_set1_ps(2147483648.0f);
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    __m128 v = round_ps<R>(_mm_mul_ps(_mm_loadu_ps(in + i), vscale));
+                    v = _mm_and_ps(v, _mm_cmpord_ps(v, v));
+                    __m128i q;
+                    if constexpr (sizeof(S) == 2) {
+                        q = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-32768.0f)), _mm_set1_ps(32767.0f)));
+                    } else {
+                        q = _mm_blendv_epi8(_mm_cvtps_epi32(v), _mm_set1_epi32(INT32_MAX),
+                                            _mm_castps_si128(_mm_cmpge_ps(v, lim)));
+                    }
+                    if constexpr (Wrap) q = _mm_xor_si128(q, _mm_castps_si128(out_of_range_ps<S>(v)));
+                    store4(out + i, q);
+                }
+                return i;
+            }
+
+            template<Rounding R, bool Wrap, typename S>
+            FIXED_POINT_TARGET("sse4.1")
+            std::size_t quantize(const double* in, S* out, std::size_t n, double scale) {
+                const __m128d vscale = _mm_set1_pd(scale);
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    __m128d v0 = round_pd<R>(_mm_mul_pd(_mm_loadu_pd(in + i), vscale));
+                    __m128d v1 = round_pd<R>(_mm_mul_pd(_mm_loadu_pd(in + i + 2), vscale));
+                    v0 = _mm_and_pd(v0, _mm_cmpord_pd(v0, v0));
+                    v1 = _mm_and_pd(v1, _mm_cmpord_pd(v1, v1));
+                    // Low halves of the 64-bit masks, in the order of the packed int32 lanes
+                    __m128i wrap = Wrap ? _mm_castps_si128(_mm_shuffle_ps(_mm_castpd_ps(out_of_range_pd<S>(v0)),
+                                                                          _mm_castpd_ps(out_of_range_pd<S>(v1)),
+                                                                          _MM_SHUFFLE(2, 0, 2, 0)))
+                                        : _mm_setzero_si128();
+                    __m128d lo = _mm_set1_pd(double(std::numeric_limits<S>::min()));
+                    __m128d hi = _mm_set1_pd(double(std::numeric_limits<S>::max()));
+                    v0 = _mm_min_pd(_mm_max_pd(v0, lo), hi);
+                    v1 = _mm_min_pd(_mm_max_pd(v1, lo), hi);
+                    __m128i q = _mm_unpacklo_epi64(_mm_cvtpd_epi32(v0), _mm_cvtpd_epi32(v1));
+                    store4(out + i, _mm_xor_si128(q, wrap));
+                }
+                return i;
+            }
+
+            template<typename S>
+            FIXED_POINT_TARGET("sse4.1") inline __m128i load4(const S* in) {
+                if constexpr (sizeof(S) == 4) return _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                else return _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in)));
+            }
+
+            template<typename S>
+            FIXED_POINT_TARGET("sse4.1")
+            std::size_t dequantize(const S* in, float* out, std::size_t n, float inv_scale) {
+                const __m128 vinv = _mm_set1_ps(inv_scale);
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(load4(in + i)), vinv));
+                }
+                return i;
+            }
+
+            template<typename S>
+            FIXED_POINT_TARGET("sse4.1")
+            std::size_t dequantize(const S* in, double* out, std::size_t n, double inv_scale) {
+                const __m128d vinv = _mm_set1_pd(inv_scale);
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    __m128i q = load4(in + i);
+                    _mm_storeu_pd(out + i, _mm_mul_pd(_mm_cvtepi32_pd(q), vinv));
+                    _mm_storeu_pd(out + i + 2, _mm_mul_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(q, q)), vinv));
+                }
+                return i;
+            }
+
+        } // namespace sse41
+
+        // ----------------- AVX2 -----------------
+        namespace avx2 {
+
+            template<Rounding R>
+            FIXED_POINT_TARGET("avx2") inline __m256 round_ps(__m256 v) {
+                if constexpr (R == Rounding::Nearest) {
+                    __m256 t = _mm256_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                    __m256 sign = _mm256_and_ps(v, _mm256_set1_ps(-0.0f));
+                    __m256 frac = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), _mm256_sub_ps(v, t));
+                    __m256 bump = _mm256_and_ps(_mm256_cmp_ps(frac, _mm256_set1_ps(0.5f), _CMP_GE_OQ),
+                                                _mm256_or_ps(sign, _mm256_set1_ps(1.0f)));
+                    return _mm256_add_ps(t, bump);
+                }
+                else if constexpr (R == Rounding::NearestEven) return _mm256_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                else if constexpr (R == Rounding::TowardZero) return _mm256_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                else return _mm256_round_ps(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            }
+
+            template<Rounding R>
+            FIXED_POINT_TARGET("avx2") inline __m256d round_pd(__m256d v) {
+                if constexpr (R == Rounding::Nearest) {
+                    __m256d t = _mm256_round_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                    __m256d sign = _mm256_and_pd(v, _mm256_set1_pd(-0.0));
+                    __m256d frac = _mm256_andnot_pd(_mm256_set1_pd(-0.0), _mm256_sub_pd(v, t));
+                    __m256d bump = _mm256_and_pd(_mm256_cmp_pd(frac, _mm256_set1_pd(0.5), _CMP_GE_OQ),
+                                                 _mm256_or_pd(sign, _mm256_set1_pd(1.0)));
+                    return _mm256_add_pd(t, bump);
+                }
+                else if constexpr (R == Rounding::NearestEven) return _mm256_round_pd(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                else if constexpr (R == Rounding::TowardZero) return _mm256_round_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                else return _mm256_round_pd(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            }
+
+            template<typename S>
+            FIXED_POINT_TARGET("avx2") inline void store8(S* out, __m256i q) {
+                if constexpr (sizeof(S) == 4) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), q);
+                } else {
+                    __m256i packed = _mm256_packs_epi32(q, q);
+                    packed = _mm256_permute4x64_epi64(packed, 0x08);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(packed));
+                }
+            }
+
+            template<Rounding R, bool Wrap, typename S>
+            FIXED_POINT_TARGET("avx2")
+            std::size_t quantize(const float* in, S* out, std::size_t n, float scale) {
+                const __m256 vscale = _mm256_set1_ps(scale);
+                const __m256 lim = _mm256_set1_ps(2147483648.0f);
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    __m256 v = round_ps<R>(_mm256_mul_ps(_mm256_loadu_ps(in + i), vscale));
+                    v = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+                    __m256i q;
+                    if constexpr (sizeof(S) == 2) {
+                        q = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(-32768.0f)),
+                                                             _mm256_set1_ps(32767.0f)));
+                    } else {
+                        q = _mm256_blendv_epi8(_mm256_cvtps_epi32(v), _mm256_set1_epi32(INT32_MAX),
+                                               _mm256_castps_si256(_mm256_cmp_ps(v, lim, _CMP_GE_OQ)));
+                    }
+                    if constexpr (Wrap) {
+                        const __m256 lo = _mm256_set1_ps(static_cast<float>(std::numeric_limits<S>::min()));
+                        __m256 outside = _mm256_or_ps(_mm256_cmp_ps(v, lo, _CMP_LT_OQ),
+                                                      _mm256_cmp_ps(v, _mm256_sub_ps(_mm256_setzero_ps(), lo), _CMP_GE_OQ));
+                        q = _mm256_xor_si256(q, _mm256_castps_si256(outside));
+                    }
+                    store8(out + i, q);
+                }
+                return i;
+            }
+
+            template<Rounding R, bool Wrap, typename S>
+            FIXED_POINT_TARGET("avx2")
+            std::size_t quantize(const double* in, S* out, std::size_t n, double scale) {
+                const __m256d vscale = _mm256_set1_pd(scale);
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    __m256d v = round_pd<R>(_mm256_mul_pd(_mm256_loadu_pd(in + i), vscale));
+                    v = _mm256_and_pd(v, _mm256_cmp_pd(v, v, _CMP_ORD_Q));
+                    __m128i wrap = _mm_setzero_si128();
+                    if constexpr (Wrap) {
+                        const __m256d lo = _mm256_set1_pd(static_cast<double>(std::numeric_limits<S>::min()));
+                        __m256d outside = _mm256_or_pd(_mm256_cmp_pd(v, lo, _CMP_LT_OQ),
+                                                       _mm256_cmp_pd(v, _mm256_sub_pd(_mm256_setzero_pd(), lo), _CMP_GE_OQ));
+                        // Low halves of the 64-bit masks, in the order of the packed int32 lanes
+                        wrap = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(outside),
+                                                                                  _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+                    }
+                    v = _mm256_min_pd(_mm256_max_pd(v, _mm256_set1_pd(double(std::numeric_limits<S>::min()))),
+                                      _mm256_set1_pd(double(std::numeric_limits<S>::max())));
+                    sse41::store4(out + i, _mm_xor_si128(_mm256_cvtpd_epi32(v), wrap));
+                }
+                return i;
+            }
+
+            template<typename S>
+            FIXED_POINT_TARGET("avx2") inline __m256i load8(const S* in) {
+                if constexpr (sizeof(S) == 4) return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+                else return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+            }
+
+            template<typename S>
+            FIXED_POINT_TARGET("avx2")
+            std::size_t dequantize(const S* in, float* out, std::size_t n, float inv_scale) {
+                const __m256 vinv = _mm256_set1_ps(inv_scale);
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(load8(in + i)), vinv));
+                }
+                return i;
+            }
+
+            template<typename S>
+            FIXED_POINT_TARGET("avx2")
+            std::size_t dequantize(const S* in, double* out, std::size_t n, double inv_scale) {
+                const __m256d vinv = _mm256_set1_pd(inv_scale);
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_cvtepi32_pd(sse41::load4(in + i)), vinv));
+                }
+                return i;
+            }
+
+        } // namespace avx2
+
+        // ----------------- AVX-512 -----------------
+        namespace avx512 {
+
+            template<Rounding R>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline __m512 round_ps(__m512 v) {
+                if constexpr (R == Rounding::Nearest) {
+                    __m512 t = _mm512_roundscale_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                    __m512 frac = _mm512_abs_ps(_mm512_sub_ps(v, t));
+                    __mmask16 bump = _mm512_cmp_ps_mask(frac, _mm512_set1_ps(0.5f), _CMP_GE_OQ);
+                    __m512 one = _mm512_castsi512_ps(_mm512_or_si512(
+                        _mm512_and_si512(_mm512_castps_si512(v), _mm512_set1_epi32(INT32_MIN)),
+                        _mm512_castps_si512(_mm512_set1_ps(1.0f))));
+                    return _mm512_mask_add_ps(t, bump, t, one);
+                }
+                else if constexpr (R == Rounding::NearestEven) return _mm512_roundscale_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                else if constexpr (R == Rounding::TowardZero) return _mm512_roundscale_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                else return _mm512_roundscale_ps(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            }
+
+            template<Rounding R>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline __m512d round_pd(__m512d v) {
+                if constexpr (R == Rounding::Nearest) {
+                    __m512d t = _mm512_roundscale_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                    __m512d frac = _mm512_abs_pd(_mm512_sub_pd(v, t));
+                    __mmask8 bump = _mm512_cmp_pd_mask(frac, _mm512_set1_pd(0.5), _CMP_GE_OQ);
+                    __m512d one = _mm512_castsi512_pd(_mm512_or_si512(
+                        _mm512_and_si512(_mm512_castpd_si512(v), _mm512_set1_epi64(INT64_MIN)),
+                        _mm512_castpd_si512(_mm512_set1_pd(1.0))));
+                    return _mm512_mask_add_pd(t, bump, t, one);
+                }
+                else if constexpr (R == Rounding::NearestEven) return _mm512_roundscale_pd(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                else if constexpr (R == Rounding::TowardZero) return _mm512_roundscale_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                else return _mm512_roundscale_pd(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            }
+
+            template<typename S>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline void store16(S* out, __m512i q) {
+                if constexpr (sizeof(S) == 4) {
+                    _mm512_storeu_si512(out, q);
+                } else {
+                    __m256i packed = _mm512_cvtsepi32_epi16(q);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), packed);
+                }
+            }
+
+            template<Rounding R, bool Wrap, typename S>
+            FIXED_POINT_TARGET("avx512f,avx512bw")
+            std::size_t quantize(const float* in, S* out, std::size_t n, float scale) {
+                const __m512 vscale = _mm512_set1_ps(scale);
+                const __m512 lim = _mm512_set1_ps(2147483648.0f);
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    __m512 v = round_ps<R>(_mm512_mul_ps(_mm512_loadu_ps(in + i), vscale));
+                    v = _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(v, v, _CMP_ORD_Q), v);
+                    __m512i q = _mm512_mask_mov_epi32(_mm512_cvtps_epi32(v), _mm512_cmp_ps_mask(v, lim, _CMP_GE_OQ),
+                                                      _mm512_set1_epi32(INT32_MAX));
+                    if constexpr (Wrap) {
+                        // The int32 lanes are still unsaturated for 16-bit S: ~v lands beyond the other end
+                        const __m512 lo = _mm512_set1_ps(static_cast<float>(std::numeric_limits<S>::min()));
+                        __mmask16 outside = _mm512_cmp_ps_mask(v, lo, _CMP_LT_OQ)
+                                          | _mm512_cmp_ps_mask(v, _mm512_sub_ps(_mm512_setzero_ps(), lo), _CMP_GE_OQ);
+                        q = _mm512_mask_xor_epi32(q, outside, q, _mm512_set1_epi32(-1));
+                    }
+                    store16(out + i, q);
+                }
+                return i;
+            }
+
+            template<Rounding R, bool Wrap, typename S>
+            FIXED_POINT_TARGET("avx512f,avx512bw")
+            std::size_t quantize(const double* in, S* out, std::size_t n, double scale) {
+                const __m512d vscale = _mm512_set1_pd(scale);
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    __m512d v = round_pd<R>(_mm512_mul_pd(_mm512_loadu_pd(in + i), vscale));
+                    v = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(v, v, _CMP_ORD_Q), v);
+                    __mmask8 outside = 0;
+                    if constexpr (Wrap) {
+                        const __m512d lo = _mm512_set1_pd(static_cast<double>(std::numeric_limits<S>::min()));
+                        outside = _mm512_cmp_pd_mask(v, lo, _CMP_LT_OQ)
+                                | _mm512_cmp_pd_mask(v, _mm512_sub_pd(_mm512_setzero_pd(), lo), _CMP_GE_OQ);
+                    }
+                    v = _mm512_min_pd(_mm512_max_pd(v, _mm512_set1_pd(double(std::numeric_limits<S>::min()))),
+                                      _mm512_set1_pd(double(std::numeric_limits<S>::max())));
+                    __m256i wrap = _mm512_cvtepi64_epi32(_mm512_maskz_mov_epi64(outside, _mm512_set1_epi64(-1)));
+                    avx2::store8(out + i, _mm256_xor_si256(_mm512_cvtpd_epi32(v), wrap));
+                }
+                return i;
+            }
+
+            template<typename S>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline __m512i load16(const S* in) {
+                if constexpr (sizeof(S) == 4) return _mm512_loadu_si512(in);
+                else return _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)));
+            }
+
+            template<typename S>
+            FIXED_POINT_TARGET("avx512f,avx512bw")
+            std::size_t dequantize(const S* in, float* out, std::size_t n, float inv_scale) {
+                const __m512 vinv = _mm512_set1_ps(inv_scale);
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_cvtepi32_ps(load16(in + i)), vinv));
+                }
+                return i;
+            }
+
+            template<typename S>
+            FIXED_POINT_TARGET("avx512f,avx512bw")
+            std::size_t dequantize(const S* in, double* out, std::size_t n, double inv_scale) {
+                const __m512d vinv = _mm512_set1_pd(inv_scale);
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    _mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_cvtepi32_pd(avx2::load8(in + i)), vinv));
+                }
+                return i;
+            }
+
+        } // namespace avx512
+
+#endif // FIXED_POINT_SIMD_X86
+
+        template<Rounding R, typename Fixed, typename Float>
+        void quantize_impl(const Float* in, Fixed* out, std::size_t n) {
+            using S = typename Fixed::StorageType;
+            constexpr bool Wrap = wraps_on_convert<Fixed>;
+            constexpr Float scale = pow2<Float, Fixed::fractional_bits>();
+            auto raw = reinterpret_cast<S*>(out);
+            std::size_t done = 0;
+#if FIXED_POINT_SIMD_X86
+            if constexpr (sizeof(S) == 2 || sizeof(S) == 4) {
+                switch (simd::active_level()) {
+                    case simd::SimdLevel::AVX512: done = avx512::quantize<R, Wrap>(in, raw, n, scale); break;
+                    case simd::SimdLevel::AVX2:   done = avx2::quantize<R, Wrap>(in, raw, n, scale);   break;
+                    case simd::SimdLevel::SSE41:  done = sse41::quantize<R, Wrap>(in, raw, n, scale);  break;
+                    default: break;
+                }
+            }
+#endif
+            for (std::size_t i = done; i < n; ++i) raw[i] = quantize_one<R, Wrap, S>(in[i], scale);
+        }
+
+        template<typename Fixed, typename Float>
+        void dequantize_impl(const Fixed* in, Float* out, std::size_t n) {
+            using S = typename Fixed::StorageType;
+            constexpr Float inv_scale = pow2<Float, -Fixed::fractional_bits>();
+            auto raw = reinterpret_cast<const S*>(in);
+            std::size_t done = 0;
+#if FIXED_POINT_SIMD_X86
+            if constexpr (sizeof(S) == 2 || sizeof(S) == 4) {
+                switch (simd::active_level()) {
+                    case simd::SimdLevel::AVX512: done = avx512::dequantize(raw, out, n, inv_scale); break;
+                    case simd::SimdLevel::AVX2:   done = avx2::dequantize(raw, out, n, inv_scale);   break;
+                    case simd::SimdLevel::SSE41:  done = sse41::dequantize(raw, out, n, inv_scale);  break;
+                    default: break;
+                }
+            }
+#endif
+            for (std::size_t i = done; i < n; ++i) out[i] = static_cast<Float>(raw[i]) * inv_scale;
+        }
+
+        template<typename Fixed, typename Float>
+        void quantize_dispatch(const Float* in, Fixed* out, std::size_t n, Rounding rounding) {
+            static_assert(sizeof(Fixed) == sizeof(typename Fixed::StorageType), "FixedPoint must be layout-compatible with its storage");
+            switch (rounding) {
+                case Rounding::Nearest:     quantize_impl<Rounding::Nearest>(in, out, n);     break;
+                case Rounding::NearestEven: quantize_impl<Rounding::NearestEven>(in, out, n); break;
+                case Rounding::TowardZero:  quantize_impl<Rounding::TowardZero>(in, out, n);  break;
+                case Rounding::Floor:       quantize_impl<Rounding::Floor>(in, out, n);       break;
+            }
+        }
+
+        // Q15 <-> Q(F): a rounded right shift or an exact left shift, then the overflow policy
+        template<Rounding R, bool Wrap, typename S>
+        constexpr S requantize_one(long long raw, int from_frac, int to_frac) {
+            long long v = (to_frac >= from_frac)
+                ? raw * (1LL << (to_frac - from_frac))
+                : shift_right_rounded<R>(raw, from_frac - to_frac);
+            return narrow_integer<Wrap, S>(v);
+        }
+
+        template<Rounding R, bool Wrap, typename From, typename To>
+        void requantize_block(const From* in, To* out, std::size_t n, int from_frac, int to_frac) {
+            for (std::size_t i = 0; i < n; ++i) out[i] = requantize_one<R, Wrap, To>(in[i], from_frac, to_frac);
+        }
+
+        template<bool Wrap, typename From, typename To>
+        void requantize_dispatch(const From* in, To* out, std::size_t n, int from_frac, int to_frac, Rounding rounding) {
+            switch (rounding) {
+                case Rounding::Nearest:     requantize_block<Rounding::Nearest, Wrap>(in, out, n, from_frac, to_frac);     break;
+                case Rounding::NearestEven: requantize_block<Rounding::NearestEven, Wrap>(in, out, n, from_frac, to_frac); break;
+                case Rounding::TowardZero:  requantize_block<Rounding::TowardZero, Wrap>(in, out, n, from_frac, to_frac);  break;
+                case Rounding::Floor:       requantize_block<Rounding::Floor, Wrap>(in, out, n, from_frac, to_frac);       break;
+            }
+        }
+
+        inline void check_sizes(std::size_t in, std::size_t out) {
+            if (in != out) {
+                throw std::invalid_argument("Input and output buffers must have the same size");
+            }
+        }
+
+    } // namespace detail
+
+    // -----------------Real buffers-----------------
+
+    template<typename Fixed>
+    void quantize(std::span<const float> in, std::span<Fixed> out, Rounding rounding = Rounding::Nearest) {
+        detail::check_sizes(in.size(), out.size());
+        detail::quantize_dispatch(in.data(), out.data(), out.size(), rounding);
+    }
+
+    template<typename Fixed>
+    void quantize(std::span<const double> in, std::span<Fixed> out, Rounding rounding = Rounding::Nearest) {
+        detail::check_sizes(in.size(), out.size());
+        detail::quantize_dispatch(in.data(), out.data(), out.size(), rounding);
+    }
+
+    template<typename Fixed>
+    void dequantize(std::span<const Fixed> in, std::span<float> out) {
+        detail::check_sizes(in.size(), out.size());
+        detail::dequantize_impl(in.data(), out.data(), out.size());
+    }
+
+    template<typename Fixed>
+    void dequantize(std::span<const Fixed> in, std::span<double> out) {
+        detail::check_sizes(in.size(), out.size());
+        detail::dequantize_impl(in.data(), out.data(), out.size());
+    }
+
+    // -----------------Interleaved complex buffers ({re, im} pairs)-----------------
+
+    template<typename Fixed>
+    void quantize(std::span<const std::complex<float>> in, std::span<std::complex<Fixed>> out,
+                  Rounding rounding = Rounding::Nearest) {
+        static_assert(sizeof(std::complex<Fixed>) == 2 * sizeof(Fixed), "complex<Fixed> must be {re, im}");
+        detail::check_sizes(in.size(), out.size());
+        detail::quantize_dispatch(reinterpret_cast<const float*>(in.data()),
+                                  reinterpret_cast<Fixed*>(out.data()), 2 * out.size(), rounding);
+    }
+
+    template<typename Fixed>
+    void quantize(std::span<const std::complex<double>> in, std::span<std::complex<Fixed>> out,
+                  Rounding rounding = Rounding::Nearest) {
+        static_assert(sizeof(std::complex<Fixed>) == 2 * sizeof(Fixed), "complex<Fixed> must be {re, im}");
+        detail::check_sizes(in.size(), out.size());
+        detail::quantize_dispatch(reinterpret_cast<const double*>(in.data()),
+                                  reinterpret_cast<Fixed*>(out.data()), 2 * out.size(), rounding);
+    }
+
+    template<typename Fixed>
+    void dequantize(std::span<const std::complex<Fixed>> in, std::span<std::complex<float>> out) {
+        static_assert(sizeof(std::complex<Fixed>) == 2 * sizeof(Fixed), "complex<Fixed> must be {re, im}");
+        detail::check_sizes(in.size(), out.size());
+        detail::dequantize_impl(reinterpret_cast<const Fixed*>(in.data()),
+                                reinterpret_cast<float*>(out.data()), 2 * out.size());
+    }
+
+    template<typename Fixed>
+    void dequantize(std::span<const std::complex<Fixed>> in, std::span<std::complex<double>> out) {
+        static_assert(sizeof(std::complex<Fixed>) == 2 * sizeof(Fixed), "complex<Fixed> must be {re, im}");
+        detail::check_sizes(in.size(), out.size());
+        detail::dequantize_impl(reinterpret_cast<const Fixed*>(in.data()),
+                                reinterpret_cast<double*>(out.data()), 2 * out.size());
+    }
+
+    // -----------------Raw int16 PCM (Q15, full scale = +-1.0)-----------------
+
+    template<typename Fixed>
+    void quantize_pcm16(std::span<const int16_t> pcm, std::span<Fixed> out, Rounding rounding = Rounding::Nearest) {
+        using S = typename Fixed::StorageType;
+        detail::check_sizes(pcm.size(), out.size());
+        detail::requantize_dispatch<detail::wraps_on_convert<Fixed>>(
+            pcm.data(), reinterpret_cast<S*>(out.data()), out.size(), 15, Fixed::fractional_bits, rounding);
+    }
+
+    template<typename Fixed>
+    void dequantize_pcm16(std::span<const Fixed> in, std::span<int16_t> pcm, Rounding rounding = Rounding::Nearest) {
+        using S = typename Fixed::StorageType;
+        detail::check_sizes(in.size(), pcm.size());
+        detail::requantize_dispatch<detail::wraps_on_convert<Fixed>>(
+            reinterpret_cast<const S*>(in.data()), pcm.data(), pcm.size(), Fixed::fractional_bits, 15, rounding);
+    }
+
+} // namespace fixed_point
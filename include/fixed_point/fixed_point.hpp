@@ -6,12 +6,14 @@
 #include <cmath>
 #include <stdexcept>
 #include "arithmetic_policies.hpp"
+#include "rounding.hpp"
 
 
 // ----------------- Fixed Point Class Template -----------------
 template<int TotalBits, int FractionalBits, template<typename, template<typename> class, int> class OverFlowPolicy = WrapAroundPolicy>
 class FixedPoint {
 	static_assert(TotalBits > 0, "Total bits must be positive");
+	static_assert(TotalBits <= 64, "Total bits must fit in 64-bit storage");
 	static_assert(FractionalBits >= 0 && FractionalBits < TotalBits, "Fractional bits must be valid");
 
 private:
@@ -32,21 +34,47 @@ private:
 
 public:
     using StorageType = decltype(select_storage_type());
+    using PolicyType = OverFlowPolicy<StorageType, Promote, FractionalBits>;
+
+    static constexpr int total_bits = TotalBits;
+    static constexpr int fractional_bits = FractionalBits;
+
+    // Same overflow policy, different format (used by the widening product types)
+    template<int OtherTotalBits, int OtherFractionalBits>
+    using Rebind = FixedPoint<OtherTotalBits, OtherFractionalBits, OverFlowPolicy>;
 
 private:
     StorageType value;
-    using Policy = OverFlowPolicy<StorageType, Promote, FractionalBits>;
+    using Policy = PolicyType;
+
+	// 2^FractionalBits as a floating-point value (an int shift overflows for 64-bit formats)
+	template<typename Float>
+	static constexpr Float scale() {
+		return static_cast<Float>(uint64_t(1) << FractionalBits);
+	}
+
+	// Round half away from zero, like std::round, but usable in constant expressions
+	template<typename Float>
+	static constexpr StorageType round_to_storage(Float scaled) {
+		if consteval {
+			auto truncated = static_cast<long long>(scaled);
+			Float remainder = scaled - static_cast<Float>(truncated);
+			if (remainder >= Float(0.5)) ++truncated;
+			else if (remainder <= Float(-0.5)) --truncated;
+			return static_cast<StorageType>(truncated);
+		} else {
+			return static_cast<StorageType>(std::round(scaled));
+		}
+	}
 
 public:
 	// -----------------Constructors-----------------
 	
 	// Default constructor initializes to zero
-	FixedPoint() {
-		value = 0;
-	}
+	constexpr FixedPoint() : value(0) {}
 	
 	// Constructor from integer
-	FixedPoint(int integer) {
+	constexpr FixedPoint(int integer) : value(0) {
 		if constexpr (FractionalBits == 0) {
 			value = static_cast<StorageType>(integer);
 		} else {
@@ -56,17 +84,13 @@ public:
 	}
 
 	// Constructor from floating-point number
-	FixedPoint(float number) {
-		value = static_cast<StorageType>(std::round(number * (1 << FractionalBits)));
-	}
+	constexpr FixedPoint(float number) : value(round_to_storage(number * scale<float>())) {}
 
 	// Constructor from double
-	FixedPoint(double number) {
-		value = static_cast<StorageType>(std::round(number * (1 << FractionalBits)));
-	}
+	constexpr FixedPoint(double number) : value(round_to_storage(number * scale<double>())) {}
 
 	// Constructor from raw storage type
-	static FixedPoint from_raw(StorageType v) {
+	static constexpr FixedPoint from_raw(StorageType v) {
 		FixedPoint fp;
 		fp.value = v;
 		return fp;
@@ -75,7 +99,7 @@ public:
 	// ------------------Conversion Operators-----------------
 
 	// Conversion to integer
-	int to_int() const {
+	constexpr int to_int() const {
 		if constexpr (FractionalBits == 0) {
 			return static_cast<int>(value);
 		} else {
@@ -84,102 +108,116 @@ public:
 	}
 
 	// Conversion to floating-point number
-	float to_float() const {
-		return static_cast<float>(value) / (1 << FractionalBits);
+	constexpr float to_float() const {
+		return static_cast<float>(value) / scale<float>();
 	}
 
 	// Conversion to double
-	double to_double() const {
-		return static_cast<double>(value) / (1 << FractionalBits);
+	constexpr double to_double() const {
+		return static_cast<double>(value) / scale<double>();
 	}
 
-	StorageType raw() const {
+	constexpr StorageType raw() const {
 		return value;
 	}
 
 	// -----------------Arithmetic Operators-----------------
 
 	// Unary minus operator
-	FixedPoint operator-() const {
+	constexpr FixedPoint operator-() const {
 		FixedPoint zero{ 0 };
 		return zero - *this;
 	}
 
 	// Addition, subtraction, multiplication, and division
-	FixedPoint operator+(const FixedPoint& other) const {
+	constexpr FixedPoint operator+(const FixedPoint& other) const {
 		FixedPoint result;
 		result.value = Policy::add(this->value, other.value);
 		return result;
 	}
 
-	FixedPoint operator-(const FixedPoint& other) const {
+	constexpr FixedPoint operator-(const FixedPoint& other) const {
 		FixedPoint result;
 		result.value = Policy::sub(this->value, other.value);
 		return result;
 	}
 
-	FixedPoint operator*(const FixedPoint& other) const {
+	constexpr FixedPoint operator*(const FixedPoint& other) const {
 		FixedPoint result;
 		result.value = Policy::mul(this->value, other.value);
 		return result;
 	}
 
-	FixedPoint operator/(const FixedPoint& other) const {
-		if (other.value == 0) {
-			throw std::runtime_error("Division by zero, NAN");
-		}
+	// Division by zero is left to the policy (the default policies throw std::runtime_error)
+	constexpr FixedPoint operator/(const FixedPoint& other) const {
 		FixedPoint result;
 		result.value = Policy::div(this->value, other.value);
 		return result;
 	}
 
 	// Compound assignment operators
-	FixedPoint& operator+=(const FixedPoint& other) {
+	constexpr FixedPoint& operator+=(const FixedPoint& other) {
 		value = Policy::add(value, other.value);
 		return *this;
 	}
 
-	FixedPoint& operator-=(const FixedPoint& other) {
+	constexpr FixedPoint& operator-=(const FixedPoint& other) {
 		value = Policy::sub(value, other.value);
 		return *this;
 	}
 
-	FixedPoint& operator*=(const FixedPoint& other) {
+	constexpr FixedPoint& operator*=(const FixedPoint& other) {
 		value = Policy::mul(value, other.value);
 		return *this;
 	}
 
-	FixedPoint& operator/=(const FixedPoint& other) {
-		if (other.value == 0) {
-			throw std::runtime_error("Division by zero, NAN");
-		}
+	constexpr FixedPoint& operator/=(const FixedPoint& other) {
 		value = Policy::div(value, other.value);
 		return *this;
 	}
 
+	// -----------------Power-of-Two Scaling-----------------
+
+	// *this * 2^exponent as a shift instead of a multiply or divide.
+	// Left shifts overflow through the policy; right shifts round with R (Floor matches operator*).
+	template<fixed_point::Rounding R = fixed_point::Rounding::Floor>
+	constexpr FixedPoint scale_pow2(int exponent) const {
+		using Wide = typename Policy::Wide;
+		// Wide has twice the storage bits, so clamping the shift to TotalBits loses nothing
+		constexpr int limit = static_cast<int>(sizeof(StorageType) * 8);
+		FixedPoint result;
+		if (exponent >= 0) {
+			result.value = Policy::narrow(static_cast<Wide>(value) << std::min(exponent, limit));
+		} else {
+			result.value = static_cast<StorageType>(
+				fixed_point::shift_right_rounded<R>(static_cast<Wide>(value), std::min(-exponent, limit)));
+		}
+		return result;
+	}
+
 	// -----------------Comparison Operators-----------------
 
-	bool operator==(const FixedPoint& other) const {
+	constexpr bool operator==(const FixedPoint& other) const {
 		return this->value == other.value;
 	}
 
-	bool operator!=(const FixedPoint& other) const {
+	constexpr bool operator!=(const FixedPoint& other) const {
 		return !(*this == other);
 	}
 
-	bool operator<(const FixedPoint& other) const {
+	constexpr bool operator<(const FixedPoint& other) const {
 		return this->value < other.value;
 	}
 
-	bool operator<=(const FixedPoint& other) const {
+	constexpr bool operator<=(const FixedPoint& other) const {
 		return this->value <= other.value;
 	}
 
-	bool operator>(const FixedPoint& other) const {
+	constexpr bool operator>(const FixedPoint& other) const {
 		return this->value > other.value;
 	}
 
-	bool operator>=(const FixedPoint& other) const {
+	constexpr bool operator>=(const FixedPoint& other) const {
 		return this->value >= other.value;
 	}
 
@@ -189,3 +227,47 @@ public:
 		return os << fp.to_float();
 	}
 };
+
+// ----------------- Type Traits -----------------
+template<typename T>
+struct is_fixed_point : std::false_type {};
+
+template<int TotalBits, int FractionalBits, template<typename, template<typename> class, int> class OverFlowPolicy>
+struct is_fixed_point<FixedPoint<TotalBits, FractionalBits, OverFlowPolicy>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool is_fixed_point_v = is_fixed_point<T>::value;
+
+// ----------------- Power-of-Two Helpers -----------------
+
+// std::ldexp counterpart, so generic code can write `using std::ldexp; ldexp(x, -k)`
+template<int TotalBits, int FractionalBits, template<typename, template<typename> class, int> class OverFlowPolicy>
+constexpr FixedPoint<TotalBits, FractionalBits, OverFlowPolicy>
+	ldexp(const FixedPoint<TotalBits, FractionalBits, OverFlowPolicy>& x, int exponent) {
+	return x.scale_pow2(exponent);
+}
+
+// ----------------- Widening Multiply -----------------
+
+// Exact product format: total and fractional bits add, overflow policy of the left operand
+template<typename A, typename B>
+using ProductType = typename A::template Rebind<A::total_bits + B::total_bits, A::fractional_bits + B::fractional_bits>;
+
+// Full-precision product, no shift and no overflow handling
+template<typename A, typename B>
+constexpr ProductType<A, B> widening_mul(const A& a, const B& b) {
+	static_assert(is_fixed_point_v<A> && is_fixed_point_v<B>, "widening_mul needs FixedPoint operands");
+	static_assert(A::total_bits + B::total_bits <= 64, "Product does not fit in 64 bits");
+	using Product = ProductType<A, B>;
+	using Wide = typename Product::StorageType;
+	return Product::from_raw(static_cast<Wide>(static_cast<Wide>(a.raw()) * static_cast<Wide>(b.raw())));
+}
+
+// Mixed-format multiply returns the exact product type (same-format * keeps its saturating/wrapping form).
+// Declared here with the class, so `a * b` means the same in every translation unit.
+template<int TotalA, int FracA, int TotalB, int FracB, template<typename, template<typename> class, int> class OverFlowPolicy>
+	requires (TotalA != TotalB || FracA != FracB)
+constexpr auto operator*(const FixedPoint<TotalA, FracA, OverFlowPolicy>& a,
+                         const FixedPoint<TotalB, FracB, OverFlowPolicy>& b) {
+	return widening_mul(a, b);
+}
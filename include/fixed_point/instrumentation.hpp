@@ -0,0 +1,209 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "arithmetic_policies.hpp"
+
+// ----------------- Overflow Event Counters -----------------
+//
+// OverflowCounting<Base>::Policy behaves exactly like Base and also counts every
+// operation whose exact result fell outside the storage range (i.e. every time
+// Base clamps or wraps), separately for add, sub, mul, div and narrow
+// (accumulator results, scale_pow2, ...). Counters are per FixedPoint format and
+// per thread; overflow_counts<Fixed>() sums all threads, including ones that
+// have exited.
+//
+//   using Q15 = FixedPoint<16, 15, CountingSaturationPolicy>;
+//   ... run the pipeline ...
+//   auto counts = fixed_point::overflow_counts<Q15>();
+//
+// Counting is compiled in only when FIXED_POINT_COUNT_OVERFLOWS is defined.
+// Otherwise OverflowCounting<Base>::Policy is an alias of Base, so the counting
+// formats are the plain policies and overflow_counts() reports zeros. Define
+// it for the whole program, not per translation unit. Counted policies take the
+// scalar path in simd.hpp, so every operation is seen.
+
+namespace fixed_point {
+
+    enum class OverflowOp : std::size_t { Add, Sub, Mul, Div, Narrow };
+
+    inline constexpr std::size_t overflow_op_count = 5;
+
+    struct OverflowCounts {
+        std::array<uint64_t, overflow_op_count> events{};
+
+        constexpr uint64_t operator[](OverflowOp op) const {
+            return events[static_cast<std::size_t>(op)];
+        }
+
+        constexpr uint64_t total() const {
+            uint64_t sum = 0;
+            for (auto e : events) sum += e;
+            return sum;
+        }
+    };
+
+    namespace detail {
+
+        // Per-format counters: one slot per thread, merged into `retired_` when the thread exits
+        class OverflowRegistry {
+        public:
+            struct Slot {
+                std::array<std::atomic<uint64_t>, overflow_op_count> events{};
+            };
+
+            std::shared_ptr<Slot> attach() {
+                auto slot = std::make_shared<Slot>();
+                std::lock_guard<std::mutex> lock(mutex_);
+                live_.push_back(slot);
+                return slot;
+            }
+
+            void detach(const std::shared_ptr<Slot>& slot) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (std::size_t i = 0; i < overflow_op_count; ++i) {
+                    retired_.events[i] += slot->events[i].load(std::memory_order_relaxed);
+                }
+                std::erase(live_, slot);
+            }
+
+            OverflowCounts snapshot() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                OverflowCounts counts = retired_;
+                for (const auto& slot : live_) {
+                    for (std::size_t i = 0; i < overflow_op_count; ++i) {
+                        counts.events[i] += slot->events[i].load(std::memory_order_relaxed);
+                    }
+                }
+                return counts;
+            }
+
+            void reset() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                retired_ = {};
+                for (const auto& slot : live_) {
+                    for (auto& e : slot->events) e.store(0, std::memory_order_relaxed);
+                }
+            }
+
+        private:
+            std::mutex mutex_;
+            std::vector<std::shared_ptr<Slot>> live_;
+            OverflowCounts retired_;
+        };
+
+        template<typename Tag>
+        OverflowRegistry& overflow_registry() {
+            static OverflowRegistry registry;
+            return registry;
+        }
+
+        template<typename Tag>
+        struct ThreadOverflowSlot {
+            std::shared_ptr<OverflowRegistry::Slot> slot = overflow_registry<Tag>().attach();
+            ~ThreadOverflowSlot() { overflow_registry<Tag>().detach(slot); }
+        };
+
+        // Only the owning thread increments its slot; the atomic keeps snapshot() race-free
+        template<typename Tag>
+        void record_overflow(OverflowOp op) {
+            thread_local ThreadOverflowSlot<Tag> local;
+            local.slot->events[static_cast<std::size_t>(op)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        template<typename Policy>
+        concept CountsOverflows = Policy::counts_overflows;
+
+    } // namespace detail
+
+    template<template<typename, template<typename> class, int> class Base>
+    struct OverflowCounting {
+#if defined(FIXED_POINT_COUNT_OVERFLOWS)
+        template<typename StorageType, template<typename> class Promote, int FractionalBits>
+        struct Policy {
+            using BasePolicy = Base<StorageType, Promote, FractionalBits>;
+            using Wide = typename BasePolicy::Wide;
+            static constexpr bool counts_overflows = true;
+
+            static constexpr StorageType add(StorageType a, StorageType b) {
+                check(OverflowOp::Add, static_cast<Wide>(a) + static_cast<Wide>(b));
+                return BasePolicy::add(a, b);
+            }
+
+            static constexpr StorageType sub(StorageType a, StorageType b) {
+                check(OverflowOp::Sub, static_cast<Wide>(a) - static_cast<Wide>(b));
+                return BasePolicy::sub(a, b);
+            }
+
+            static constexpr StorageType mul(StorageType a, StorageType b) {
+                check(OverflowOp::Mul, (static_cast<Wide>(a) * static_cast<Wide>(b)) >> FractionalBits);
+                return BasePolicy::mul(a, b);
+            }
+
+            static constexpr StorageType div(StorageType a, StorageType b) {
+                if (b != 0) {
+                    check(OverflowOp::Div, (static_cast<Wide>(a) << FractionalBits) / static_cast<Wide>(b));
+                } else if (a != 0) {
+                    count(OverflowOp::Div);  // x / 0 overflows toward the sign of x
+                }
+                return BasePolicy::div(a, b);
+            }
+
+            template<typename Int>
+            static constexpr StorageType narrow(Int r) {
+                check(OverflowOp::Narrow, r);
+                return BasePolicy::narrow(r);
+            }
+
+        private:
+            // Constant evaluation is not counted
+            static constexpr void count(OverflowOp op) {
+                if !consteval {
+                    detail::record_overflow<Policy>(op);
+                }
+            }
+
+            template<typename Int>
+            static constexpr void check(OverflowOp op, Int r) {
+                if (r > std::numeric_limits<StorageType>::max() || r < std::numeric_limits<StorageType>::min()) {
+                    count(op);
+                }
+            }
+        };
+#else
+        template<typename StorageType, template<typename> class Promote, int FractionalBits>
+        using Policy = Base<StorageType, Promote, FractionalBits>;
+#endif
+    };
+
+    // Events recorded for Fixed so far, summed over all threads (zeros when counting is off)
+    template<typename Fixed>
+    OverflowCounts overflow_counts() {
+        if constexpr (detail::CountsOverflows<typename Fixed::PolicyType>) {
+            return detail::overflow_registry<typename Fixed::PolicyType>().snapshot();
+        } else {
+            return {};
+        }
+    }
+
+    template<typename Fixed>
+    void reset_overflow_counts() {
+        if constexpr (detail::CountsOverflows<typename Fixed::PolicyType>) {
+            detail::overflow_registry<typename Fixed::PolicyType>().reset();
+        }
+    }
+
+} // namespace fixed_point
+
+// Counting versions of the standard policies
+template<typename StorageType, template<typename> class Promote, int FractionalBits>
+using CountingWrapAroundPolicy = fixed_point::OverflowCounting<WrapAroundPolicy>::Policy<StorageType, Promote, FractionalBits>;
+
+template<typename StorageType, template<typename> class Promote, int FractionalBits>
+using CountingSaturationPolicy = fixed_point::OverflowCounting<SaturationPolicy>::Policy<StorageType, Promote, FractionalBits>;
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <cstdint>
+
+// ----------------- 128-bit Intermediate for 64-bit Formats -----------------
+//
+// FixedPoint<64, F> needs a 128-bit product/dividend. GCC and Clang provide
+// __int128 (the multiply compiles to a single mul/imul, or mulx with BMI2);
+// elsewhere (MSVC) Int128 below is a portable two's-complement fallback.
+// Define FIXED_POINT_NO_INT128 to force the fallback.
+
+#if defined(__SIZEOF_INT128__) && !defined(FIXED_POINT_NO_INT128)
+#define FIXED_POINT_HAS_INT128 1
+#else
+#define FIXED_POINT_HAS_INT128 0
+#endif
+
+namespace fixed_point {
+
+    class Int128 {
+    public:
+        constexpr Int128() = default;
+
+        template<std::integral T>
+        constexpr Int128(T v)
+            : lo_(static_cast<uint64_t>(v)),
+              hi_((std::signed_integral<T> && v < 0) ? ~uint64_t(0) : 0) {}
+
+        template<std::integral T>
+        explicit constexpr operator T() const {
+            return static_cast<T>(lo_);
+        }
+
+        explicit constexpr operator bool() const {
+            return (lo_ | hi_) != 0;
+        }
+
+        friend constexpr Int128 operator+(Int128 a, Int128 b) {
+            Int128 r;
+            r.lo_ = a.lo_ + b.lo_;
+            r.hi_ = a.hi_ + b.hi_ + (r.lo_ < a.lo_ ? 1 : 0);
+            return r;
+        }
+
+        friend constexpr Int128 operator-(Int128 a, Int128 b) {
+            Int128 r;
+            r.lo_ = a.lo_ - b.lo_;
+            r.hi_ = a.hi_ - b.hi_ - (a.lo_ < b.lo_ ? 1 : 0);
+            return r;
+        }
+
+        constexpr Int128 operator-() const {
+            return Int128{} - *this;
+        }
+
+        constexpr Int128 operator~() const {
+            Int128 r;
+            r.lo_ = ~lo_;
+            r.hi_ = ~hi_;
+            return r;
+        }
+
+        // Low 128 bits of the product; identical for signed and unsigned operands
+        friend constexpr Int128 operator*(Int128 a, Int128 b) {
+            Int128 r = mul_u64(a.lo_, b.lo_);
+            r.hi_ += a.lo_ * b.hi_ + a.hi_ * b.lo_;
+            return r;
+        }
+
+        // Truncating signed division, like the built-in integer types
+        friend constexpr Int128 operator/(Int128 a, Int128 b) {
+            bool negative = a.negative() != b.negative();
+            Int128 q = udiv(a.negative() ? -a : a, b.negative() ? -b : b);
+            return negative ? -q : q;
+        }
+
+        friend constexpr Int128 operator&(Int128 a, Int128 b) {
+            Int128 r;
+            r.lo_ = a.lo_ & b.lo_;
+            r.hi_ = a.hi_ & b.hi_;
+            return r;
+        }
+
+        constexpr Int128 operator<<(int s) const {
+            Int128 r;
+            if (s == 0) return *this;
+            if (s >= 64) {
+                r.hi_ = lo_ << (s - 64);
+                r.lo_ = 0;
+            } else {
+                r.hi_ = (hi_ << s) | (lo_ >> (64 - s));
+                r.lo_ = lo_ << s;
+            }
+            return r;
+        }
+
+        // Arithmetic shift
+        constexpr Int128 operator>>(int s) const {
+            Int128 r;
+            if (s == 0) return *this;
+            uint64_t fill = negative() ? ~uint64_t(0) : 0;
+            if (s >= 64) {
+                r.lo_ = static_cast<uint64_t>(static_cast<int64_t>(hi_) >> (s - 64));
+                r.hi_ = fill;
+            } else {
+                r.lo_ = (lo_ >> s) | (hi_ << (64 - s));
+                r.hi_ = static_cast<uint64_t>(static_cast<int64_t>(hi_) >> s);
+            }
+            return r;
+        }
+
+        constexpr Int128& operator+=(Int128 b) { return *this = *this + b; }
+        constexpr Int128& operator-=(Int128 b) { return *this = *this - b; }
+
+        friend constexpr bool operator==(Int128 a, Int128 b) = default;
+
+        friend constexpr std::strong_ordering operator<=>(Int128 a, Int128 b) {
+            if (a.hi_ != b.hi_) return static_cast<int64_t>(a.hi_) <=> static_cast<int64_t>(b.hi_);
+            return a.lo_ <=> b.lo_;
+        }
+
+    private:
+        uint64_t lo_ = 0;
+        uint64_t hi_ = 0;
+
+        constexpr bool negative() const {
+            return (hi_ >> 63) != 0;
+        }
+
+        // Full 64x64 -> 128 unsigned product from 32-bit limbs
+        static constexpr Int128 mul_u64(uint64_t a, uint64_t b) {
+            uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+            uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+            uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi, hl = a_hi * b_lo, hh = a_hi * b_hi;
+            uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+            Int128 r;
+            r.lo_ = (mid << 32) | (ll & 0xFFFFFFFFu);
+            r.hi_ = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+            return r;
+        }
+
+        static constexpr bool ugreater_equal(Int128 a, Int128 b) {
+            return a.hi_ != b.hi_ ? a.hi_ > b.hi_ : a.lo_ >= b.lo_;
+        }
+
+        // Restoring binary long division of magnitudes (fallback path only)
+        static constexpr Int128 udiv(Int128 n, Int128 d) {
+            Int128 q, r;
+            for (int i = 127; i >= 0; --i) {
+                r.hi_ = (r.hi_ << 1) | (r.lo_ >> 63);
+                r.lo_ = (r.lo_ << 1) | (((i >= 64 ? n.hi_ >> (i - 64) : n.lo_ >> i)) & 1);
+                if (ugreater_equal(r, d)) {
+                    r = r - d;
+                    if (i >= 64) q.hi_ |= uint64_t(1) << (i - 64);
+                    else         q.lo_ |= uint64_t(1) << i;
+                }
+            }
+            return q;
+        }
+    };
+
+#if FIXED_POINT_HAS_INT128
+    __extension__ typedef __int128 wide_int128;
+#else
+    using wide_int128 = Int128;
+#endif
+
+} // namespace fixed_point
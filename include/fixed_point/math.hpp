@@ -0,0 +1,332 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+#include <utility>
+#include "fixed_point.hpp"
+#include "int128.hpp"
+#include "rounding.hpp"
+#include "dsp/constexpr_math.hpp"
+
+// ----------------- Fixed-Point Transcendentals -----------------
+//
+// sin/cos, atan2, magnitude, sqrt and log2 computed on the raw integers, with no
+// float round-trip. Angles are radians in the caller's format. Internally they
+// become a 32-bit binary phase (2^32 == one turn), so range reduction is just
+// integer wrap-around.
+//
+//   MathMethod::Cordic  shift-and-add iterations. Precision is the iteration
+//                       count, roughly one bit of accuracy each (1..30).
+//   MathMethod::Table   lookup with linear interpolation. Precision is log2 of
+//                       the table size (2..16); the error drops 4x per extra bit.
+//
+// The intermediates are Q2.30, so no result is better than about 2^-29. Results
+// outside the format's range go through the policy's narrow().
+
+namespace fixed_point {
+
+    enum class MathMethod { Cordic, Table };
+
+    template<MathMethod M>
+    inline constexpr int default_precision = (M == MathMethod::Cordic) ? 24 : 10;
+
+    namespace detail {
+
+        inline constexpr int math_frac_bits = 30;
+
+        // Value with `frac` fractional bits to Fixed, rounded to nearest, through the policy
+        template<typename Fixed>
+        constexpr Fixed narrow_q(wide_int128 v, int frac) {
+            constexpr int F = Fixed::fractional_bits;
+            wide_int128 r = frac >= F ? shift_right_rounded<Rounding::Nearest>(v, frac - F) : v << (F - frac);
+            return Fixed::from_raw(Fixed::PolicyType::narrow(r));
+        }
+
+        // Radians to a binary phase, 2^32 per turn; whole turns fall off the top
+        template<typename Fixed>
+        constexpr uint32_t to_phase(Fixed angle) {
+            // 2^64 / (2*pi)
+            constexpr int64_t turns_per_radian = static_cast<int64_t>(18446744073709551616.0 / (2.0 * std::numbers::pi));
+            wide_int128 p = shift_right_rounded<Rounding::Nearest>(
+                wide_int128(angle.raw()) * turns_per_radian, Fixed::fractional_bits + 32);
+            return static_cast<uint32_t>(static_cast<uint64_t>(p));
+        }
+
+        // Signed binary phase to radians
+        template<typename Fixed>
+        constexpr Fixed from_phase(int64_t phase) {
+            // 2*pi * 2^60
+            constexpr int64_t radians_per_turn = static_cast<int64_t>(2.0 * std::numbers::pi * 1152921504606846976.0);
+            return narrow_q<Fixed>(wide_int128(phase) * radians_per_turn, 60 + 32);
+        }
+
+        // ---- CORDIC ----
+
+        // atan(2^-i) as a binary phase
+        inline constexpr auto cordic_angles = [] {
+            std::array<int64_t, 31> angles{};
+            for (int i = 0; i < 31; ++i) {
+                double turns = dsp::constexpr_atan(1.0 / double(uint64_t(1) << i)) / (2.0 * std::numbers::pi);
+                angles[i] = static_cast<int64_t>(turns * 4294967296.0 + 0.5);
+            }
+            return angles;
+        }();
+
+        // 1/gain of `Iterations` CORDIC steps, prod 1/sqrt(1 + 2^-2i), in Q2.30
+        template<int Iterations>
+        inline constexpr int64_t cordic_scale = [] {
+            double gain2 = 1.0;
+            for (int i = 0; i < Iterations; ++i) gain2 *= 1.0 + 1.0 / double(uint64_t(1) << (2 * i));
+            return static_cast<int64_t>(double(int64_t(1) << math_frac_bits) / dsp::constexpr_sqrt(gain2) + 0.5);
+        }();
+
+        // Rotation mode: {sin, cos} of a phase in Q2.30
+        template<int Iterations>
+        constexpr std::pair<int64_t, int64_t> cordic_sincos(uint32_t phase) {
+            constexpr int64_t quarter = int64_t(1) << 30;
+            constexpr int64_t half = int64_t(1) << 31;
+            // CORDIC converges for |angle| <= pi/2; rotate the other half-plane by pi
+            int64_t z = static_cast<int32_t>(phase);
+            bool flip = false;
+            if (z > quarter)       { z -= half; flip = true; }
+            else if (z < -quarter) { z += half; flip = true; }
+
+            int64_t x = cordic_scale<Iterations>, y = 0;
+            for (int i = 0; i < Iterations; ++i) {
+                int64_t dx = y >> i, dy = x >> i;
+                if (z >= 0) { x -= dx; y += dy; z -= cordic_angles[i]; }
+                else        { x += dx; y -= dy; z += cordic_angles[i]; }
+            }
+            return flip ? std::pair{ -y, -x } : std::pair{ y, x };
+        }
+
+        // Vectoring mode for x >= 0: {x * gain, angle of (x, y) as a phase}
+        template<int Iterations>
+        constexpr std::pair<int64_t, int64_t> cordic_vector(int64_t x, int64_t y) {
+            int64_t z = 0;
+            for (int i = 0; i < Iterations; ++i) {
+                int64_t dx = y >> i, dy = x >> i;
+                if (y > 0) { x += dx; y -= dy; z += cordic_angles[i]; }
+                else       { x -= dx; y += dy; z -= cordic_angles[i]; }
+            }
+            return { x, z };
+        }
+
+        // |raw| of any storage type (|min| included)
+        template<typename S>
+        constexpr uint64_t magnitude_of(S v) {
+            return v < 0 ? uint64_t(0) - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+        }
+
+        // Shift two magnitudes together so the larger has 30 significant bits.
+        // Returns the left shift applied (negative for a right shift).
+        constexpr int normalize_pair(uint64_t& a, uint64_t& b) {
+            int shift = math_frac_bits - static_cast<int>(std::bit_width(a > b ? a : b));
+            if (shift >= 0) { a <<= shift;  b <<= shift; }
+            else            { a >>= -shift; b >>= -shift; }
+            return shift;
+        }
+
+        // ---- Tables ----
+
+        inline constexpr int32_t round_q30(double v) {
+            double scaled = v * double(int64_t(1) << math_frac_bits);
+            return static_cast<int32_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+        }
+
+        // sin over one full turn, 2^TableBits steps plus the closing sample
+        template<int TableBits>
+        inline constexpr auto sin_table = [] {
+            constexpr std::size_t N = std::size_t(1) << TableBits;
+            std::array<int32_t, N + 1> t{};
+            for (std::size_t i = 0; i <= N; ++i) t[i] = round_q30(dsp::constexpr_sin(2.0 * std::numbers::pi * double(i) / double(N)));
+            return t;
+        }();
+
+        // atan(r) as a binary phase for r in [0, 1], with one spare entry for r == 1
+        template<int TableBits>
+        inline constexpr auto atan_table = [] {
+            constexpr std::size_t N = std::size_t(1) << TableBits;
+            std::array<int32_t, N + 2> t{};
+            for (std::size_t i = 0; i <= N; ++i) {
+                double turns = dsp::constexpr_atan(double(i) / double(N)) / (2.0 * std::numbers::pi);
+                t[i] = static_cast<int32_t>(turns * 4294967296.0 + 0.5);
+            }
+            t[N + 1] = t[N];
+            return t;
+        }();
+
+        // log2(1 + i/N) in Q2.30
+        template<int TableBits>
+        inline constexpr auto log2_table = [] {
+            constexpr std::size_t N = std::size_t(1) << TableBits;
+            std::array<int32_t, N + 1> t{};
+            for (std::size_t i = 0; i <= N; ++i) t[i] = round_q30(dsp::constexpr_log2(1.0 + double(i) / double(N)));
+            return t;
+        }();
+
+        // t[i] + (t[i+1] - t[i]) * weight / 2^32, rounded
+        template<typename Table>
+        constexpr int64_t interpolate(const Table& t, std::size_t i, uint32_t weight) {
+            int64_t a = t[i], b = t[i + 1];
+            return a + (((b - a) * int64_t(weight) + (int64_t(1) << 31)) >> 32);
+        }
+
+        template<int TableBits>
+        constexpr int64_t table_sin(uint32_t phase) {
+            return interpolate(sin_table<TableBits>, phase >> (32 - TableBits), uint32_t(phase << TableBits));
+        }
+
+        // Integer square root of n, rounded to nearest
+        template<typename Int>
+        constexpr Int isqrt_rounded(Int n) {
+            Int root = 0;
+            Int bit = Int(1) << (sizeof(Int) * 8 - 2);
+            while (bit > n) bit = bit >> 2;
+            while (bit != Int(0)) {
+                if (n >= root + bit) {
+                    n -= root + bit;
+                    root = (root >> 1) + bit;
+                } else {
+                    root = root >> 1;
+                }
+                bit = bit >> 2;
+            }
+            // n is now the remainder n - root^2; (root + 1/2)^2 = root^2 + root + 1/4
+            return n > root ? root + Int(1) : root;
+        }
+
+        template<MathMethod M, int Precision>
+        constexpr void check_precision() {
+            if constexpr (M == MathMethod::Cordic) {
+                static_assert(Precision >= 1 && Precision <= 30, "CORDIC iterations must be in [1, 30]");
+            } else {
+                static_assert(Precision >= 2 && Precision <= 16, "Table bits must be in [2, 16]");
+            }
+        }
+
+    } // namespace detail
+
+    // {sin(angle), cos(angle)}
+    template<MathMethod M = MathMethod::Cordic, int Precision = default_precision<M>, typename Fixed>
+    constexpr std::pair<Fixed, Fixed> sincos(Fixed angle) {
+        static_assert(is_fixed_point_v<Fixed>, "sincos needs a FixedPoint argument");
+        detail::check_precision<M, Precision>();
+        uint32_t phase = detail::to_phase(angle);
+        int64_t s, c;
+        if constexpr (M == MathMethod::Cordic) {
+            auto [cs, cc] = detail::cordic_sincos<Precision>(phase);
+            s = cs;
+            c = cc;
+        } else {
+            s = detail::table_sin<Precision>(phase);
+            c = detail::table_sin<Precision>(phase + (uint32_t(1) << 30));
+        }
+        return { detail::narrow_q<Fixed>(s, detail::math_frac_bits), detail::narrow_q<Fixed>(c, detail::math_frac_bits) };
+    }
+
+    template<MathMethod M = MathMethod::Cordic, int Precision = default_precision<M>, typename Fixed>
+    constexpr Fixed sin(Fixed angle) {
+        if constexpr (M == MathMethod::Table) {
+            detail::check_precision<M, Precision>();
+            return detail::narrow_q<Fixed>(detail::table_sin<Precision>(detail::to_phase(angle)), detail::math_frac_bits);
+        } else {
+            return sincos<M, Precision>(angle).first;
+        }
+    }
+
+    template<MathMethod M = MathMethod::Cordic, int Precision = default_precision<M>, typename Fixed>
+    constexpr Fixed cos(Fixed angle) {
+        if constexpr (M == MathMethod::Table) {
+            detail::check_precision<M, Precision>();
+            uint32_t phase = detail::to_phase(angle) + (uint32_t(1) << 30);
+            return detail::narrow_q<Fixed>(detail::table_sin<Precision>(phase), detail::math_frac_bits);
+        } else {
+            return sincos<M, Precision>(angle).second;
+        }
+    }
+
+    // Angle of (x, y) in (-pi, pi]; atan2(0, 0) is 0
+    template<MathMethod M = MathMethod::Cordic, int Precision = default_precision<M>, typename Fixed>
+    constexpr Fixed atan2(Fixed y, Fixed x) {
+        static_assert(is_fixed_point_v<Fixed>, "atan2 needs a FixedPoint argument");
+        detail::check_precision<M, Precision>();
+        constexpr int64_t quarter = int64_t(1) << 30;
+        constexpr int64_t half = int64_t(1) << 31;
+        uint64_t ax = detail::magnitude_of(x.raw()), ay = detail::magnitude_of(y.raw());
+        if (ax == 0 && ay == 0) return Fixed{};
+        detail::normalize_pair(ax, ay);
+
+        int64_t angle;
+        if constexpr (M == MathMethod::Cordic) {
+            // Angle of (|x|, |y|) in [0, pi/2]
+            angle = detail::cordic_vector<Precision>(int64_t(ax), int64_t(ay)).second;
+        } else {
+            // Fold into the first octant, look up atan(min/max), unfold
+            bool swapped = ay > ax;
+            uint64_t num = swapped ? ax : ay, den = swapped ? ay : ax;
+            uint64_t ratio = (num << 32) / den;  // in [0, 2^32]
+            angle = detail::interpolate(detail::atan_table<Precision>,
+                                        static_cast<std::size_t>(ratio >> (32 - Precision)),
+                                        static_cast<uint32_t>(ratio << Precision));
+            if (swapped) angle = quarter - angle;
+        }
+        if (x.raw() < 0) angle = half - angle;
+        if (y.raw() < 0) angle = -angle;
+        return detail::from_phase<Fixed>(angle);
+    }
+
+    // sqrt(x^2 + y^2) by CORDIC vectoring; Iterations as for sin/cos
+    template<int Iterations = default_precision<MathMethod::Cordic>, typename Fixed>
+    constexpr Fixed magnitude(Fixed x, Fixed y) {
+        static_assert(is_fixed_point_v<Fixed>, "magnitude needs a FixedPoint argument");
+        detail::check_precision<MathMethod::Cordic, Iterations>();
+        uint64_t ax = detail::magnitude_of(x.raw()), ay = detail::magnitude_of(y.raw());
+        if (ax == 0 && ay == 0) return Fixed{};
+        int shift = detail::normalize_pair(ax, ay);
+        int64_t scaled = detail::cordic_vector<Iterations>(int64_t(ax), int64_t(ay)).first;
+        // Undo the CORDIC gain (Q2.30 factor) and the normalisation shift
+        wide_int128 mag = wide_int128(scaled) * detail::cordic_scale<Iterations>;
+        return detail::narrow_q<Fixed>(mag, detail::math_frac_bits + shift + Fixed::fractional_bits);
+    }
+
+    // Exact square root rounded to nearest; negative inputs give 0
+    template<typename Fixed>
+    constexpr Fixed sqrt(Fixed x) {
+        static_assert(is_fixed_point_v<Fixed>, "sqrt needs a FixedPoint argument");
+        if (x.raw() <= 0) return Fixed{};
+        // sqrt(raw / 2^F) * 2^F == sqrt(raw * 2^F)
+        constexpr int F = Fixed::fractional_bits;
+        if constexpr (sizeof(typename Fixed::StorageType) <= 4) {
+            uint64_t root = detail::isqrt_rounded<uint64_t>(uint64_t(x.raw()) << F);
+            return Fixed::from_raw(Fixed::PolicyType::narrow(static_cast<int64_t>(root)));
+        } else {
+            wide_int128 root = detail::isqrt_rounded<wide_int128>(wide_int128(x.raw()) << F);
+            return Fixed::from_raw(Fixed::PolicyType::narrow(root));
+        }
+    }
+
+    // Base-2 logarithm via the leading-bit position and an interpolated mantissa table;
+    // x <= 0 gives the most negative value (standing in for -infinity)
+    template<int TableBits = default_precision<MathMethod::Table>, typename Fixed>
+    constexpr Fixed log2(Fixed x) {
+        static_assert(is_fixed_point_v<Fixed>, "log2 needs a FixedPoint argument");
+        detail::check_precision<MathMethod::Table, TableBits>();
+        using S = typename Fixed::StorageType;
+        if (x.raw() <= 0) return Fixed::from_raw(std::numeric_limits<S>::min());
+        uint64_t v = static_cast<uint64_t>(x.raw());
+        int msb = static_cast<int>(std::bit_width(v)) - 1;
+        uint64_t mantissa = (v << (63 - msb)) << 1;  // fraction of the normalised value in [1, 2)
+        int64_t frac = detail::interpolate(detail::log2_table<TableBits>,
+                                           static_cast<std::size_t>(mantissa >> (64 - TableBits)),
+                                           static_cast<uint32_t>((mantissa << TableBits) >> 32));
+        int64_t result = (int64_t(msb - Fixed::fractional_bits) << detail::math_frac_bits) + frac;
+        return detail::narrow_q<Fixed>(result, detail::math_frac_bits);
+    }
+
+} // namespace fixed_point
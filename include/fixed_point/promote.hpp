@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include "int128.hpp"
+
 // ----------------- Type Promotion Helper -----------------
 template <typename T>
 struct Promote { using type = T; };
@@ -13,5 +16,6 @@ struct Promote<int16_t> { using type = int32_t; };
 template <>
 struct Promote<int32_t> { using type = int64_t; };
 
+// 64-bit formats need a 128-bit intermediate so mul/div do not overflow before the shift
 template <>
-struct Promote<int64_t> { using type = int64_t; };
\ No newline at end of file
+struct Promote<int64_t> { using type = fixed_point::wide_int128; };
\ No newline at end of file
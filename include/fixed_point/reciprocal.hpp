@@ -0,0 +1,110 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "fixed_point.hpp"
+#include "int128.hpp"
+
+// ----------------- Reciprocal for Repeated Division -----------------
+//
+// Dividing many values by the same divisor (a gain, a block length, the 1/N of an
+// inverse transform) costs one wide hardware divide per value through operator/.
+// Reciprocal does that divide once: it precomputes a multiplier m and shift p with
+// floor(n / d) == (n * m) >> p for every dividend the format can produce
+// (Granlund & Montgomery, "Division by Invariant Integers using Multiplication"),
+// so apply() is a multiply and a shift. apply_rounded() rounds the quotient to nearest
+// instead, for one more multiply.
+//
+// apply() returns the same truncated quotient as operator/, brought into range by the
+// policy's narrow(). The one difference is SaturationPolicy's special case min / d == min,
+// which Reciprocal does not reproduce. A zero divisor is handed to the policy's div on use.
+// 64-bit formats would need a 256-bit product and keep a plain 128-bit division.
+template<typename Fixed>
+class Reciprocal {
+	static_assert(is_fixed_point_v<Fixed>, "Reciprocal needs a FixedPoint type");
+
+	using S = typename Fixed::StorageType;
+	using Wide = typename Fixed::PolicyType::Wide;
+	static constexpr int storage_bits = static_cast<int>(sizeof(S) * 8);
+
+	// Dividends are below 2^(2*storage_bits - 1) and m below 2^(2*storage_bits),
+	// so 16-bit storage multiplies in 64 bits and 32-bit storage in 128 bits
+	static constexpr bool exact_multiply = storage_bits <= 32;
+	using Mul = std::conditional_t<(storage_bits <= 16), uint64_t, fixed_point::wide_int128>;
+
+public:
+	// x / divisor
+	constexpr explicit Reciprocal(Fixed divisor)
+		: Reciprocal(magnitude(divisor.raw()), divisor.raw() < 0, Fixed::fractional_bits) {}
+
+	// x / count, the raw value divided by an integer; count need not be representable in Fixed
+	static constexpr Reciprocal from_count(std::size_t count) {
+		return Reciprocal(static_cast<uint64_t>(count), false, 0);
+	}
+
+	constexpr Fixed apply(Fixed x) const {
+		return divide<false>(x);
+	}
+
+	// x / divisor rounded to nearest, half away from zero: the rounding scale_pow2<Rounding::Nearest>
+	// gives a power-of-two divisor, so the two agree wherever both apply
+	constexpr Fixed apply_rounded(Fixed x) const {
+		return divide<true>(x);
+	}
+
+private:
+	uint64_t divisor_;
+	bool negative_;
+	int shift_;            // dividend pre-shift: F for a FixedPoint divisor, 0 for a count
+	int post_shift_ = 0;
+	Mul magic_ = 0;
+
+	constexpr Reciprocal(uint64_t divisor, bool negative, int shift)
+		: divisor_(divisor), negative_(negative), shift_(shift) {
+		if constexpr (exact_multiply) {
+			if (divisor_ == 0) return;
+			// Dividend magnitudes are below 2^N; with l = ceil(log2 d), m = ceil(2^(N+l) / d)
+			// satisfies m*d - 2^(N+l) < d <= 2^l, which makes the shifted product exact
+			int N = storage_bits + shift_;
+			int l = static_cast<int>(std::bit_width(divisor_ - 1));
+			if (l > N) return;  // d exceeds every dividend: the quotient is always 0
+			post_shift_ = N + l;
+			fixed_point::wide_int128 d = divisor_;
+			fixed_point::wide_int128 m = ((fixed_point::wide_int128(1) << post_shift_) + d - 1) / d;
+			magic_ = static_cast<Mul>(m);
+		}
+	}
+
+	// The quotient of the magnitudes is exact, so rounding only needs its remainder
+	template<bool Round>
+	constexpr Fixed divide(Fixed x) const {
+		if (divisor_ == 0) {
+			return Fixed::from_raw(Fixed::PolicyType::div(x.raw(), S{ 0 }));
+		}
+		S a = x.raw();
+		Wide q;
+		if constexpr (exact_multiply) {
+			Mul n = static_cast<Mul>(magnitude(a)) << shift_;
+			Mul m = (n * magic_) >> post_shift_;
+			if constexpr (Round) {
+				Mul r = n - m * Mul(divisor_);
+				if (r + r >= Mul(divisor_)) m = m + Mul(1);
+			}
+			q = static_cast<Wide>(m);
+		} else {
+			Wide n = static_cast<Wide>(magnitude(a)) << shift_;
+			q = n / static_cast<Wide>(divisor_);
+			if constexpr (Round) {
+				Wide r = n - q * static_cast<Wide>(divisor_);
+				if (r + r >= static_cast<Wide>(divisor_)) q = q + Wide(1);
+			}
+		}
+		return Fixed::from_raw(Fixed::PolicyType::narrow(((a < 0) != negative_) ? -q : q));
+	}
+
+	static constexpr uint64_t magnitude(S v) {
+		return v < 0 ? uint64_t(0) - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+	}
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cmath>
+
+namespace fixed_point {
+
+    // Rounding used when a value loses fractional bits
+    enum class Rounding {
+        Nearest,      // half away from zero (std::round, the FixedPoint(double) constructor)
+        NearestEven,  // half to even (convergent rounding, no DC bias)
+        TowardZero,   // truncate
+        Floor         // toward -inf (plain arithmetic shift)
+    };
+
+    // Round a floating-point value to an integral value of the same type
+    template<Rounding R, typename Float>
+    inline Float round_float(Float v) {
+        if constexpr (R == Rounding::Nearest) {
+            return std::round(v);
+        } else if constexpr (R == Rounding::NearestEven) {
+            Float t = std::floor(v);
+            Float d = v - t;
+            if (d > Float(0.5) || (d == Float(0.5) && std::fmod(t, Float(2)) != 0)) t += 1;
+            return t;
+        } else if constexpr (R == Rounding::TowardZero) {
+            return std::trunc(v);
+        } else {
+            return std::floor(v);
+        }
+    }
+
+    // x / 2^shift with the requested rounding. Overflow-free for every x and 0 <= shift < bits(Int).
+    // Only needs shifts, +, - and comparisons, so it also works for 128-bit intermediates.
+    template<Rounding R, typename Int>
+    constexpr Int shift_right_rounded(Int x, int shift) {
+        if (shift == 0) return x;
+        Int q = x >> shift;
+        Int r = x - (q << shift);  // remainder in [0, 2^shift)
+        Int half = Int(1) << (shift - 1);
+        if constexpr (R == Rounding::Nearest) {
+            return q + ((x >= Int(0)) ? (r >= half) : (r > half));
+        } else if constexpr (R == Rounding::NearestEven) {
+            return q + (r > half || (r == half && (q & Int(1)) != Int(0)));
+        } else if constexpr (R == Rounding::TowardZero) {
+            return q + (x < Int(0) && r != Int(0));
+        } else {
+            return q;
+        }
+    }
+
+} // namespace fixed_point
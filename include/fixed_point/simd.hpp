@@ -0,0 +1,776 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include "fixed_point.hpp"
+
+// ----------------- Batch (SIMD) kernels for FixedPoint buffers -----------------
+//
+// Element-wise add/sub/mul/mac/scale and split-complex FFT butterflies over spans of FixedPoint. Buffers whose
+// storage is int16_t or int32_t under SaturationPolicy or WrapAroundPolicy are
+// processed with SSE4.1, AVX2 or AVX-512 kernels chosen at runtime; everything
+// else (other widths, other policies) falls back to the scalar operators.
+// Every kernel is bit-exact against the scalar policy it replaces, so results
+// never depend on the machine they run on.
+//
+// Define FIXED_POINT_DISABLE_SIMD to compile the scalar path only.
+
+#if !defined(FIXED_POINT_DISABLE_SIMD) && \
+    (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define FIXED_POINT_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define FIXED_POINT_SIMD_X86 0
+#endif
+
+// GCC/Clang need per-function ISA targets so the rest of the program can stay baseline
+#if defined(__GNUC__) || defined(__clang__)
+#define FIXED_POINT_TARGET(isa) __attribute__((target(isa)))
+#else
+#define FIXED_POINT_TARGET(isa)
+#endif
+
+namespace fixed_point::simd {
+
+    enum class SimdLevel { Scalar = 0, SSE41 = 1, AVX2 = 2, AVX512 = 3 };
+
+    namespace detail {
+
+        inline SimdLevel detect_level() {
+#if !FIXED_POINT_SIMD_X86
+            return SimdLevel::Scalar;
+#elif defined(_MSC_VER) && !defined(__clang__)
+            int regs[4];
+            __cpuid(regs, 0);
+            int max_leaf = regs[0];
+            __cpuid(regs, 1);
+            bool sse41 = (regs[2] & (1 << 19)) != 0;
+            bool osxsave = (regs[2] & (1 << 27)) != 0;
+            unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+            bool avx2 = false, avx512 = false;
+            if (max_leaf >= 7) {
+                __cpuidex(regs, 7, 0);
+                avx2 = (regs[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+                avx512 = (regs[1] & (1 << 16)) != 0 && (regs[1] & (1 << 30)) != 0
+                    && (xcr0 & 0xE6) == 0xE6;
+            }
+            if (avx512) return SimdLevel::AVX512;
+            if (avx2)   return SimdLevel::AVX2;
+            if (sse41)  return SimdLevel::SSE41;
+            return SimdLevel::Scalar;
+#else
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return SimdLevel::AVX512;
+            if (__builtin_cpu_supports("avx2"))   return SimdLevel::AVX2;
+            if (__builtin_cpu_supports("sse4.1")) return SimdLevel::SSE41;
+            return SimdLevel::Scalar;
+#endif
+        }
+
+        inline std::atomic<SimdLevel>& active_level_storage() {
+            static std::atomic<SimdLevel> level{ detect_level() };
+            return level;
+        }
+
+    } // namespace detail
+
+    // Best instruction set supported by this CPU
+    inline SimdLevel detected_level() {
+        static const SimdLevel level = detail::detect_level();
+        return level;
+    }
+
+    // Instruction set the batch kernels currently dispatch to
+    inline SimdLevel active_level() {
+        return detail::active_level_storage().load(std::memory_order_relaxed);
+    }
+
+    // Cap the dispatch level (e.g. for tests and benchmarks); never exceeds detected_level()
+    inline void set_level(SimdLevel level) {
+        if (level > detected_level()) level = detected_level();
+        detail::active_level_storage().store(level, std::memory_order_relaxed);
+    }
+
+    namespace detail {
+
+        enum class Op { Add, Sub, Mul, Mac };
+
+        // Where a butterfly's twiddle comes from: one per element, one for all elements,
+        // or a trivial W = 1 / W = -j that needs no multiply
+        enum class Twiddle { Table, Broadcast, One, MinusJ };
+
+        // Policy that decides the overflow rule; wrappers such as the overflow counters
+        // (instrumentation.hpp) expose the policy they forward to as BasePolicy
+        template<typename Policy>
+        struct overflow_rule { using type = Policy; };
+
+        template<typename Policy>
+            requires requires { typename Policy::BasePolicy; }
+        struct overflow_rule<Policy> { using type = typename Policy::BasePolicy; };
+
+        // Which FixedPoint instantiations have vector kernels
+        template<typename Fixed>
+        struct batch_traits {
+            using S = typename Fixed::StorageType;
+            static constexpr int F = Fixed::fractional_bits;
+            using Rule = typename overflow_rule<typename Fixed::PolicyType>::type;
+            // Derived policies (e.g. the no-throw division variants) share add/sub/mul with their base
+            static constexpr bool saturate = std::is_base_of_v<SaturationPolicy<S, Promote, F>, Rule>;
+            static constexpr bool wrap = std::is_base_of_v<WrapAroundPolicy<S, Promote, F>, Rule>;
+            // Wrapped policies must see every operation, so they stay scalar
+            static constexpr bool vectorizable =
+                (saturate || wrap) && std::is_same_v<Rule, typename Fixed::PolicyType>
+                && (std::is_same_v<S, int16_t> || std::is_same_v<S, int32_t>)
+                && sizeof(Fixed) == sizeof(S) && std::is_standard_layout_v<Fixed>;
+        };
+
+#if FIXED_POINT_SIMD_X86
+
+        // Overflow conventions shared by all kernels (they mirror arithmetic_policies.hpp):
+        //   SaturationPolicy -> clamp to min/max
+        //   WrapAroundPolicy -> overflow yields min, underflow yields max, i.e. ~clamped
+
+        // ----------------- SSE4.1 (8 x int16 / 4 x int32) -----------------
+        namespace sse41 {
+
+            template<bool Wrap>
+            FIXED_POINT_TARGET("sse4.1") inline __m128i add16(__m128i a, __m128i b) {
+                __m128i s = _mm_adds_epi16(a, b);
+                if constexpr (!Wrap) return s;
+                __m128i same = _mm_cmpeq_epi16(s, _mm_add_epi16(a, b));
+                return _mm_xor_si128(_mm_xor_si128(s, _mm_set1_epi32(-1)), same);
+            }
+
+            template<bool Wrap>
+            FIXED_POINT_TARGET("sse4.1") inline __m128i sub16(__m128i a, __m128i b) {
+                __m128i s = _mm_subs_epi16(a, b);
+                if constexpr (!Wrap) return s;
+                __m128i same = _mm_cmpeq_epi16(s, _mm_sub_epi16(a, b));
+                return _mm_xor_si128(_mm_xor_si128(s, _mm_set1_epi32(-1)), same);
+            }
+
+            template<bool Wrap, int F>
+            FIXED_POINT_TARGET("sse4.1") inline __m128i mul16(__m128i a, __m128i b) {
+                // Exact 32-bit products, floor-shifted like the scalar policies (pmulhrsw would round)
+                __m128i lo = _mm_mullo_epi16(a, b);
+                __m128i hi = _mm_mulhi_epi16(a, b);
+                __m128i r0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), F);
+                __m128i r1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), F);
+                __m128i s = _mm_packs_epi32(r0, r1);
+                if constexpr (!Wrap) return s;
+                __m128i max = _mm_set1_epi32(INT16_MAX), min = _mm_set1_epi32(INT16_MIN);
+                __m128i o0 = _mm_or_si128(_mm_cmpgt_epi32(r0, max), _mm_cmpgt_epi32(min, r0));
+                __m128i o1 = _mm_or_si128(_mm_cmpgt_epi32(r1, max), _mm_cmpgt_epi32(min, r1));
+                return _mm_xor_si128(s, _mm_packs_epi32(o0, o1));
+            }
+
+            template<bool Wrap>
+            FIXED_POINT_TARGET("sse4.1") inline __m128i add32(__m128i a, __m128i b) {
+                __m128i r = _mm_add_epi32(a, b);
+                __m128i ovf = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a, r), _mm_xor_si128(b, r)), 31);
+                __m128i sat = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(Wrap ? INT32_MIN : INT32_MAX));
+                return _mm_blendv_epi8(r, sat, ovf);
+            }
+
+            template<bool Wrap>
+            FIXED_POINT_TARGET("sse4.1") inline __m128i sub32(__m128i a, __m128i b) {
+                __m128i r = _mm_sub_epi32(a, b);
+                __m128i ovf = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, r)), 31);
+                __m128i sat = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(Wrap ? INT32_MIN : INT32_MAX));
+                return _mm_blendv_epi8(r, sat, ovf);
+            }
+
+            // Returns the number of leading elements processed; the caller finishes the tail.
+            // 32-bit multiplies need 64-bit compares (SSE4.2+), so they stay on the scalar path here.
+            template<Op op, bool Wrap, int F, bool Broadcast, typename S>
+            FIXED_POINT_TARGET("sse4.1")
+            std::size_t run(const S* a, const S* b, S* out, std::size_t n) {
+                constexpr std::size_t lanes = 16 / sizeof(S);
+                constexpr bool wide_mul = sizeof(S) == 4 && (op == Op::Mul || op == Op::Mac);
+                if constexpr (wide_mul) {
+                    return 0;
+                } else {
+                    __m128i vb = Broadcast
+                        ? (sizeof(S) == 2 ? _mm_set1_epi16(static_cast<short>(*b)) : _mm_set1_epi32(static_cast<int>(*b)))
+                        : _mm_setzero_si128();
+                    std::size_t i = 0;
+                    for (; i + lanes <= n; i += lanes) {
+                        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                        if constexpr (!Broadcast) vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+                        __m128i r;
+                        if constexpr (sizeof(S) == 2) {
+                            if constexpr (op == Op::Add) r = add16<Wrap>(va, vb);
+                            else if constexpr (op == Op::Sub) r = sub16<Wrap>(va, vb);
+                            else if constexpr (op == Op::Mul) r = mul16<Wrap, F>(va, vb);
+                            else r = add16<Wrap>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(out + i)),
+                                                 mul16<Wrap, F>(va, vb));
+                        } else {
+                            if constexpr (op == Op::Add) r = add32<Wrap>(va, vb);
+                            else r = sub32<Wrap>(va, vb);
+                        }
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+                    }
+                    return i;
+                }
+            }
+
+            template<bool Wrap, typename S>
+            FIXED_POINT_TARGET("sse4.1") inline __m128i add_n(__m128i a, __m128i b) {
+                if constexpr (sizeof(S) == 2) return add16<Wrap>(a, b);
+                else return add32<Wrap>(a, b);
+            }
+
+            template<bool Wrap, typename S>
+            FIXED_POINT_TARGET("sse4.1") inline __m128i sub_n(__m128i a, __m128i b) {
+                if constexpr (sizeof(S) == 2) return sub16<Wrap>(a, b);
+                else return sub32<Wrap>(a, b);
+            }
+
+            // Split-complex radix-2 butterflies; 32-bit twiddle multiplies stay scalar (see above)
+            template<Twiddle T, bool Wrap, int F, typename S>
+            FIXED_POINT_TARGET("sse4.1")
+            std::size_t butterfly(S* ur, S* ui, S* xr, S* xi, const S* wr, const S* wi, std::size_t n) {
+                constexpr bool wide_mul = sizeof(S) == 4 && (T == Twiddle::Table || T == Twiddle::Broadcast);
+                if constexpr (wide_mul) {
+                    return 0;
+                } else {
+                    constexpr std::size_t lanes = 16 / sizeof(S);
+                    __m128i vwr = _mm_setzero_si128(), vwi = _mm_setzero_si128();
+                    if constexpr (T == Twiddle::Broadcast) {
+                        vwr = _mm_set1_epi16(static_cast<short>(*wr));
+                        vwi = _mm_set1_epi16(static_cast<short>(*wi));
+                    }
+                    std::size_t i = 0;
+                    for (; i + lanes <= n; i += lanes) {
+                        __m128i vur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ur + i));
+                        __m128i vui = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ui + i));
+                        __m128i vxr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(xr + i));
+                        __m128i vxi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(xi + i));
+                        __m128i vr, vi;
+                        if constexpr (T == Twiddle::One) {
+                            vr = vxr;
+                            vi = vxi;
+                        } else if constexpr (T == Twiddle::MinusJ) {
+                            vr = vxi;
+                            vi = sub_n<Wrap, S>(_mm_setzero_si128(), vxr);
+                        } else {
+                            if constexpr (T == Twiddle::Table) {
+                                vwr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(wr + i));
+                                vwi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(wi + i));
+                            }
+                            vr = sub16<Wrap>(mul16<Wrap, F>(vxr, vwr), mul16<Wrap, F>(vxi, vwi));
+                            vi = add16<Wrap>(mul16<Wrap, F>(vxr, vwi), mul16<Wrap, F>(vxi, vwr));
+                        }
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(ur + i), add_n<Wrap, S>(vur, vr));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(ui + i), add_n<Wrap, S>(vui, vi));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(xr + i), sub_n<Wrap, S>(vur, vr));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(xi + i), sub_n<Wrap, S>(vui, vi));
+                    }
+                    return i;
+                }
+            }
+
+        } // namespace sse41
+
+        // ----------------- AVX2 (16 x int16 / 8 x int32) -----------------
+        namespace avx2 {
+
+            template<bool Wrap>
+            FIXED_POINT_TARGET("avx2") inline __m256i add16(__m256i a, __m256i b) {
+                __m256i s = _mm256_adds_epi16(a, b);
+                if constexpr (!Wrap) return s;
+                __m256i same = _mm256_cmpeq_epi16(s, _mm256_add_epi16(a, b));
+                return _mm256_xor_si256(_mm256_xor_si256(s, _mm256_set1_epi32(-1)), same);
+            }
+
+            template<bool Wrap>
+            FIXED_POINT_TARGET("avx2") inline __m256i sub16(__m256i a, __m256i b) {
+                __m256i s = _mm256_subs_epi16(a, b);
+                if constexpr (!Wrap) return s;
+                __m256i same = _mm256_cmpeq_epi16(s, _mm256_sub_epi16(a, b));
+                return _mm256_xor_si256(_mm256_xor_si256(s, _mm256_set1_epi32(-1)), same);
+            }
+
+            template<bool Wrap, int F>
+            FIXED_POINT_TARGET("avx2") inline __m256i mul16(__m256i a, __m256i b) {
+                // unpack/pack both work per 128-bit lane, so element order round-trips
+                __m256i lo = _mm256_mullo_epi16(a, b);
+                __m256i hi = _mm256_mulhi_epi16(a, b);
+                __m256i r0 = _mm256_srai_epi32(_mm256_unpacklo_epi16(lo, hi), F);
+                __m256i r1 = _mm256_srai_epi32(_mm256_unpackhi_epi16(lo, hi), F);
+                __m256i s = _mm256_packs_epi32(r0, r1);
+                if constexpr (!Wrap) return s;
+                __m256i max = _mm256_set1_epi32(INT16_MAX), min = _mm256_set1_epi32(INT16_MIN);
+                __m256i o0 = _mm256_or_si256(_mm256_cmpgt_epi32(r0, max), _mm256_cmpgt_epi32(min, r0));
+                __m256i o1 = _mm256_or_si256(_mm256_cmpgt_epi32(r1, max), _mm256_cmpgt_epi32(min, r1));
+                return _mm256_xor_si256(s, _mm256_packs_epi32(o0, o1));
+            }
+
+            template<bool Wrap>
+            FIXED_POINT_TARGET("avx2") inline __m256i add32(__m256i a, __m256i b) {
+                __m256i r = _mm256_add_epi32(a, b);
+                __m256i ovf = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(a, r), _mm256_xor_si256(b, r)), 31);
+                __m256i sat = _mm256_xor_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32(Wrap ? INT32_MIN : INT32_MAX));
+                return _mm256_blendv_epi8(r, sat, ovf);
+            }
+
+            template<bool Wrap>
+            FIXED_POINT_TARGET("avx2") inline __m256i sub32(__m256i a, __m256i b) {
+                __m256i r = _mm256_sub_epi32(a, b);
+                __m256i ovf = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, r)), 31);
+                __m256i sat = _mm256_xor_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32(Wrap ? INT32_MIN : INT32_MAX));
+                return _mm256_blendv_epi8(r, sat, ovf);
+            }
+
+            // 4 widening 32x32->64 products in the even lanes, shifted and clamped to int32
+            template<bool Wrap, int F>
+            FIXED_POINT_TARGET("avx2") inline __m256i mul32_even(__m256i a, __m256i b) {
+                __m256i p = _mm256_mul_epi32(a, b);
+                __m256i r = p;
+                if constexpr (F > 0) {
+                    // arithmetic 64-bit shift (no vpsraq before AVX-512)
+                    __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), p);
+                    r = _mm256_or_si256(_mm256_srli_epi64(p, F), _mm256_slli_epi64(sign, 64 - F));
+                }
+                __m256i max = _mm256_set1_epi64x(INT32_MAX), min = _mm256_set1_epi64x(INT32_MIN);
+                __m256i gt = _mm256_cmpgt_epi64(r, max);
+                __m256i lt = _mm256_cmpgt_epi64(min, r);
+                __m256i s = _mm256_blendv_epi8(_mm256_blendv_epi8(r, max, gt), min, lt);
+                if constexpr (Wrap) s = _mm256_xor_si256(s, _mm256_or_si256(gt, lt));
+                return s;
+            }
+
+            template<bool Wrap, int F>
+            FIXED_POINT_TARGET("avx2") inline __m256i mul32(__m256i a, __m256i b) {
+                __m256i even = mul32_even<Wrap, F>(a, b);
+                __m256i odd = mul32_even<Wrap, F>(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+                return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+            }
+
+            template<Op op, bool Wrap, int F, bool Broadcast, typename S>
+            FIXED_POINT_TARGET("avx2")
+            std::size_t run(const S* a, const S* b, S* out, std::size_t n) {
+                constexpr std::size_t lanes = 32 / sizeof(S);
+                __m256i vb = Broadcast
+                    ? (sizeof(S) == 2 ? _mm256_set1_epi16(static_cast<short>(*b)) : _mm256_set1_epi32(static_cast<int>(*b)))
+                    : _mm256_setzero_si256();
+                std::size_t i = 0;
+                for (; i + lanes <= n; i += lanes) {
+                    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                    if constexpr (!Broadcast) vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                    __m256i r;
+                    if constexpr (sizeof(S) == 2) {
+                        if constexpr (op == Op::Add) r = add16<Wrap>(va, vb);
+                        else if constexpr (op == Op::Sub) r = sub16<Wrap>(va, vb);
+                        else if constexpr (op == Op::Mul) r = mul16<Wrap, F>(va, vb);
+                        else r = add16<Wrap>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + i)),
+                                             mul16<Wrap, F>(va, vb));
+                    } else {
+                        if constexpr (op == Op::Add) r = add32<Wrap>(va, vb);
+                        else if constexpr (op == Op::Sub) r = sub32<Wrap>(va, vb);
+                        else if constexpr (op == Op::Mul) r = mul32<Wrap, F>(va, vb);
+                        else r = add32<Wrap>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + i)),
+                                             mul32<Wrap, F>(va, vb));
+                    }
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+                }
+                return i;
+            }
+
+            template<bool Wrap, typename S>
+            FIXED_POINT_TARGET("avx2") inline __m256i add_n(__m256i a, __m256i b) {
+                if constexpr (sizeof(S) == 2) return add16<Wrap>(a, b);
+                else return add32<Wrap>(a, b);
+            }
+
+            template<bool Wrap, typename S>
+            FIXED_POINT_TARGET("avx2") inline __m256i sub_n(__m256i a, __m256i b) {
+                if constexpr (sizeof(S) == 2) return sub16<Wrap>(a, b);
+                else return sub32<Wrap>(a, b);
+            }
+
+            template<bool Wrap, int F, typename S>
+            FIXED_POINT_TARGET("avx2") inline __m256i mul_n(__m256i a, __m256i b) {
+                if constexpr (sizeof(S) == 2) return mul16<Wrap, F>(a, b);
+                else return mul32<Wrap, F>(a, b);
+            }
+
+            // Split-complex radix-2 butterflies: u += x*w and x = u - x*w on lanes of re/im arrays
+            template<Twiddle T, bool Wrap, int F, typename S>
+            FIXED_POINT_TARGET("avx2")
+            std::size_t butterfly(S* ur, S* ui, S* xr, S* xi, const S* wr, const S* wi, std::size_t n) {
+                constexpr std::size_t lanes = 32 / sizeof(S);
+                __m256i vwr = _mm256_setzero_si256(), vwi = _mm256_setzero_si256();
+                if constexpr (T == Twiddle::Broadcast) {
+                    vwr = sizeof(S) == 2 ? _mm256_set1_epi16(static_cast<short>(*wr)) : _mm256_set1_epi32(static_cast<int>(*wr));
+                    vwi = sizeof(S) == 2 ? _mm256_set1_epi16(static_cast<short>(*wi)) : _mm256_set1_epi32(static_cast<int>(*wi));
+                }
+                std::size_t i = 0;
+                for (; i + lanes <= n; i += lanes) {
+                    __m256i vur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ur + i));
+                    __m256i vui = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ui + i));
+                    __m256i vxr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xr + i));
+                    __m256i vxi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xi + i));
+                    __m256i vr, vi;
+                    if constexpr (T == Twiddle::One) {
+                        vr = vxr;
+                        vi = vxi;
+                    } else if constexpr (T == Twiddle::MinusJ) {
+                        vr = vxi;
+                        vi = sub_n<Wrap, S>(_mm256_setzero_si256(), vxr);
+                    } else {
+                        if constexpr (T == Twiddle::Table) {
+                            vwr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(wr + i));
+                            vwi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(wi + i));
+                        }
+                        vr = sub_n<Wrap, S>(mul_n<Wrap, F, S>(vxr, vwr), mul_n<Wrap, F, S>(vxi, vwi));
+                        vi = add_n<Wrap, S>(mul_n<Wrap, F, S>(vxr, vwi), mul_n<Wrap, F, S>(vxi, vwr));
+                    }
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(ur + i), add_n<Wrap, S>(vur, vr));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(ui + i), add_n<Wrap, S>(vui, vi));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(xr + i), sub_n<Wrap, S>(vur, vr));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(xi + i), sub_n<Wrap, S>(vui, vi));
+                }
+                return i;
+            }
+
+        } // namespace avx2
+
+        // ----------------- AVX-512 F+BW (32 x int16 / 16 x int32) -----------------
+        namespace avx512 {
+
+            template<bool Wrap>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline __m512i add16(__m512i a, __m512i b) {
+                __m512i s = _mm512_adds_epi16(a, b);
+                if constexpr (!Wrap) return s;
+                __mmask32 ovf = _mm512_cmpneq_epi16_mask(s, _mm512_add_epi16(a, b));
+                return _mm512_mask_blend_epi16(ovf, s, _mm512_ternarylogic_epi32(s, s, s, 0x55));
+            }
+
+            template<bool Wrap>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline __m512i sub16(__m512i a, __m512i b) {
+                __m512i s = _mm512_subs_epi16(a, b);
+                if constexpr (!Wrap) return s;
+                __mmask32 ovf = _mm512_cmpneq_epi16_mask(s, _mm512_sub_epi16(a, b));
+                return _mm512_mask_blend_epi16(ovf, s, _mm512_ternarylogic_epi32(s, s, s, 0x55));
+            }
+
+            template<bool Wrap, int F>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline __m512i mul16(__m512i a, __m512i b) {
+                __m512i lo = _mm512_mullo_epi16(a, b);
+                __m512i hi = _mm512_mulhi_epi16(a, b);
+                __m512i r0 = _mm512_srai_epi32(_mm512_unpacklo_epi16(lo, hi), F);
+                __m512i r1 = _mm512_srai_epi32(_mm512_unpackhi_epi16(lo, hi), F);
+                __m512i s = _mm512_packs_epi32(r0, r1);
+                if constexpr (!Wrap) return s;
+                __m512i max = _mm512_set1_epi32(INT16_MAX), min = _mm512_set1_epi32(INT16_MIN);
+                __m512i ones = _mm512_set1_epi32(-1);
+                __m512i o0 = _mm512_maskz_mov_epi32(_mm512_cmpgt_epi32_mask(r0, max) | _mm512_cmpgt_epi32_mask(min, r0), ones);
+                __m512i o1 = _mm512_maskz_mov_epi32(_mm512_cmpgt_epi32_mask(r1, max) | _mm512_cmpgt_epi32_mask(min, r1), ones);
+                return _mm512_xor_si512(s, _mm512_packs_epi32(o0, o1));
+            }
+
+            template<bool Wrap>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline __m512i add32(__m512i a, __m512i b) {
+                __m512i r = _mm512_add_epi32(a, b);
+                __mmask16 ovf = _mm512_cmplt_epi32_mask(_mm512_and_si512(_mm512_xor_si512(a, r), _mm512_xor_si512(b, r)),
+                                                        _mm512_setzero_si512());
+                __m512i sat = _mm512_xor_si512(_mm512_srai_epi32(a, 31), _mm512_set1_epi32(Wrap ? INT32_MIN : INT32_MAX));
+                return _mm512_mask_blend_epi32(ovf, r, sat);
+            }
+
+            template<bool Wrap>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline __m512i sub32(__m512i a, __m512i b) {
+                __m512i r = _mm512_sub_epi32(a, b);
+                __mmask16 ovf = _mm512_cmplt_epi32_mask(_mm512_and_si512(_mm512_xor_si512(a, b), _mm512_xor_si512(a, r)),
+                                                        _mm512_setzero_si512());
+                __m512i sat = _mm512_xor_si512(_mm512_srai_epi32(a, 31), _mm512_set1_epi32(Wrap ? INT32_MIN : INT32_MAX));
+                return _mm512_mask_blend_epi32(ovf, r, sat);
+            }
+
+            template<bool Wrap, int F>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline __m512i mul32_even(__m512i a, __m512i b) {
+                __m512i r = _mm512_srai_epi64(_mm512_mul_epi32(a, b), F);
+                __m512i s = _mm512_min_epi64(_mm512_max_epi64(r, _mm512_set1_epi64(INT32_MIN)),
+                                             _mm512_set1_epi64(INT32_MAX));
+                if constexpr (Wrap) {
+                    __mmask8 ovf = _mm512_cmpneq_epi64_mask(r, s);
+                    s = _mm512_mask_ternarylogic_epi64(s, ovf, s, s, 0x55);
+                }
+                return s;
+            }
+
+            template<bool Wrap, int F>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline __m512i mul32(__m512i a, __m512i b) {
+                __m512i even = mul32_even<Wrap, F>(a, b);
+                __m512i odd = mul32_even<Wrap, F>(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+                return _mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32));
+            }
+
+            template<Op op, bool Wrap, int F, bool Broadcast, typename S>
+            FIXED_POINT_TARGET("avx512f,avx512bw")
+            std::size_t run(const S* a, const S* b, S* out, std::size_t n) {
+                constexpr std::size_t lanes = 64 / sizeof(S);
+                __m512i vb = Broadcast
+                    ? (sizeof(S) == 2 ? _mm512_set1_epi16(static_cast<short>(*b)) : _mm512_set1_epi32(static_cast<int>(*b)))
+                    : _mm512_setzero_si512();
+                std::size_t i = 0;
+                for (; i + lanes <= n; i += lanes) {
+                    __m512i va = _mm512_loadu_si512(a + i);
+                    if constexpr (!Broadcast) vb = _mm512_loadu_si512(b + i);
+                    __m512i r;
+                    if constexpr (sizeof(S) == 2) {
+                        if constexpr (op == Op::Add) r = add16<Wrap>(va, vb);
+                        else if constexpr (op == Op::Sub) r = sub16<Wrap>(va, vb);
+                        else if constexpr (op == Op::Mul) r = mul16<Wrap, F>(va, vb);
+                        else r = add16<Wrap>(_mm512_loadu_si512(out + i), mul16<Wrap, F>(va, vb));
+                    } else {
+                        if constexpr (op == Op::Add) r = add32<Wrap>(va, vb);
+                        else if constexpr (op == Op::Sub) r = sub32<Wrap>(va, vb);
+                        else if constexpr (op == Op::Mul) r = mul32<Wrap, F>(va, vb);
+                        else r = add32<Wrap>(_mm512_loadu_si512(out + i), mul32<Wrap, F>(va, vb));
+                    }
+                    _mm512_storeu_si512(out + i, r);
+                }
+                return i;
+            }
+
+            template<bool Wrap, typename S>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline __m512i add_n(__m512i a, __m512i b) {
+                if constexpr (sizeof(S) == 2) return add16<Wrap>(a, b);
+                else return add32<Wrap>(a, b);
+            }
+
+            template<bool Wrap, typename S>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline __m512i sub_n(__m512i a, __m512i b) {
+                if constexpr (sizeof(S) == 2) return sub16<Wrap>(a, b);
+                else return sub32<Wrap>(a, b);
+            }
+
+            template<bool Wrap, int F, typename S>
+            FIXED_POINT_TARGET("avx512f,avx512bw") inline __m512i mul_n(__m512i a, __m512i b) {
+                if constexpr (sizeof(S) == 2) return mul16<Wrap, F>(a, b);
+                else return mul32<Wrap, F>(a, b);
+            }
+
+            template<Twiddle T, bool Wrap, int F, typename S>
+            FIXED_POINT_TARGET("avx512f,avx512bw")
+            std::size_t butterfly(S* ur, S* ui, S* xr, S* xi, const S* wr, const S* wi, std::size_t n) {
+                constexpr std::size_t lanes = 64 / sizeof(S);
+                __m512i vwr = _mm512_setzero_si512(), vwi = _mm512_setzero_si512();
+                if constexpr (T == Twiddle::Broadcast) {
+                    vwr = sizeof(S) == 2 ? _mm512_set1_epi16(static_cast<short>(*wr)) : _mm512_set1_epi32(static_cast<int>(*wr));
+                    vwi = sizeof(S) == 2 ? _mm512_set1_epi16(static_cast<short>(*wi)) : _mm512_set1_epi32(static_cast<int>(*wi));
+                }
+                std::size_t i = 0;
+                for (; i + lanes <= n; i += lanes) {
+                    __m512i vur = _mm512_loadu_si512(ur + i);
+                    __m512i vui = _mm512_loadu_si512(ui + i);
+                    __m512i vxr = _mm512_loadu_si512(xr + i);
+                    __m512i vxi = _mm512_loadu_si512(xi + i);
+                    __m512i vr, vi;
+                    if constexpr (T == Twiddle::One) {
+                        vr = vxr;
+                        vi = vxi;
+                    } else if constexpr (T == Twiddle::MinusJ) {
+                        vr = vxi;
+                        vi = sub_n<Wrap, S>(_mm512_setzero_si512(), vxr);
+                    } else {
+                        if constexpr (T == Twiddle::Table) {
+                            vwr = _mm512_loadu_si512(wr + i);
+                            vwi = _mm512_loadu_si512(wi + i);
+                        }
+                        vr = sub_n<Wrap, S>(mul_n<Wrap, F, S>(vxr, vwr), mul_n<Wrap, F, S>(vxi, vwi));
+                        vi = add_n<Wrap, S>(mul_n<Wrap, F, S>(vxr, vwi), mul_n<Wrap, F, S>(vxi, vwr));
+                    }
+                    _mm512_storeu_si512(ur + i, add_n<Wrap, S>(vur, vr));
+                    _mm512_storeu_si512(ui + i, add_n<Wrap, S>(vui, vi));
+                    _mm512_storeu_si512(xr + i, sub_n<Wrap, S>(vur, vr));
+                    _mm512_storeu_si512(xi + i, sub_n<Wrap, S>(vui, vi));
+                }
+                return i;
+            }
+
+        } // namespace avx512
+
+#endif // FIXED_POINT_SIMD_X86
+
+        // Scalar reference: exactly the FixedPoint operators
+        template<Op op, typename Fixed>
+        void run_scalar(const Fixed* a, const Fixed* b, Fixed* out,
+                        std::size_t begin, std::size_t n, bool broadcast) {
+            for (std::size_t i = begin; i < n; ++i) {
+                const Fixed& rhs = broadcast ? *b : b[i];
+                if constexpr (op == Op::Add) out[i] = a[i] + rhs;
+                else if constexpr (op == Op::Sub) out[i] = a[i] - rhs;
+                else if constexpr (op == Op::Mul) out[i] = a[i] * rhs;
+                else out[i] += a[i] * rhs;
+            }
+        }
+
+        template<Op op, bool Broadcast, typename Fixed>
+        void dispatch(const Fixed* a, const Fixed* b, Fixed* out, std::size_t n) {
+            std::size_t done = 0;
+#if FIXED_POINT_SIMD_X86
+            using Traits = batch_traits<Fixed>;
+            if constexpr (Traits::vectorizable) {
+                using S = typename Traits::S;
+                constexpr bool Wrap = Traits::wrap;
+                constexpr int F = Traits::F;
+                auto sa = reinterpret_cast<const S*>(a);
+                auto sb = reinterpret_cast<const S*>(b);
+                auto so = reinterpret_cast<S*>(out);
+                switch (active_level()) {
+                    case SimdLevel::AVX512: done = avx512::run<op, Wrap, F, Broadcast>(sa, sb, so, n); break;
+                    case SimdLevel::AVX2:   done = avx2::run<op, Wrap, F, Broadcast>(sa, sb, so, n);   break;
+                    case SimdLevel::SSE41:  done = sse41::run<op, Wrap, F, Broadcast>(sa, sb, so, n);  break;
+                    default: break;
+                }
+            }
+#endif
+            run_scalar<op>(a, b, out, done, n, Broadcast);
+        }
+
+        template<Twiddle T, typename Fixed>
+        void butterfly_scalar(Fixed* ur, Fixed* ui, Fixed* xr, Fixed* xi, const Fixed* wr, const Fixed* wi,
+                              std::size_t begin, std::size_t n) {
+            for (std::size_t i = begin; i < n; ++i) {
+                Fixed vr, vi;
+                if constexpr (T == Twiddle::One) {
+                    vr = xr[i];
+                    vi = xi[i];
+                } else if constexpr (T == Twiddle::MinusJ) {
+                    vr = xi[i];
+                    vi = -xr[i];
+                } else {
+                    const Fixed& w_r = T == Twiddle::Table ? wr[i] : *wr;
+                    const Fixed& w_i = T == Twiddle::Table ? wi[i] : *wi;
+                    vr = xr[i] * w_r - xi[i] * w_i;
+                    vi = xr[i] * w_i + xi[i] * w_r;
+                }
+                Fixed u_r = ur[i], u_i = ui[i];
+                ur[i] = u_r + vr;
+                ui[i] = u_i + vi;
+                xr[i] = u_r - vr;
+                xi[i] = u_i - vi;
+            }
+        }
+
+        // Widest kernel first, then narrower ones on what is left, so short FFT stages still vectorize
+        template<Twiddle T, typename Fixed>
+        void butterfly_dispatch(Fixed* ur, Fixed* ui, Fixed* xr, Fixed* xi, const Fixed* wr, const Fixed* wi,
+                                std::size_t n) {
+            std::size_t done = 0;
+#if FIXED_POINT_SIMD_X86
+            using Traits = batch_traits<Fixed>;
+            if constexpr (Traits::vectorizable) {
+                using S = typename Traits::S;
+                constexpr bool Wrap = Traits::wrap;
+                constexpr int F = Traits::F;
+                // Broadcast twiddles stay at element 0
+                constexpr bool table = T == Twiddle::Table;
+                auto r = [&](auto* p) { return reinterpret_cast<S*>(p) + done; };
+                auto c = [&](const auto* p) { return reinterpret_cast<const S*>(p) + (table ? done : 0); };
+                SimdLevel level = active_level();
+                if (level >= SimdLevel::AVX512) done += avx512::butterfly<T, Wrap, F>(r(ur), r(ui), r(xr), r(xi), c(wr), c(wi), n - done);
+                if (level >= SimdLevel::AVX2)   done += avx2::butterfly<T, Wrap, F>(r(ur), r(ui), r(xr), r(xi), c(wr), c(wi), n - done);
+                if (level >= SimdLevel::SSE41)  done += sse41::butterfly<T, Wrap, F>(r(ur), r(ui), r(xr), r(xi), c(wr), c(wi), n - done);
+            }
+#endif
+            butterfly_scalar<T>(ur, ui, xr, xi, wr, wi, done, n);
+        }
+
+        inline void check_butterfly_sizes(std::size_t n, std::size_t ui, std::size_t xr, std::size_t xi) {
+            if (ui != n || xr != n || xi != n) {
+                throw std::invalid_argument("Batch operands must have the same size");
+            }
+        }
+
+        inline void check_sizes(std::size_t a, std::size_t b, std::size_t out) {
+            if (a != out || b != out) {
+                throw std::invalid_argument("Batch operands must have the same size");
+            }
+        }
+
+    } // namespace detail
+
+    // out[i] = a[i] + b[i]
+    template<typename Fixed>
+    void add(std::span<const Fixed> a, std::span<const Fixed> b, std::span<Fixed> out) {
+        detail::check_sizes(a.size(), b.size(), out.size());
+        detail::dispatch<detail::Op::Add, false>(a.data(), b.data(), out.data(), out.size());
+    }
+
+    // out[i] = a[i] - b[i]
+    template<typename Fixed>
+    void sub(std::span<const Fixed> a, std::span<const Fixed> b, std::span<Fixed> out) {
+        detail::check_sizes(a.size(), b.size(), out.size());
+        detail::dispatch<detail::Op::Sub, false>(a.data(), b.data(), out.data(), out.size());
+    }
+
+    // out[i] = a[i] * b[i]
+    template<typename Fixed>
+    void mul(std::span<const Fixed> a, std::span<const Fixed> b, std::span<Fixed> out) {
+        detail::check_sizes(a.size(), b.size(), out.size());
+        detail::dispatch<detail::Op::Mul, false>(a.data(), b.data(), out.data(), out.size());
+    }
+
+    // acc[i] += a[i] * b[i]  (policy applied after the multiply and after the add, like the scalar operators)
+    template<typename Fixed>
+    void mac(std::span<const Fixed> a, std::span<const Fixed> b, std::span<Fixed> acc) {
+        detail::check_sizes(a.size(), b.size(), acc.size());
+        detail::dispatch<detail::Op::Mac, false>(a.data(), b.data(), acc.data(), acc.size());
+    }
+
+    // out[i] = a[i] * k
+    template<typename Fixed>
+    void scale(std::span<const Fixed> a, Fixed k, std::span<Fixed> out) {
+        detail::check_sizes(a.size(), out.size(), out.size());
+        detail::dispatch<detail::Op::Mul, true>(a.data(), &k, out.data(), out.size());
+    }
+
+    // Split-complex radix-2 butterflies, the inner loop of an FFT on separate re/im arrays:
+    //   v = (xr + j*xi) * (wr + j*wi),  (ur, ui) = u + v,  (xr, xi) = u - v
+    // with the FixedPoint operators std::complex<Fixed> uses (each product shifted and
+    // overflow-handled, then the sum), so the results are bit-exact with it.
+    template<typename Fixed>
+    void butterfly(std::span<Fixed> ur, std::span<Fixed> ui, std::span<Fixed> xr, std::span<Fixed> xi,
+                   std::span<const Fixed> wr, std::span<const Fixed> wi) {
+        std::size_t n = ur.size();
+        detail::check_butterfly_sizes(n, ui.size(), xr.size(), xi.size());
+        detail::check_butterfly_sizes(n, wr.size(), wi.size(), n);
+        detail::butterfly_dispatch<detail::Twiddle::Table>(ur.data(), ui.data(), xr.data(), xi.data(), wr.data(), wi.data(), n);
+    }
+
+    // Same with one twiddle w = wr + j*wi for every element (e.g. the same butterfly of many transforms)
+    template<typename Fixed>
+    void butterfly(std::span<Fixed> ur, std::span<Fixed> ui, std::span<Fixed> xr, std::span<Fixed> xi, Fixed wr, Fixed wi) {
+        std::size_t n = ur.size();
+        detail::check_butterfly_sizes(n, ui.size(), xr.size(), xi.size());
+        detail::butterfly_dispatch<detail::Twiddle::Broadcast>(ur.data(), ui.data(), xr.data(), xi.data(), &wr, &wi, n);
+    }
+
+    // Trivial twiddles, with no multiply: W = 1 (v = x) ...
+    template<typename Fixed>
+    void butterfly_one(std::span<Fixed> ur, std::span<Fixed> ui, std::span<Fixed> xr, std::span<Fixed> xi) {
+        std::size_t n = ur.size();
+        detail::check_butterfly_sizes(n, ui.size(), xr.size(), xi.size());
+        detail::butterfly_dispatch<detail::Twiddle::One>(ur.data(), ui.data(), xr.data(), xi.data(), xr.data(), xi.data(), n);
+    }
+
+    // ... and W = -j (v = xi - j*xr, negated like the FixedPoint unary minus)
+    template<typename Fixed>
+    void butterfly_minus_j(std::span<Fixed> ur, std::span<Fixed> ui, std::span<Fixed> xr, std::span<Fixed> xi) {
+        std::size_t n = ur.size();
+        detail::check_butterfly_sizes(n, ui.size(), xr.size(), xi.size());
+        detail::butterfly_dispatch<detail::Twiddle::MinusJ>(ur.data(), ui.data(), xr.data(), xi.data(), xr.data(), xi.data(), n);
+    }
+
+} // namespace fixed_point::simd
@@ -0,0 +1,259 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "dsp/block_float.hpp"
+#include "dsp/cfixed.hpp"
+#include "dsp/convolution.hpp"
+#include "dsp/fft.hpp"
+#include "fir/fir_filter.hpp"
+#include "fixed_point/fixed_point.hpp"
+
+using Q15 = FixedPoint<16, 15, SaturationPolicy>;
+using Fixed = FixedPoint<16, 8, SaturationPolicy>;
+using Block = dsp::BlockFloat<Q15>;
+using CBlock = dsp::BlockFloat<dsp::cfixed<Q15>>;
+
+namespace {
+
+    std::vector<std::complex<double>> reference_dft(const std::vector<std::complex<double>>& x) {
+        const std::size_t N = x.size();
+        std::vector<std::complex<double>> X(N);
+        for (std::size_t k = 0; k < N; ++k) {
+            for (std::size_t n = 0; n < N; ++n) {
+                double angle = -2.0 * std::numbers::pi * double(k * n % N) / double(N);
+                X[k] += x[n] * std::polar(1.0, angle);
+            }
+        }
+        return X;
+    }
+
+    TEST(BlockFloatTest, FromValuesUsesFullMantissaRange) {
+        std::vector<double> values{ 300.0, -1000.0, 0.5, 0.0 };
+        auto block = Block::from_values(std::span<const double>(values));
+        EXPECT_EQ(block.headroom(), 0);
+        EXPECT_EQ(block.exponent, 10);  // 1000 / 2^10 < 1
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            EXPECT_NEAR(block.value(i), values[i], std::ldexp(0.5, block.exponent - 15));
+        }
+
+        Block zeros(4);
+        EXPECT_EQ(zeros.headroom(), 15);
+        zeros.normalize();
+        EXPECT_EQ(zeros.exponent, 0);
+    }
+
+    TEST(BlockFloatTest, HeadroomShiftsAreExact) {
+        Block block({ Q15(0.125), Q15(-0.0625), Q15(0.03125) }, 3);
+        EXPECT_EQ(block.headroom(), 2);
+        block.normalize();
+        EXPECT_EQ(block.headroom(), 0);
+        EXPECT_EQ(block.exponent, 1);
+        EXPECT_DOUBLE_EQ(block.value(0), 1.0);
+        EXPECT_DOUBLE_EQ(block.value(1), -0.5);
+
+        block.ensure_headroom(3);
+        EXPECT_EQ(block.headroom(), 3);
+        EXPECT_EQ(block.exponent, 4);
+        EXPECT_DOUBLE_EQ(block.value(2), 0.25);
+
+        block.ensure_headroom(1);  // already has it
+        EXPECT_EQ(block.exponent, 4);
+        block.align_to(6);
+        EXPECT_EQ(block.exponent, 6);
+        EXPECT_DOUBLE_EQ(block.value(0), 1.0);
+    }
+
+    TEST(BlockFloatTest, FFTKeepsPrecisionWhereFixedFormatSaturates) {
+        const std::size_t N = 1024;
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<double> dist(-100.0, 100.0);
+        std::vector<std::complex<double>> x(N);
+        for (auto& v : x) v = { dist(rng), dist(rng) };
+        x[5] += std::complex<double>(90.0, 0.0);
+        auto expected = reference_dft(x);
+
+        // Plain Q8.8: the input fits but the spectrum (up to ~10^4) saturates
+        dsp::FFTPlan<Fixed, dsp::cfixed<Fixed>> fixed_plan(N);
+        std::vector<dsp::cfixed<Fixed>> fixed(N);
+        for (std::size_t n = 0; n < N; ++n) fixed[n] = { Fixed(x[n].real()), Fixed(x[n].imag()) };
+        fixed_plan.forward(fixed);
+        double fixed_err = 0.0, peak = 0.0;
+        for (std::size_t k = 0; k < N; ++k) {
+            fixed_err = std::max(fixed_err, std::abs(std::complex<double>(fixed[k].re.to_double(), fixed[k].im.to_double()) - expected[k]));
+            peak = std::max(peak, std::abs(expected[k]));
+        }
+        EXPECT_GT(fixed_err, 0.5 * peak);
+
+        // Q15 mantissas with a block exponent track it to about 16-bit accuracy of the peak
+        for (auto kernel : { dsp::FFTKernel::Radix2, dsp::FFTKernel::Radix4 }) {
+            dsp::FFTPlan<Q15, dsp::cfixed<Q15>> plan(N, kernel);
+            auto block = CBlock::from_values(std::span<const std::complex<double>>(x));
+            plan.forward(block);
+            double block_err = 0.0;
+            for (std::size_t k = 0; k < N; ++k) {
+                block_err = std::max(block_err, std::abs(block.value(k) - expected[k]));
+            }
+            EXPECT_LT(block_err, 2e-3 * peak) << "kernel=" << int(kernel);
+        }
+
+        dsp::FFTPlan<Q15, dsp::cfixed<Q15>> plan(N);
+        auto block = CBlock::from_values(std::span<const std::complex<double>>(x));
+        plan.forward(block);
+        double block_err = 0.0;
+        for (std::size_t k = 0; k < N; ++k) {
+            block_err = std::max(block_err, std::abs(block.value(k) - expected[k]));
+        }
+        EXPECT_LT(block_err, 2e-3 * peak);
+
+        // The inverse returns the input; 1/N only moves the exponent
+        int before = block.exponent;
+        plan.inverse(block);
+        EXPECT_LE(block.exponent, before - 10 + 1 + 2 * 10);
+        double inv_err = 0.0;
+        for (std::size_t n = 0; n < N; ++n) {
+            inv_err = std::max(inv_err, std::abs(block.value(n) - x[n]));
+        }
+        EXPECT_LT(inv_err, 0.5);
+    }
+
+    TEST(BlockFloatTest, StdComplexBlockFFT) {
+        const std::size_t N = 16;
+        std::vector<std::complex<double>> x(N, { 0.0, 0.0 });
+        x[0] = { 4000.0, 0.0 };
+        dsp::FFTPlan<Q15> plan(N);
+        auto block = dsp::BlockFloat<std::complex<Q15>>::from_values(std::span<const std::complex<double>>(x));
+        plan.forward(block);
+        for (std::size_t k = 0; k < N; ++k) {
+            EXPECT_NEAR(block.value(k).real(), 4000.0, 1.0);
+            EXPECT_NEAR(block.value(k).imag(), 0.0, 1.0);
+        }
+        EXPECT_THROW(dsp::FFTPlan<Q15>(8).forward(block), std::invalid_argument);
+    }
+
+    TEST(BlockFloatTest, LargeDefaultPlanBlockFFT) {
+        // 2^18 std::complex<Q15> points make Auto pick FourStep, whose block transform scales
+        // each sub-transform and gives the spectrum one exponent
+        const std::size_t N = std::size_t(1) << 18, bin = 7;
+        std::vector<std::complex<double>> x(N);
+        for (std::size_t n = 0; n < N; ++n) {
+            x[n] = { 3000.0 * std::cos(2.0 * std::numbers::pi * double(bin * n % N) / double(N)), 0.0 };
+        }
+        dsp::FFTPlan<Q15> plan(N);
+        ASSERT_EQ(plan.kernel, dsp::FFTKernel::FourStep);
+        auto block = dsp::BlockFloat<std::complex<Q15>>::from_values(std::span<const std::complex<double>>(x));
+        auto radix4_block = block;
+        plan.forward(block);
+        dsp::FFTPlan<Q15>(N, dsp::FFTKernel::Radix4).forward(radix4_block);
+        EXPECT_LE(block.exponent, radix4_block.exponent + 1);
+
+        // A real cosine: N/2 * 3000 at +-bin, nothing elsewhere
+        const double peak = 1500.0 * double(N);
+        EXPECT_NEAR(block.value(bin).real(), peak, 1e-3 * peak);
+        EXPECT_NEAR(block.value(N - bin).real(), peak, 1e-3 * peak);
+        EXPECT_LT(std::abs(block.value(bin + 1)), 1e-3 * peak);
+
+        // The spectrum shares one exponent set by its peak, so each bin keeps steps of about
+        // peak / 2^15; the inverse spreads that rounding over every sample (about 1% of 3000 here)
+        plan.inverse(block);
+        double err = 0.0;
+        for (std::size_t n = 0; n < N; n += 97) err = std::max(err, std::abs(block.value(n) - x[n]));
+        EXPECT_LT(err, 60.0);
+    }
+
+    TEST(BlockFloatTest, ConvolveMatchesDoubleReference) {
+        std::vector<double> s{ 1500.0, -700.0, 2500.0, 30.0, -4000.0, 12.5 };
+        std::vector<double> h{ 0.001, 0.5, -0.25 };
+        auto signal = Block::from_values(std::span<const double>(s));
+        auto kernel = Block::from_values(std::span<const double>(h));
+
+        auto y = dsp::convolve(signal, kernel);
+        ASSERT_EQ(y.size(), s.size() + h.size() - 1);
+        EXPECT_LE(y.headroom(), 1);  // rounded once, at full precision
+        double peak = 0.0;
+        for (std::size_t n = 0; n < y.size(); ++n) {
+            double expected = 0.0;
+            for (std::size_t k = 0; k < h.size(); ++k) {
+                if (n >= k && n - k < s.size()) expected += s[n - k] * h[k];
+            }
+            peak = std::max(peak, std::abs(expected));
+            EXPECT_NEAR(y.value(n), expected, 1e-3 * std::abs(expected) + 0.1) << "n=" << n;
+        }
+        EXPECT_GT(peak, 1000.0);
+    }
+
+    TEST(BlockFloatTest, FIRFilterCarriesHistoryAcrossExponents) {
+        constexpr std::size_t Taps = 4;
+        dsp::FIRFilter<Q15, Taps> filter({ Q15(0.5), Q15(0.25), Q15(0.125), Q15(-0.125) });
+        const std::array<double, Taps> c{ 0.5, 0.25, 0.125, -0.125 };
+
+        // A loud block followed by two quiet ones: every block comes out with the right scale
+        std::vector<double> loud{ 5000.0, -3000.0, 1000.0, 8000.0, -2000.0 };
+        std::vector<double> quiet1{ 0.01, -0.02, 0.015, 0.0, 0.005, 0.01, -0.01 };
+        std::vector<double> quiet2{ 0.003, 0.02, -0.015, 0.01, 0.0 };
+        std::vector<double> all = loud;
+        all.insert(all.end(), quiet1.begin(), quiet1.end());
+        all.insert(all.end(), quiet2.begin(), quiet2.end());
+
+        auto y1 = filter.process(Block::from_values(std::span<const double>(loud)));
+        auto y2 = filter.process(Block::from_values(std::span<const double>(quiet1)));
+        auto y3 = filter.process(Block::from_values(std::span<const double>(quiet2)));
+        ASSERT_EQ(y1.size(), loud.size());
+        ASSERT_EQ(y2.size(), quiet1.size());
+
+        auto expected = [&](std::size_t n) {
+            double sum = 0.0;
+            for (std::size_t k = 0; k < Taps; ++k) {
+                if (n >= k) sum += c[k] * all[n - k];
+            }
+            return sum;
+        };
+        // Accurate relative to each block's peak (the first quiet outputs still see the loud history)
+        for (std::size_t n = 0; n < loud.size(); ++n) {
+            EXPECT_NEAR(y1.value(n), expected(n), 1.0) << "n=" << n;
+        }
+        for (std::size_t n = 0; n < quiet1.size(); ++n) {
+            EXPECT_NEAR(y2.value(n), expected(loud.size() + n), 0.1) << "n=" << n;
+        }
+        // Once the history is quiet, the outputs have quiet-signal precision
+        for (std::size_t n = 0; n < quiet2.size(); ++n) {
+            EXPECT_NEAR(y3.value(n), expected(loud.size() + quiet1.size() + n), 1e-6) << "n=" << n;
+        }
+
+        // Blocks shorter than the delay line
+        filter.reset();
+        std::vector<double> a{ 1.0, -2.0 }, b{ 0.25 }, d{ 100.0, 50.0, 1.0 };
+        auto z1 = filter.process(Block::from_values(std::span<const double>(a)));
+        auto z2 = filter.process(Block::from_values(std::span<const double>(b)));
+        auto z3 = filter.process(Block::from_values(std::span<const double>(d)));
+        EXPECT_NEAR(z1.value(1), 0.5 * -2.0 + 0.25 * 1.0, 1e-3);
+        EXPECT_NEAR(z2.value(0), 0.5 * 0.25 + 0.25 * -2.0 + 0.125 * 1.0, 1e-3);
+        EXPECT_NEAR(z3.value(0), 50.0 + 0.25 * 0.25 + 0.125 * -2.0 - 0.125 * 1.0, 1e-2);
+        EXPECT_NEAR(z3.value(2), 0.5 + 12.5 + 12.5 - 0.125 * 0.25, 1e-2);
+
+        filter.reset();
+        auto y4 = filter.process(Block::from_values(std::span<const double>(quiet1)));
+        EXPECT_NEAR(y4.value(0), 0.5 * 0.01, 1e-6);
+    }
+
+    TEST(BlockFloatTest, FIRFilterExponentGapBeyondShiftWidth) {
+        // A block of 1e-30 (exponent -106) then one of 1.0 (exponent -6): the history products sit
+        // about 100 bits below the new sum and only round to zero
+        dsp::FIRFilter<Q15, 4> filter({ Q15(0.5), Q15(0.25), Q15(0.125), Q15(-0.125) });
+        std::vector<double> tiny(4, 1e-30), one(4, 1.0);
+        filter.process(Block::from_values(std::span<const double>(tiny)));
+        auto y2 = filter.process(Block::from_values(std::span<const double>(one)));
+        EXPECT_NEAR(y2.value(0), 0.5, 1e-4);
+        EXPECT_NEAR(y2.value(3), 0.75, 1e-4);
+
+        // And back: the loud history is far above the quiet block
+        auto y3 = filter.process(Block::from_values(std::span<const double>(tiny)));
+        EXPECT_NEAR(y3.value(0), 0.25, 1e-4);
+    }
+
+}  // namespace
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "dsp/cfixed.hpp"
+#include "dsp/dft.hpp"
+#include "dsp/fft.hpp"
+#include "fixed_point/fixed_point.hpp"
+
+using Fixed = FixedPoint<16, 8, SaturationPolicy>;
+using CF = dsp::cfixed<Fixed>;
+
+namespace {
+
+    static_assert(sizeof(CF) == 2 * sizeof(Fixed));
+    static_assert(std::is_standard_layout_v<CF>);
+    static_assert(offsetof(CF, im) == sizeof(Fixed));
+
+    CF random_cf(std::mt19937& rng, double range) {
+        std::uniform_real_distribution<double> dist(-range, range);
+        return { Fixed(dist(rng)), Fixed(dist(rng)) };
+    }
+
+    TEST(CFixedTest, MultiplyRoundsOnceFromExactProducts) {
+        std::mt19937 rng(1);
+        for (int i = 0; i < 5000; ++i) {
+            CF a = random_cf(rng, 8.0), b = random_cf(rng, 8.0);
+            double ar = a.re.to_double(), ai = a.im.to_double(), br = b.re.to_double(), bi = b.im.to_double();
+            CF p = a * b;
+            // Exact up to the final rounding: within half an LSB
+            ASSERT_NEAR(p.re.to_double(), ar * br - ai * bi, 0.5 / 256 + 1e-12);
+            ASSERT_NEAR(p.im.to_double(), ar * bi + ai * br, 0.5 / 256 + 1e-12);
+            // The 3-multiply form gives identical bits
+            CF q = dsp::mul3(a, b);
+            ASSERT_EQ(q, p);
+        }
+    }
+
+    TEST(CFixedTest, MultiplySaturatesOnlyTheFinalResult) {
+        // a.re*b.re and a.im*b.im are both out of range, their difference is not
+        CF a{ Fixed(100.0), Fixed(100.0) }, b{ Fixed(1.5), Fixed(1.5) };
+        CF p = a * b;
+        EXPECT_EQ(p.re.raw(), 0);
+        EXPECT_EQ(p.im.raw(), std::numeric_limits<int16_t>::max());
+
+        using Q16 = FixedPoint<32, 16, WrapAroundPolicy>;
+        dsp::cfixed<Q16> c{ Q16(3000.0), Q16(-2000.0) }, d{ Q16(0.25), Q16(2.0) };
+        EXPECT_EQ(c * d, dsp::mul3(c, d));
+        EXPECT_DOUBLE_EQ((c * d).re.to_double(), 4750.0);
+        EXPECT_DOUBLE_EQ((c * d).im.to_double(), 5500.0);
+    }
+
+    TEST(CFixedTest, ConjAndMulJ) {
+        CF z{ Fixed(1.5), Fixed(-2.25) };
+        EXPECT_EQ(dsp::conj(z), (CF{ Fixed(1.5), Fixed(2.25) }));
+        EXPECT_EQ(dsp::mul_j(z), (CF{ Fixed(2.25), Fixed(1.5) }));
+        EXPECT_EQ(dsp::mul_neg_j(z), (CF{ Fixed(-2.25), Fixed(-1.5) }));
+        EXPECT_EQ(dsp::mul_j(z), z * CF(Fixed(0.0), Fixed(1.0)));
+    }
+
+    TEST(CFixedTest, FFTMatchesStdComplexPath) {
+        const std::size_t N = 64;
+        std::mt19937 rng(2);
+        std::vector<CF> x(N);
+        for (auto& v : x) v = random_cf(rng, 1.0);
+        auto x_std = dsp::to_std_complex(x);
+
+        dsp::FFTPlan<Fixed, CF> plan(N);
+        dsp::FFTPlan<Fixed> plan_std(N);
+        auto X = x;
+        plan.forward(X);
+        plan_std.forward(x_std);
+        for (std::size_t k = 0; k < N; ++k) {
+            EXPECT_NEAR(X[k].re.to_double(), x_std[k].real().to_double(), 0.1) << "k=" << k;
+            EXPECT_NEAR(X[k].im.to_double(), x_std[k].imag().to_double(), 0.1) << "k=" << k;
+        }
+
+        plan.inverse(X);
+        for (std::size_t n = 0; n < N; ++n) {
+            EXPECT_NEAR(X[n].re.to_double(), x[n].re.to_double(), 0.02) << "n=" << n;
+            EXPECT_NEAR(X[n].im.to_double(), x[n].im.to_double(), 0.02) << "n=" << n;
+        }
+    }
+
+    TEST(CFixedTest, DftIdftRoundTrip) {
+        std::vector<CF> x{ { Fixed(1.0), Fixed(0.0) }, { Fixed(0.5), Fixed(-0.5) },
+                           { Fixed(-1.0), Fixed(0.25) }, { Fixed(0.0), Fixed(2.0) } };
+        auto X = dsp::dft(x);
+        EXPECT_NEAR(X[0].re.to_double(), 0.5, 0.01);
+        EXPECT_NEAR(X[0].im.to_double(), 1.75, 0.01);
+        auto y = dsp::idft(X);
+        for (std::size_t n = 0; n < x.size(); ++n) {
+            EXPECT_NEAR(y[n].re.to_double(), x[n].re.to_double(), 0.02);
+            EXPECT_NEAR(y[n].im.to_double(), x[n].im.to_double(), 0.02);
+        }
+    }
+
+    TEST(CFixedTest, BulkConversions) {
+        std::vector<std::complex<float>> in{ { 1.5f, -0.25f }, { 127.0f, -200.0f }, { 0.00390625f, 3.0f } };
+        std::vector<CF> out(in.size());
+        dsp::quantize(std::span<const std::complex<float>>(in), std::span<CF>(out));
+        EXPECT_EQ(out[0], (CF{ Fixed(1.5), Fixed(-0.25) }));
+        EXPECT_EQ(out[1].im.raw(), std::numeric_limits<int16_t>::min());
+        EXPECT_EQ(out[2].re.raw(), 1);
+
+        std::vector<std::complex<double>> back(out.size());
+        dsp::dequantize(std::span<const CF>(out), std::span<std::complex<double>>(back));
+        EXPECT_DOUBLE_EQ(back[0].real(), 1.5);
+        EXPECT_DOUBLE_EQ(back[2].imag(), 3.0);
+
+        std::vector<CF> wrong(2);
+        EXPECT_THROW(dsp::quantize(std::span<const std::complex<float>>(in), std::span<CF>(wrong)), std::invalid_argument);
+    }
+
+}  // namespace
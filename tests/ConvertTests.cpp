@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <limits>
+#include <cmath>
+
+#include "fixed_point/convert.hpp"
+#include "fixed_point/fixed_point.hpp"
+
+namespace {
+
+    namespace fp = fixed_point;
+    namespace simd = fixed_point::simd;
+
+    constexpr fp::Rounding kModes[] = {
+        fp::Rounding::Nearest, fp::Rounding::NearestEven, fp::Rounding::TowardZero, fp::Rounding::Floor
+    };
+
+    // Values around rounding ties and the storage limits, plus NaN/inf
+    template<typename Fixed, typename Float>
+    std::vector<Float> tricky_inputs(std::size_t n, unsigned seed) {
+        using S = typename Fixed::StorageType;
+        const Float ulp = Float(1) / Float(1LL << Fixed::fractional_bits);
+        const Float top = Float(std::numeric_limits<S>::max()) * ulp;
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<Float> wide(-2 * top, 2 * top);
+        std::vector<Float> v(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            switch (rng() % 10) {
+                case 0:  v[i] = (Float(int(rng() % 64)) - 32 + Float(0.5)) * ulp; break;   // exact ties
+                case 1:  v[i] = top + Float(int(rng() % 5)) * ulp; break;
+                case 2:  v[i] = -top - Float(int(rng() % 5)) * ulp; break;
+                case 3:  v[i] = Float(1e12) * (rng() % 2 ? 1 : -1); break;              // far out of range
+                case 4:  v[i] = (rng() % 2) ? std::numeric_limits<Float>::quiet_NaN()
+                                            : std::numeric_limits<Float>::infinity(); break;
+                default: v[i] = wide(rng); break;
+            }
+        }
+        return v;
+    }
+
+    template<typename Fixed, typename Float>
+    void expect_quantize_matches_reference() {
+        using S = typename Fixed::StorageType;
+        constexpr bool wrap = fp::detail::wraps_on_convert<Fixed>;
+        const Float scale = Float(1LL << Fixed::fractional_bits);
+        auto in = tricky_inputs<Fixed, Float>(517, 7);
+
+        for (int lvl = 0; lvl <= static_cast<int>(simd::detected_level()); ++lvl) {
+            simd::set_level(static_cast<simd::SimdLevel>(lvl));
+            for (auto mode : kModes) {
+                std::vector<Fixed> out(in.size());
+                fp::quantize<Fixed>(in, out, mode);
+                for (std::size_t i = 0; i < in.size(); ++i) {
+                    S expected{};
+                    switch (mode) {
+                        case fp::Rounding::Nearest:     expected = fp::detail::quantize_one<fp::Rounding::Nearest, wrap, S>(in[i], scale); break;
+                        case fp::Rounding::NearestEven: expected = fp::detail::quantize_one<fp::Rounding::NearestEven, wrap, S>(in[i], scale); break;
+                        case fp::Rounding::TowardZero:  expected = fp::detail::quantize_one<fp::Rounding::TowardZero, wrap, S>(in[i], scale); break;
+                        case fp::Rounding::Floor:       expected = fp::detail::quantize_one<fp::Rounding::Floor, wrap, S>(in[i], scale); break;
+                    }
+                    ASSERT_EQ(out[i].raw(), expected) << "level " << lvl << " mode " << int(mode) << " x=" << in[i];
+                }
+            }
+        }
+        simd::set_level(simd::detected_level());
+    }
+
+    template<typename Fixed>
+    void expect_dequantize_matches_scalar() {
+        using S = typename Fixed::StorageType;
+        std::mt19937 rng(11);
+        std::vector<Fixed> in(301);
+        for (auto& x : in) x = Fixed::from_raw(static_cast<S>(rng()));
+
+        for (int lvl = 0; lvl <= static_cast<int>(simd::detected_level()); ++lvl) {
+            simd::set_level(static_cast<simd::SimdLevel>(lvl));
+            std::vector<float> f(in.size());
+            std::vector<double> d(in.size());
+            fp::dequantize<Fixed>(in, f);
+            fp::dequantize<Fixed>(in, d);
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                ASSERT_EQ(f[i], in[i].to_float()) << "level " << lvl << " i=" << i;
+                ASSERT_EQ(d[i], in[i].to_double()) << "level " << lvl << " i=" << i;
+            }
+        }
+        simd::set_level(simd::detected_level());
+    }
+
+    TEST(ConvertTest, QuantizeMatchesReferenceAllLevels) {
+        expect_quantize_matches_reference<FixedPoint<16, 8, SaturationPolicy>, float>();
+        expect_quantize_matches_reference<FixedPoint<16, 8, WrapAroundPolicy>, float>();
+        expect_quantize_matches_reference<FixedPoint<32, 16, SaturationPolicy>, float>();
+        expect_quantize_matches_reference<FixedPoint<32, 16, WrapAroundPolicy>, float>();
+        expect_quantize_matches_reference<FixedPoint<16, 15, SaturationPolicy>, double>();
+        expect_quantize_matches_reference<FixedPoint<16, 8, WrapAroundPolicy>, double>();
+        expect_quantize_matches_reference<FixedPoint<32, 24, SaturationPolicy>, double>();
+        expect_quantize_matches_reference<FixedPoint<32, 8, WrapAroundPolicy>, double>();
+        expect_quantize_matches_reference<FixedPoint<8, 4, SaturationPolicy>, float>();
+    }
+
+    TEST(ConvertTest, NearestMatchesConstructorInRange) {
+        using Fixed = FixedPoint<16, 8, SaturationPolicy>;
+        std::vector<float> in{ 2.5f, -2.5f, 0.001953125f, -0.001953125f, 1.0f / 3, 127.99f, -128.0f };
+        std::vector<Fixed> out(in.size());
+        fp::quantize<Fixed>(in, out);
+        for (std::size_t i = 0; i < in.size(); ++i) {
+            EXPECT_EQ(out[i].raw(), Fixed(in[i]).raw()) << "x=" << in[i];
+        }
+    }
+
+    TEST(ConvertTest, OverflowFollowsPolicy) {
+        std::vector<float> in{ 200.0f, -200.0f, std::numeric_limits<float>::quiet_NaN() };
+
+        std::vector<FixedPoint<16, 8, SaturationPolicy>> sat(in.size());
+        fp::quantize<FixedPoint<16, 8, SaturationPolicy>>(in, sat);
+        EXPECT_EQ(sat[0].raw(), INT16_MAX);
+        EXPECT_EQ(sat[1].raw(), INT16_MIN);
+        EXPECT_EQ(sat[2].raw(), 0);
+
+        std::vector<FixedPoint<16, 8, WrapAroundPolicy>> wrap(in.size());
+        fp::quantize<FixedPoint<16, 8, WrapAroundPolicy>>(in, wrap);
+        EXPECT_EQ(wrap[0].raw(), INT16_MIN);
+        EXPECT_EQ(wrap[1].raw(), INT16_MAX);
+        EXPECT_EQ(wrap[2].raw(), 0);
+    }
+
+    TEST(ConvertTest, WrapAroundOverflowMatchesArithmetic) {
+        // WrapAroundPolicy arithmetic takes overflow to min and underflow to max; conversions
+        // into a wrapped type do the same in every kernel, whatever the distance out of range
+        using W16 = FixedPoint<16, 8, WrapAroundPolicy>;
+        using W32 = FixedPoint<32, 16, WrapAroundPolicy>;
+        ASSERT_EQ((W16::from_raw(INT16_MAX) + W16::from_raw(1)).raw(), INT16_MIN);
+        ASSERT_EQ((W16::from_raw(INT16_MIN) - W16::from_raw(1)).raw(), INT16_MAX);
+
+        std::vector<float> f;
+        std::vector<double> d;
+        for (int i = 0; i < 8; ++i) {
+            f.insert(f.end(), { 128.0f, -128.5f, 1e6f, -1e30f });
+            d.insert(d.end(), { 32768.0, -32769.0, 1e12, -1e300 });
+        }
+        for (int lvl = 0; lvl <= static_cast<int>(simd::detected_level()); ++lvl) {
+            simd::set_level(static_cast<simd::SimdLevel>(lvl));
+            std::vector<W16> w16(f.size());
+            std::vector<W32> w32(d.size());
+            fp::quantize<W16>(f, w16);
+            fp::quantize<W32>(d, w32);
+            for (std::size_t i = 0; i < f.size(); ++i) {
+                EXPECT_EQ(w16[i].raw(), i % 2 == 0 ? INT16_MIN : INT16_MAX) << "level " << lvl << " x=" << f[i];
+                EXPECT_EQ(w32[i].raw(), i % 2 == 0 ? INT32_MIN : INT32_MAX) << "level " << lvl << " x=" << d[i];
+            }
+        }
+        simd::set_level(simd::detected_level());
+
+        // 2.0 and -2.5 do not fit Q15 PCM
+        std::vector<W16> q{ W16(2.0), W16(-2.5), W16(0.5) };
+        std::vector<int16_t> pcm(q.size());
+        fp::dequantize_pcm16<W16>(q, pcm);
+        EXPECT_EQ(pcm[0], INT16_MIN);
+        EXPECT_EQ(pcm[1], INT16_MAX);
+        EXPECT_EQ(pcm[2], 16384);
+    }
+
+    TEST(ConvertTest, RoundingModes) {
+        using Fixed = FixedPoint<16, 0, SaturationPolicy>;
+        std::vector<double> in{ 2.5, -2.5, 3.5, -1.2 };
+        std::vector<Fixed> out(in.size());
+
+        fp::quantize<Fixed>(in, out, fp::Rounding::Nearest);
+        EXPECT_EQ(out[0].raw(), 3);  EXPECT_EQ(out[1].raw(), -3); EXPECT_EQ(out[2].raw(), 4);  EXPECT_EQ(out[3].raw(), -1);
+        fp::quantize<Fixed>(in, out, fp::Rounding::NearestEven);
+        EXPECT_EQ(out[0].raw(), 2);  EXPECT_EQ(out[1].raw(), -2); EXPECT_EQ(out[2].raw(), 4);  EXPECT_EQ(out[3].raw(), -1);
+        fp::quantize<Fixed>(in, out, fp::Rounding::TowardZero);
+        EXPECT_EQ(out[0].raw(), 2);  EXPECT_EQ(out[1].raw(), -2); EXPECT_EQ(out[2].raw(), 3);  EXPECT_EQ(out[3].raw(), -1);
+        fp::quantize<Fixed>(in, out, fp::Rounding::Floor);
+        EXPECT_EQ(out[0].raw(), 2);  EXPECT_EQ(out[1].raw(), -3); EXPECT_EQ(out[2].raw(), 3);  EXPECT_EQ(out[3].raw(), -2);
+    }
+
+    TEST(ConvertTest, DequantizeMatchesToFloat) {
+        expect_dequantize_matches_scalar<FixedPoint<16, 8, SaturationPolicy>>();
+        expect_dequantize_matches_scalar<FixedPoint<32, 20, WrapAroundPolicy>>();
+        expect_dequantize_matches_scalar<FixedPoint<8, 3, SaturationPolicy>>();
+    }
+
+    TEST(ConvertTest, InterleavedComplexRoundTrip) {
+        using Fixed = FixedPoint<16, 8, SaturationPolicy>;
+        std::vector<std::complex<float>> in{ {1.5f, -0.25f}, {3.0f, 2.0f}, {-0.5f, 0.75f}, {0.0f, -4.0f}, {7.25f, 1.0f} };
+        std::vector<std::complex<Fixed>> q(in.size());
+        std::vector<std::complex<float>> back(in.size());
+        fp::quantize<Fixed>(in, q);
+        fp::dequantize<Fixed>(q, back);
+        for (std::size_t i = 0; i < in.size(); ++i) {
+            EXPECT_EQ(q[i].real().raw(), Fixed(in[i].real()).raw());
+            EXPECT_EQ(q[i].imag().raw(), Fixed(in[i].imag()).raw());
+            EXPECT_FLOAT_EQ(back[i].real(), in[i].real());
+            EXPECT_FLOAT_EQ(back[i].imag(), in[i].imag());
+        }
+    }
+
+    TEST(ConvertTest, Pcm16RoundTrip) {
+        std::vector<int16_t> pcm{ 0, 16384, -16384, 32767, -32768, 64, -64, 1 };
+
+        // Q15 -> Q8 rounds, Q8 -> Q15 is exact
+        using Q8 = FixedPoint<16, 8, SaturationPolicy>;
+        std::vector<Q8> q8(pcm.size());
+        fp::quantize_pcm16<Q8>(pcm, q8);
+        EXPECT_EQ(q8[1].raw(), 128);     // 0.5
+        EXPECT_EQ(q8[3].raw(), 256);     // 0.99997 rounds up to 1.0
+        EXPECT_EQ(q8[4].raw(), -256);
+        EXPECT_EQ(q8[5].raw(), 1);       // 0.5 LSB ties away from zero
+        EXPECT_EQ(q8[6].raw(), -1);
+
+        std::vector<int16_t> back(pcm.size());
+        fp::dequantize_pcm16<Q8>(q8, back);
+        EXPECT_EQ(back[1], 16384);
+        EXPECT_EQ(back[3], 32767);       // +1.0 saturates to full scale
+        EXPECT_EQ(back[4], -32768);
+
+        // Q15 -> Q16.16 widens exactly
+        using Q16 = FixedPoint<32, 16, SaturationPolicy>;
+        std::vector<Q16> q16(pcm.size());
+        fp::quantize_pcm16<Q16>(pcm, q16);
+        for (std::size_t i = 0; i < pcm.size(); ++i) EXPECT_EQ(q16[i].raw(), pcm[i] * 2);
+        fp::dequantize_pcm16<Q16>(q16, back);
+        EXPECT_EQ(back, pcm);
+    }
+
+} // namespace
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
+#include <random>
 #include "dsp/convolution.hpp"
+#include "dsp/convolution2d.hpp"
 #include "fixed_point/fixed_point.hpp"
 
 using Fixed = FixedPoint<16, 8, SaturationPolicy>;
@@ -60,4 +62,94 @@ namespace {
         }
     }
 
+    dsp::Array2D<double> random_image(std::size_t rows, std::size_t cols, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        dsp::Array2D<double> a(rows, cols);
+        for (auto& v : a.data) v = dist(rng);
+        return a;
+    }
+
+    // y(r, c) = sum over i, j of x(r - i, c - j) * k(i, j), four plain loops
+    dsp::Array2D<double> reference_convolve2d(const dsp::Array2D<double>& x, const dsp::Array2D<double>& k) {
+        dsp::Array2D<double> y(x.rows + k.rows - 1, x.cols + k.cols - 1);
+        for (std::size_t r = 0; r < x.rows; ++r)
+            for (std::size_t c = 0; c < x.cols; ++c)
+                for (std::size_t i = 0; i < k.rows; ++i)
+                    for (std::size_t j = 0; j < k.cols; ++j) y(r + i, c + j) += x(r, c) * k(i, j);
+        return y;
+    }
+
+    template<typename T>
+    double max_error(const dsp::Array2D<T>& a, const dsp::Array2D<double>& b) {
+        EXPECT_EQ(a.rows, b.rows);
+        EXPECT_EQ(a.cols, b.cols);
+        double err = 0.0;
+        for (std::size_t i = 0; i < b.data.size(); ++i) {
+            double v;
+            if constexpr (std::is_same_v<T, double>) v = a.data[i];
+            else v = a.data[i].to_double();
+            err = std::max(err, std::abs(v - b.data[i]));
+        }
+        return err;
+    }
+
+    TEST(ConvolutionTest, Direct2DMatchesReference) {
+        auto x = random_image(13, 9, 1);
+        auto k = random_image(4, 6, 2);
+        EXPECT_LT(max_error(dsp::convolve2d(x, k), reference_convolve2d(x, k)), 1e-12);
+        // Kernel larger than the signal
+        EXPECT_LT(max_error(dsp::convolve2d(k, x), reference_convolve2d(k, x)), 1e-12);
+
+        dsp::Array2D<Fixed> xf(x.rows, x.cols), kf(k.rows, k.cols);
+        for (std::size_t i = 0; i < x.data.size(); ++i) xf.data[i] = Fixed(x.data[i]);
+        for (std::size_t i = 0; i < k.data.size(); ++i) kf.data[i] = Fixed(k.data[i]);
+        for (std::size_t i = 0; i < x.data.size(); ++i) x.data[i] = xf.data[i].to_double();
+        for (std::size_t i = 0; i < k.data.size(); ++i) k.data[i] = kf.data[i].to_double();
+        // One rounding per output
+        EXPECT_LE(max_error(dsp::convolve2d(xf, kf), reference_convolve2d(x, k)), 0.5 / 256.0);
+    }
+
+    TEST(ConvolutionTest, Separable2DMatchesFullKernel) {
+        auto x = random_image(20, 17, 3);
+        std::vector<double> column_taps = { 0.25, 0.5, 0.25 };
+        std::vector<double> row_taps = { -1.0, 0.0, 1.0, 0.5, 0.125 };
+        dsp::Array2D<double> k(column_taps.size(), row_taps.size());
+        for (std::size_t i = 0; i < k.rows; ++i)
+            for (std::size_t j = 0; j < k.cols; ++j) k(i, j) = column_taps[i] * row_taps[j];
+
+        auto expected = reference_convolve2d(x, k);
+        EXPECT_LT(max_error(dsp::convolve2d(x, column_taps, row_taps), expected), 1e-12);
+
+        dsp::Array2D<Fixed> xf(x.rows, x.cols);
+        for (std::size_t i = 0; i < x.data.size(); ++i) xf.data[i] = Fixed(x.data[i]);
+        for (std::size_t i = 0; i < x.data.size(); ++i) x.data[i] = xf.data[i].to_double();
+        std::vector<Fixed> column_f(column_taps.begin(), column_taps.end()), row_f(row_taps.begin(), row_taps.end());
+        // The row pass's rounding is scaled by sum |column_taps| = 1 in the column pass
+        EXPECT_LE(max_error(dsp::convolve2d(xf, column_f, row_f), reference_convolve2d(x, k)), 1.0 / 256.0);
+    }
+
+    TEST(ConvolutionTest, FFT2DMatchesDirect) {
+        // Output shapes 40x30 and 71x11 pad to 40x30 and 72x12
+        for (auto [x_rows, x_cols, k_rows, k_cols] : { std::array<std::size_t, 4>{ 32, 24, 9, 7 },
+                                                       std::array<std::size_t, 4>{ 64, 8, 8, 4 } }) {
+            auto x = random_image(x_rows, x_cols, 4);
+            auto k = random_image(k_rows, k_cols, 5);
+            EXPECT_LT(max_error(dsp::convolve2d_fft(x, k), reference_convolve2d(x, k)), 1e-11);
+        }
+
+        // FixedPoint with integer headroom for the 32x32-point spectra
+        using Q16 = FixedPoint<32, 16, SaturationPolicy>;
+        auto x = random_image(24, 20, 6);
+        auto k = random_image(8, 8, 7);
+        dsp::Array2D<Q16> xf(x.rows, x.cols), kf(k.rows, k.cols);
+        for (std::size_t i = 0; i < x.data.size(); ++i) xf.data[i] = Q16(x.data[i]);
+        for (std::size_t i = 0; i < k.data.size(); ++i) kf.data[i] = Q16(k.data[i]);
+        EXPECT_LT(max_error(dsp::convolve2d_fft(xf, kf), reference_convolve2d(x, k)), 1e-3);
+
+        dsp::Array2D<double> empty;
+        EXPECT_THROW(dsp::convolve2d_fft(x, empty), std::invalid_argument);
+        EXPECT_THROW(dsp::convolve2d(empty, k), std::invalid_argument);
+    }
+
 } // namespace
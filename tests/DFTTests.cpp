@@ -1,8 +1,10 @@
 ﻿#include <gtest/gtest.h>
 #include <vector>
 #include <complex>
+#include <cmath>
 #include <numbers>
 
+#include "dsp/cfixed.hpp"
 #include "dsp/dft.hpp"
 #include "fixed_point/fixed_point.hpp"
 
@@ -69,4 +71,59 @@ namespace {
         }
     }
 
+    TEST(DFTTest, FFTDispatchMatchesDirectSum) {
+        // Powers of two and 2^a*3^b*5^c go through an FFT, 97 stays on the direct sum
+        for (std::size_t N : { 1, 12, 64, 97 }) {
+            std::vector<std::complex<double>> x(N);
+            for (std::size_t n = 0; n < N; ++n) x[n] = { std::sin(0.3 * double(n)), std::cos(1.7 * double(n)) };
+            auto X = dsp::dft(x);
+            auto expected = dsp::dft_direct(x);
+            for (std::size_t k = 0; k < N; ++k) {
+                ASSERT_NEAR(std::abs(X[k] - expected[k]), 0.0, 1e-9 * double(N)) << "N=" << N << " k=" << k;
+            }
+            auto y = dsp::idft(X);
+            auto y_direct = dsp::idft_direct(expected);
+            for (std::size_t n = 0; n < N; ++n) {
+                ASSERT_NEAR(std::abs(y[n] - x[n]), 0.0, 1e-12 * double(N)) << "N=" << N << " n=" << n;
+                ASSERT_NEAR(std::abs(y_direct[n] - x[n]), 0.0, 1e-12 * double(N)) << "N=" << N << " n=" << n;
+            }
+        }
+        EXPECT_TRUE(dsp::dft(std::vector<std::complex<double>>{}).empty());
+
+        std::vector<Fixed> real(16);
+        for (std::size_t n = 0; n < real.size(); ++n) real[n] = Fixed(std::sin(0.5 * double(n)));
+        auto X = dsp::dft(real);
+        auto expected = dsp::dft_direct(real);
+        for (std::size_t k = 0; k < real.size(); ++k) {
+            EXPECT_NEAR(X[k].real().to_float(), expected[k].real().to_float(), 0.05f) << "k=" << k;
+            EXPECT_NEAR(X[k].imag().to_float(), expected[k].imag().to_float(), 0.05f) << "k=" << k;
+        }
+    }
+
+    TEST(DFTTest, SelectedBinsMatchFullTransform) {
+        // 64 reads the shared twiddle circle, 97 builds its own table
+        for (std::size_t N : { 64, 97 }) {
+            std::vector<Fixed> real(N);
+            std::vector<dsp::cfixed<Fixed>> z(N);
+            for (std::size_t n = 0; n < N; ++n) {
+                real[n] = Fixed(std::sin(0.4 * double(n)));
+                z[n] = { Fixed(0.5 * std::cos(0.1 * double(n))), Fixed(-0.25 * std::sin(0.7 * double(n))) };
+            }
+            // The bin sums are the full transform's, so the bits match; bins wrap mod N
+            std::vector<std::size_t> bins = { 0, 5, N - 1, 5 + N };
+            auto X = dsp::dft_bins(real, bins);
+            auto Z = dsp::dft_bins(z, bins);
+            auto X_full = dsp::dft_direct(real);
+            auto Z_full = dsp::dft_direct(z);
+            ASSERT_EQ(X.size(), bins.size());
+            for (std::size_t i = 0; i < bins.size(); ++i) {
+                EXPECT_EQ(X[i], X_full[bins[i] % N]) << "N=" << N << " bin " << bins[i];
+                EXPECT_EQ(Z[i], Z_full[bins[i] % N]) << "N=" << N << " bin " << bins[i];
+            }
+        }
+
+        EXPECT_TRUE(dsp::dft_bins(std::vector<Fixed>(8), {}).empty());
+        EXPECT_THROW(dsp::dft_bins(std::vector<Fixed>{}, { 1 }), std::invalid_argument);
+    }
+
 }  // namespace
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <complex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dsp/cfixed.hpp"
+#include "dsp/fft.hpp"
+#include "dsp/fft_cache.hpp"
+#include "fixed_point/fixed_point.hpp"
+
+using Q15 = FixedPoint<16, 15, SaturationPolicy>;
+using Cache = dsp::FFTPlanCache<Q15>;
+
+namespace {
+
+    template<typename Plan>
+    void expect_same_tables(const Plan& a, const Plan& b) {
+        ASSERT_EQ(a.N, b.N);
+        ASSERT_EQ(a.kernel, b.kernel);
+        EXPECT_EQ(a.bitrev, b.bitrev);
+        EXPECT_EQ(a.twiddles, b.twiddles);
+        EXPECT_EQ(a.kernel_twiddles, b.kernel_twiddles);
+        EXPECT_EQ(a.filter_shift, b.filter_shift);
+        ASSERT_EQ(a.sub_plans.size(), b.sub_plans.size());
+        for (std::size_t i = 0; i < a.sub_plans.size(); ++i) expect_same_tables(a.sub_plans[i], b.sub_plans[i]);
+    }
+
+    TEST(FFTCacheTest, SharesPlansPerSizeAndKernel) {
+        Cache cache;
+        auto a = cache.plan(256);
+        auto b = cache.plan(256, dsp::FFTKernel::Radix4);  // what Auto picks
+        auto c = cache.plan(256, dsp::FFTKernel::Radix2);
+        EXPECT_EQ(a, b);
+        EXPECT_NE(a, c);
+        EXPECT_EQ(cache.size(), 2u);
+        EXPECT_THROW(cache.plan(100, dsp::FFTKernel::Radix4), std::invalid_argument);
+        EXPECT_EQ(cache.plan(100)->kernel, dsp::FFTKernel::MixedRadix);
+        EXPECT_EQ(cache.size(), 3u);
+
+        // Everything comes from one twiddle circle, grown to the largest size
+        EXPECT_EQ(cache.twiddle_circle(16)->size(), 256u);
+        cache.plan(1024);
+        EXPECT_EQ(cache.twiddle_circle(16)->size(), 1024u);
+
+        cache.clear();
+        EXPECT_EQ(cache.size(), 0u);
+        EXPECT_EQ(a->N, 256u);  // handed-out plans stay valid
+    }
+
+    TEST(FFTCacheTest, CachedPlansMatchFreshPlans) {
+        Cache cache;
+        cache.plan(8);  // the circle then grows from 8 to 4096 entries
+        for (auto kernel : { dsp::FFTKernel::Radix2, dsp::FFTKernel::Radix4, dsp::FFTKernel::SplitRadix, dsp::FFTKernel::FourStep }) {
+            for (std::size_t N : { 2, 8, 32, 512, 4096 }) {
+                expect_same_tables(*cache.plan(N, kernel), dsp::FFTPlan<Q15>(N, kernel));
+            }
+        }
+        dsp::FFTPlanCache<Q15, dsp::cfixed<Q15>> cfixed_cache;
+        expect_same_tables(*cfixed_cache.plan(64), dsp::FFTPlan<Q15, dsp::cfixed<Q15>>(64));
+    }
+
+    TEST(FFTCacheTest, ConcurrentRequestsGetOnePlan) {
+        Cache cache;
+        std::vector<std::shared_ptr<const Cache::Plan>> got(8);
+        {
+            std::vector<std::jthread> threads;
+            for (std::size_t i = 0; i < got.size(); ++i) {
+                threads.emplace_back([&, i] {
+                    cache.plan(std::size_t(64) << (i % 4));
+                    got[i] = cache.plan(1024);
+                });
+            }
+        }
+        for (const auto& p : got) EXPECT_EQ(p, got[0]);
+        EXPECT_EQ(cache.size(), 5u);
+        // Circles grown by racing threads still give the tables of a plan built alone
+        for (std::size_t N : { 64, 128, 256, 512, 1024 }) expect_same_tables(*cache.plan(N), dsp::FFTPlan<Q15>(N));
+    }
+
+    TEST(FFTCacheTest, WisdomRoundTrip) {
+        Cache cache;
+        cache.plan(64);
+        cache.plan(256, dsp::FFTKernel::SplitRadix);
+        cache.plan(1024, dsp::FFTKernel::FourStep);
+        cache.plan(480);
+        cache.plan(97);
+        std::stringstream wisdom;
+        cache.save(wisdom);
+
+        Cache restored;
+        restored.load(wisdom);
+        EXPECT_EQ(restored.size(), 5u);
+        expect_same_tables(*restored.plan(64), dsp::FFTPlan<Q15>(64));
+        expect_same_tables(*restored.plan(256, dsp::FFTKernel::SplitRadix), dsp::FFTPlan<Q15>(256, dsp::FFTKernel::SplitRadix));
+        expect_same_tables(*restored.plan(1024, dsp::FFTKernel::FourStep), dsp::FFTPlan<Q15>(1024, dsp::FFTKernel::FourStep));
+        expect_same_tables(*restored.plan(480), dsp::FFTPlan<Q15>(480, dsp::FFTKernel::MixedRadix));
+        expect_same_tables(*restored.plan(97), dsp::FFTPlan<Q15>(97, dsp::FFTKernel::Bluestein));
+        EXPECT_EQ(restored.size(), 5u);  // served from the loaded plans
+
+        // Other sample types, other files and damaged files are rejected
+        std::string bytes = wisdom.str();
+        std::stringstream copy(bytes);
+        dsp::FFTPlanCache<FixedPoint<16, 8, SaturationPolicy>> other;
+        EXPECT_THROW(other.load(copy), std::runtime_error);
+        std::stringstream truncated(bytes.substr(0, bytes.size() - 8));
+        Cache damaged;
+        EXPECT_THROW(damaged.load(truncated), std::runtime_error);
+        EXPECT_EQ(damaged.size(), 0u);
+        std::string corrupt = bytes;
+        corrupt[32] = 3;  // first plan's N
+        std::stringstream corrupt_in(corrupt);
+        EXPECT_THROW(damaged.load(corrupt_in), std::runtime_error);
+        std::stringstream garbage("not wisdom at all, just some text");
+        EXPECT_THROW(damaged.load(garbage), std::runtime_error);
+    }
+
+}  // namespace
@@ -1,9 +1,15 @@
 ﻿#include <gtest/gtest.h>
 #include <vector>
 #include <complex>
+#include <cmath>
+#include <random>
+#include <span>
+#include <thread>
 
 #include "dsp/fft.hpp"
+#include "dsp/fft_cache.hpp"
 #include "dsp/dft.hpp"
+#include "dsp/normalize.hpp"
 #include "fixed_point/fixed_point.hpp"
 
 using Fixed = FixedPoint<16, 8, SaturationPolicy>;
@@ -79,7 +85,7 @@ namespace {
         auto x_c = to_complex(real);
 
         // compute naive DFT
-        auto X_dft = dsp::dft(real);
+        auto X_dft = dsp::dft_direct(real);
 
         // compute FFTPlan
         dsp::FFTPlan<Fixed> plan(N);
@@ -90,4 +96,602 @@ namespace {
         expect_complex_eq(X_fft, X_dft, 0.02f);
     }
 
+    TEST(FFTTest, ConstexprTwiddleTableMatchesPlan) {
+        constexpr size_t N = 16;
+        static constexpr auto twiddles = dsp::make_twiddle_table<Fixed, N>();
+        static constexpr auto bitrev = dsp::make_bitrev_table<N>();
+
+        dsp::FFTPlan<Fixed> plan(N);
+        for (size_t k = 0; k < N / 2; ++k) {
+            EXPECT_EQ(twiddles[k].real().raw(), plan.twiddles[k].real().raw()) << "k=" << k;
+            EXPECT_EQ(twiddles[k].imag().raw(), plan.twiddles[k].imag().raw()) << "k=" << k;
+        }
+        for (size_t i = 0; i < N; ++i) {
+            EXPECT_EQ(bitrev[i], plan.bitrev[i]) << "i=" << i;
+        }
+    }
+
+    TEST(FFTTest, NormalizerRoundsAlikeForEveryN) {
+        // Powers of two shift, other N go through a Reciprocal; both round half away from zero
+        for (std::size_t N : { 2u, 3u, 5u, 8u, 12u, 16u, 1000u, 1024u }) {
+            dsp::Normalizer<Fixed> scale(N);
+            for (int raw = -32768; raw <= 32767; raw += 11) {
+                auto x = Fixed::from_raw(static_cast<int16_t>(raw));
+                ASSERT_EQ(scale(x).raw(), std::llround(double(raw) / double(N))) << "N=" << N << " raw=" << raw;
+            }
+        }
+    }
+
+    TEST(FFTTest, InverseScalesBeyondFormatRange) {
+        // 1/512 is below the Q8.8 resolution, so the 1/N scaling has to be a shift
+        const size_t N = 512;
+        std::vector<CFixed> data(N, CFixed{ Fixed{0}, Fixed{0} });
+        data[0] = CFixed{ Fixed{64}, Fixed{0} };
+
+        dsp::FFTPlan<Fixed> plan(N);
+        plan.inverse(data);
+
+        for (size_t i = 0; i < N; ++i) {
+            EXPECT_EQ(data[i].real().raw(), Fixed{ 0.125 }.raw()) << "i=" << i;
+            EXPECT_EQ(data[i].imag().raw(), 0) << "i=" << i;
+        }
+    }
+
+    TEST(FFTTest, FixedPointInverseRoundsOnce) {
+        // The native inverse scales once, in its last pass: it stays within an LSB or two of the
+        // exact inverse DFT of the quantized spectrum, for every kernel
+        const size_t N = 256;
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> dist(-0.3, 0.3);
+        std::vector<CFixed> X(N);
+        std::vector<std::complex<double>> X_conj(N);
+        for (size_t k = 0; k < N; ++k) {
+            X[k] = CFixed(Fixed(dist(rng)), Fixed(dist(rng)));
+            X_conj[k] = { X[k].real().to_double(), -X[k].imag().to_double() };
+        }
+        auto expected = dsp::dft_direct(X_conj);
+
+        const double lsb = 1.0 / 256.0;
+        for (auto kernel : { dsp::FFTKernel::Radix2, dsp::FFTKernel::Radix4, dsp::FFTKernel::SplitRadix,
+                             dsp::FFTKernel::FourStep }) {
+            dsp::FFTPlan<Fixed> plan(N, kernel);
+            auto x = X;
+            plan.inverse(x);
+            for (size_t n = 0; n < N; ++n) {
+                std::complex<double> want = std::conj(expected[n]) / double(N);
+                EXPECT_NEAR(x[n].real().to_double(), want.real(), 2 * lsb) << "kernel=" << int(kernel) << " n=" << n;
+                EXPECT_NEAR(x[n].imag().to_double(), want.imag(), 2 * lsb) << "kernel=" << int(kernel) << " n=" << n;
+            }
+        }
+    }
+
+    TEST(FFTTest, AllKernelsMatchDFT) {
+        // Odd and even log2(N), including the sizes where the kernels degenerate
+        for (size_t N : { 1, 2, 4, 8, 32, 64, 512 }) {
+            std::vector<std::complex<double>> x(N);
+            for (size_t n = 0; n < N; ++n) x[n] = { std::sin(0.3 * double(n)) + 0.1 * double(n % 5), std::cos(1.7 * double(n)) };
+            auto expected = dsp::dft_direct(x);
+
+            for (auto kernel : { dsp::FFTKernel::Radix2, dsp::FFTKernel::Radix4, dsp::FFTKernel::SplitRadix,
+                                 dsp::FFTKernel::FourStep, dsp::FFTKernel::Auto }) {
+                dsp::FFTPlan<double> plan(N, kernel);
+                EXPECT_NE(plan.kernel, dsp::FFTKernel::Auto);
+                auto X = x;
+                plan.forward(X);
+                for (size_t k = 0; k < N; ++k) {
+                    ASSERT_NEAR(std::abs(X[k] - expected[k]), 0.0, 1e-9 * double(N))
+                        << "N=" << N << " kernel=" << int(kernel) << " k=" << k;
+                }
+                plan.inverse(X);
+                for (size_t n = 0; n < N; ++n) {
+                    ASSERT_NEAR(std::abs(X[n] - x[n]), 0.0, 1e-12 * double(N)) << "N=" << N << " n=" << n;
+                }
+            }
+        }
+    }
+
+    TEST(FFTTest, AnyLengthMatchesDFT) {
+        // Mixed-radix frame sizes and primes (Bluestein), plus Bluestein forced on a smooth size
+        struct Case { size_t N; dsp::FFTKernel kernel; dsp::FFTKernel runs; };
+        for (auto [N, kernel, runs] : { Case{ 3, dsp::FFTKernel::Auto, dsp::FFTKernel::MixedRadix },
+                                        Case{ 5, dsp::FFTKernel::Auto, dsp::FFTKernel::MixedRadix },
+                                        Case{ 12, dsp::FFTKernel::Auto, dsp::FFTKernel::MixedRadix },
+                                        Case{ 480, dsp::FFTKernel::Auto, dsp::FFTKernel::MixedRadix },
+                                        Case{ 1000, dsp::FFTKernel::Auto, dsp::FFTKernel::MixedRadix },
+                                        Case{ 1536, dsp::FFTKernel::Auto, dsp::FFTKernel::MixedRadix },
+                                        Case{ 64, dsp::FFTKernel::MixedRadix, dsp::FFTKernel::MixedRadix },
+                                        Case{ 7, dsp::FFTKernel::Auto, dsp::FFTKernel::Bluestein },
+                                        Case{ 97, dsp::FFTKernel::Auto, dsp::FFTKernel::Bluestein },
+                                        Case{ 480, dsp::FFTKernel::Bluestein, dsp::FFTKernel::Bluestein },
+                                        Case{ 1, dsp::FFTKernel::Bluestein, dsp::FFTKernel::Bluestein } }) {
+            std::vector<std::complex<double>> x(N);
+            for (size_t n = 0; n < N; ++n) x[n] = { std::sin(0.3 * double(n)) + 0.1 * double(n % 5), std::cos(1.7 * double(n)) };
+            auto expected = dsp::dft_direct(x);
+
+            dsp::FFTPlan<double> plan(N, kernel);
+            EXPECT_EQ(plan.kernel, runs) << "N=" << N;
+            auto X = x;
+            plan.forward(X);
+            for (size_t k = 0; k < N; ++k) {
+                ASSERT_NEAR(std::abs(X[k] - expected[k]), 0.0, 1e-9 * double(N)) << "N=" << N << " k=" << k;
+            }
+            plan.inverse(X);
+            for (size_t n = 0; n < N; ++n) {
+                ASSERT_NEAR(std::abs(X[n] - x[n]), 0.0, 1e-12 * double(N)) << "N=" << N << " n=" << n;
+            }
+        }
+
+        EXPECT_THROW(dsp::FFTPlan<double>(12, dsp::FFTKernel::Radix4), std::invalid_argument);
+        EXPECT_THROW(dsp::FFTPlan<double>(14, dsp::FFTKernel::MixedRadix), std::invalid_argument);
+        EXPECT_THROW(dsp::FFTPlan<double>(0), std::invalid_argument);
+        dsp::BlockFloat<CFixed> block(12);
+        EXPECT_THROW(dsp::FFTPlan<Fixed>(12).forward(block), std::invalid_argument);
+    }
+
+    TEST(FFTTest, ScratchKernelsRepeatAcrossSizesAndThreads) {
+        // MixedRadix and Bluestein keep per-thread scratch: a smaller transform after a larger one
+        // must not see its leftovers, and threads must not share it
+        auto run = [](size_t N, dsp::FFTKernel kernel) {
+            std::vector<std::complex<double>> x(N);
+            for (size_t n = 0; n < N; ++n) x[n] = { std::sin(0.3 * double(n)), std::cos(0.11 * double(n * n)) };
+            dsp::FFTPlan<double>(N, kernel).forward(x);
+            return x;
+        };
+        const auto mixed = run(60, dsp::FFTKernel::Auto), chirp = run(97, dsp::FFTKernel::Auto);
+        run(1000, dsp::FFTKernel::Auto);
+        run(480, dsp::FFTKernel::Bluestein);
+        EXPECT_TRUE(run(60, dsp::FFTKernel::Auto) == mixed);
+        EXPECT_TRUE(run(97, dsp::FFTKernel::Auto) == chirp);
+
+        std::vector<int> same(4, 0);
+        {
+            std::vector<std::jthread> workers;
+            for (size_t t = 0; t < same.size(); ++t) {
+                workers.emplace_back([&, t] {
+                    bool ok = true;
+                    for (int i = 0; i < 20; ++i) ok = ok && run(60, dsp::FFTKernel::Auto) == mixed && run(97, dsp::FFTKernel::Auto) == chirp;
+                    same[t] = ok;
+                });
+            }
+        }
+        for (int ok : same) EXPECT_TRUE(ok);
+    }
+
+    TEST(FFTTest, FixedPointAnyLength) {
+        using Q24 = FixedPoint<32, 24, SaturationPolicy>;
+        for (size_t N : { 960, 97 }) {
+            std::vector<std::complex<Q24>> x(N);
+            std::vector<std::complex<double>> x_ref(N);
+            for (size_t n = 0; n < N; ++n) {
+                x[n] = { Q24(0.1 * std::sin(0.2 * double(n))), Q24(0.05 * std::cos(0.05 * double(n * n))) };
+                x_ref[n] = { x[n].real().to_double(), x[n].imag().to_double() };
+            }
+            auto expected = dsp::dft_direct(x_ref);
+
+            dsp::FFTPlan<Q24> plan(N);
+            auto X = x;
+            plan.forward(X);
+            double err = 0.0;
+            for (size_t k = 0; k < N; ++k) {
+                err = std::max(err, std::abs(std::complex<double>(X[k].real().to_double(), X[k].imag().to_double()) - expected[k]));
+            }
+            EXPECT_LT(err, 2e-4) << "N=" << N;
+
+            plan.inverse(X);
+            err = 0.0;
+            for (size_t n = 0; n < N; ++n) {
+                err = std::max(err, std::abs(std::complex<double>(X[n].real().to_double(), X[n].imag().to_double()) - x_ref[n]));
+            }
+            EXPECT_LT(err, 1e-5) << "N=" << N;
+        }
+
+        // Q15 has no 1.0: cos(2*pi/1536) rounds up to it and must clamp instead of wrapping to -1
+        using Q15 = FixedPoint<16, 15, SaturationPolicy>;
+        EXPECT_GT(dsp::make_twiddle<Q15>(1536, 1).real().to_double(), 0.999);
+    }
+
+    TEST(FFTTest, BluesteinKeepsSixteenBitPrecision) {
+        // Q8.8 at N = 1000 with 0.1-amplitude inputs: Bluestein's filter has bins of about
+        // 1/sqrt(M), so it must keep them at full scale to stay near the mixed-radix kernel
+        const size_t N = 1000;
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<double> dist(-0.1, 0.1);
+        std::vector<CFixed> x(N);
+        std::vector<std::complex<double>> x_ref(N);
+        for (size_t n = 0; n < N; ++n) {
+            x[n] = CFixed(Fixed(dist(rng)), Fixed(dist(rng)));
+            x_ref[n] = { x[n].real().to_double(), x[n].imag().to_double() };
+        }
+        auto expected = dsp::dft_direct(x_ref);
+        auto max_error = [](const std::vector<CFixed>& X, const std::vector<std::complex<double>>& ref) {
+            double err = 0.0;
+            for (size_t k = 0; k < X.size(); ++k) {
+                err = std::max(err, std::abs(std::complex<double>(X[k].real().to_double(), X[k].imag().to_double()) - ref[k]));
+            }
+            return err;
+        };
+
+        double forward[2], round_trip[2];
+        for (int i = 0; i < 2; ++i) {
+            dsp::FFTPlan<Fixed> plan(N, i == 0 ? dsp::FFTKernel::MixedRadix : dsp::FFTKernel::Bluestein);
+            auto X = x;
+            plan.forward(X);
+            forward[i] = max_error(X, expected);
+            plan.inverse(X);
+            round_trip[i] = max_error(X, x_ref);
+        }
+        EXPECT_LT(forward[1], 1.6 * forward[0]);
+        EXPECT_LT(round_trip[1], 2.0 * round_trip[0]);
+    }
+
+    TEST(FFTTest, FixedPointKernelsMatchAccuracy) {
+        const size_t N = 128;
+        std::vector<CFixed> x(N);
+        std::vector<std::complex<double>> x_ref(N);
+        for (size_t n = 0; n < N; ++n) {
+            x[n] = CFixed(Fixed(std::sin(0.2 * double(n))), Fixed(0.5 * std::cos(0.05 * double(n * n))));
+            x_ref[n] = { x[n].real().to_double(), x[n].imag().to_double() };
+        }
+        auto expected = dsp::dft_direct(x_ref);
+
+        auto max_error = [&](dsp::FFTKernel kernel) {
+            dsp::FFTPlan<Fixed> plan(N, kernel);
+            auto X = x;
+            plan.forward(X);
+            double err = 0.0;
+            for (size_t k = 0; k < N; ++k) {
+                err = std::max(err, std::abs(std::complex<double>(X[k].real().to_double(), X[k].imag().to_double()) - expected[k]));
+            }
+            return err;
+        };
+        // The kernels round at different points; none of them loses accuracy against radix-2
+        double radix2 = max_error(dsp::FFTKernel::Radix2);
+        EXPECT_LT(radix2, 0.25);
+        EXPECT_LT(max_error(dsp::FFTKernel::Radix4), 1.5 * radix2);
+        EXPECT_LT(max_error(dsp::FFTKernel::SplitRadix), 1.5 * radix2);
+        EXPECT_LT(max_error(dsp::FFTKernel::FourStep), 1.5 * radix2);
+    }
+
+    TEST(FFTTest, ScalingModesKeepFullScaleInputInRange) {
+        // Q8.8 samples near +-100: the unscaled spectrum saturates, the scaled ones fit
+        const size_t N = 256;
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<double> dist(-100.0, 100.0);
+        std::vector<CFixed> x(N);
+        std::vector<std::complex<double>> x_ref(N);
+        for (size_t n = 0; n < N; ++n) {
+            x[n] = CFixed(Fixed(dist(rng)), Fixed(dist(rng)));
+            x_ref[n] = { x[n].real().to_double(), x[n].imag().to_double() };
+        }
+        auto expected = dsp::dft_direct(x_ref);
+
+        auto sqnr_db = [&](const std::vector<CFixed>& X, int exponent) {
+            double signal = 0.0, noise = 0.0;
+            for (size_t k = 0; k < N; ++k) {
+                std::complex<double> v(std::ldexp(X[k].real().to_double(), exponent),
+                                       std::ldexp(X[k].imag().to_double(), exponent));
+                signal += std::norm(expected[k]);
+                noise += std::norm(v - expected[k]);
+            }
+            return 10.0 * std::log10(signal / noise);
+        };
+
+        for (auto kernel : { dsp::FFTKernel::Radix2, dsp::FFTKernel::Radix4, dsp::FFTKernel::SplitRadix,
+                             dsp::FFTKernel::FourStep }) {
+            dsp::FFTPlan<Fixed> plan(N, kernel);
+            auto X = x;
+            EXPECT_EQ(plan.forward(X, dsp::FFTScaling::None), 0);
+            EXPECT_LT(sqnr_db(X, 0), 10.0) << "kernel=" << int(kernel);
+
+            X = x;
+            int e = plan.forward(X, dsp::FFTScaling::PerStage);
+            EXPECT_EQ(e, 8);
+            double per_stage = sqnr_db(X, e);
+            EXPECT_GT(per_stage, 40.0) << "kernel=" << int(kernel);
+
+            X = x;
+            e = plan.forward(X, dsp::FFTScaling::Conditional);
+            EXPECT_LE(e, 8);
+            EXPECT_GE(sqnr_db(X, e), per_stage) << "kernel=" << int(kernel);
+        }
+    }
+
+    TEST(FFTTest, ScalingModesOnLargeDefaultPlans) {
+        // 2^18 Q8.8 points reach fft_four_step_min_bytes, so Auto picks FourStep, whose scaled
+        // modes scale the 512-point sub-transforms: about as accurate as the Radix4 plan, and
+        // nothing built or cached behind the caller's back
+        const size_t N = size_t(1) << 18;
+        std::mt19937 rng(9);
+        std::uniform_real_distribution<double> dist(-100.0, 100.0);
+        std::vector<CFixed> x(N);
+        std::vector<std::complex<double>> x_ref(N);
+        for (size_t n = 0; n < N; ++n) {
+            x[n] = CFixed(Fixed(dist(rng)), Fixed(dist(rng)));
+            x_ref[n] = { x[n].real().to_double(), x[n].imag().to_double() };
+        }
+        dsp::FFTPlan<double>(N).forward(x_ref);
+
+        auto rms_error = [&](const std::vector<CFixed>& X, int exponent) {
+            double sum = 0.0;
+            for (size_t k = 0; k < N; ++k) {
+                std::complex<double> v(std::ldexp(X[k].real().to_double(), exponent),
+                                       std::ldexp(X[k].imag().to_double(), exponent));
+                sum += std::norm(v - x_ref[k]);
+            }
+            return std::sqrt(sum / double(N));
+        };
+
+        const std::size_t cached = dsp::FFTPlanCache<Fixed>::global().size();
+        dsp::FFTPlan<Fixed> plan(N), radix4(N, dsp::FFTKernel::Radix4);
+        ASSERT_EQ(plan.kernel, dsp::FFTKernel::FourStep);
+        for (auto scaling : { dsp::FFTScaling::PerStage, dsp::FFTScaling::Conditional }) {
+            auto X = x, expected = x;
+            int e = plan.forward(X, scaling);
+            int e_radix4 = radix4.forward(expected, scaling);
+            EXPECT_LE(e, e_radix4 + 1) << "scaling=" << int(scaling);
+            EXPECT_LT(rms_error(X, e), 1.5 * rms_error(expected, e_radix4)) << "scaling=" << int(scaling);
+            if (scaling == dsp::FFTScaling::PerStage) {
+                EXPECT_EQ(e, 18);
+            }
+        }
+        EXPECT_EQ(dsp::FFTPlanCache<Fixed>::global().size(), cached);
+    }
+
+    TEST(FFTTest, ConditionalScalingLeavesSmallSignalsAlone) {
+        // With headroom for every pass nothing shifts: same bits as forward(data)
+        const size_t N = 64;
+        std::vector<CFixed> x(N);
+        for (size_t n = 0; n < N; ++n) x[n] = CFixed(Fixed(0.5 * std::sin(0.4 * double(n))), Fixed(0.25));
+
+        for (auto kernel : { dsp::FFTKernel::Radix2, dsp::FFTKernel::Radix4 }) {
+            dsp::FFTPlan<Fixed> plan(N, kernel);
+            auto expected = x;
+            plan.forward(expected);
+            auto X = x;
+            EXPECT_EQ(plan.forward(X, dsp::FFTScaling::Conditional), 0);
+            for (size_t k = 0; k < N; ++k) ASSERT_EQ(X[k], expected[k]) << "kernel=" << int(kernel) << " k=" << k;
+        }
+
+        // Mixed-radix passes have no scaled form
+        std::vector<CFixed> X(x.begin(), x.begin() + 48);
+        dsp::FFTPlan<Fixed> mixed(48);
+        EXPECT_THROW(mixed.forward(X, dsp::FFTScaling::PerStage), std::invalid_argument);
+        EXPECT_EQ(mixed.forward(X, dsp::FFTScaling::None), 0);
+    }
+
+    TEST(FFTTest, LargeTransformsSwitchToFourStep) {
+        // 2^17 complex doubles are 2 MiB, above the four-step threshold
+        const size_t N = size_t(1) << 17;
+        dsp::FFTPlan<double> plan(N);
+        EXPECT_EQ(plan.kernel, dsp::FFTKernel::FourStep);
+        EXPECT_EQ(dsp::FFTPlan<double>(1024).kernel, dsp::FFTKernel::Radix4);
+
+        std::vector<std::complex<double>> x(N);
+        for (size_t n = 0; n < N; ++n) x[n] = { std::sin(0.001 * double(n * n % 7919)), std::cos(0.37 * double(n)) };
+        auto expected = x;
+        dsp::FFTPlan<double>(N, dsp::FFTKernel::Radix4).forward(expected);
+
+        auto X = x;
+        plan.forward(X);
+        double err = 0.0;
+        for (size_t k = 0; k < N; ++k) err = std::max(err, std::abs(X[k] - expected[k]));
+        EXPECT_LT(err, 1e-7);
+
+        plan.inverse(X);
+        err = 0.0;
+        for (size_t n = 0; n < N; ++n) err = std::max(err, std::abs(X[n] - x[n]));
+        EXPECT_LT(err, 1e-12);
+    }
+
+    TEST(FFTTest, BitReversedSpectrumMatchesForward) {
+        for (size_t N : { 1, 2, 4, 8, 32, 64, 512 }) {
+            std::vector<std::complex<double>> x(N);
+            for (size_t n = 0; n < N; ++n) x[n] = { std::sin(0.3 * double(n)) + 0.1 * double(n % 5), std::cos(1.7 * double(n)) };
+            auto expected = dsp::dft_direct(x);
+
+            for (auto kernel : { dsp::FFTKernel::Radix2, dsp::FFTKernel::Radix4, dsp::FFTKernel::SplitRadix }) {
+                dsp::FFTPlan<double> plan(N, kernel);
+                auto X = x;
+                plan.forward_bitreversed(X);
+                for (size_t k = 0; k < N; ++k) {
+                    ASSERT_NEAR(std::abs(X[k] - expected[plan.bitrev[k]]), 0.0, 1e-9 * double(N))
+                        << "N=" << N << " kernel=" << int(kernel) << " k=" << k;
+                }
+                plan.inverse_bitreversed(X);
+                for (size_t n = 0; n < N; ++n) {
+                    ASSERT_NEAR(std::abs(X[n] - x[n]), 0.0, 1e-12 * double(N)) << "N=" << N << " n=" << n;
+                }
+            }
+        }
+
+        std::vector<std::complex<double>> x(48);
+        EXPECT_THROW(dsp::FFTPlan<double>(48).forward_bitreversed(x), std::invalid_argument);
+        std::vector<std::complex<double>> wrong(32);
+        EXPECT_THROW(dsp::FFTPlan<double>(64).inverse_bitreversed(wrong), std::invalid_argument);
+    }
+
+    TEST(FFTTest, BitReversedSpectrumOfLargeDefaultPlan) {
+        // 2^17 complex doubles make Auto pick FourStep, which has no bitrev table: the spectrum
+        // is the four-step one before its transpose, X[k1*N2 + k2] at k2*N1 + k1
+        const size_t N = size_t(1) << 17;
+        std::vector<std::complex<double>> x(N);
+        for (size_t n = 0; n < N; ++n) x[n] = { std::sin(0.001 * double(n * n % 7919)), std::cos(0.37 * double(n)) };
+        dsp::FFTPlan<double> plan(N);
+        ASSERT_EQ(plan.kernel, dsp::FFTKernel::FourStep);
+        auto expected = x;
+        plan.forward(expected);
+
+        const size_t N1 = plan.sub_plans[1].N, N2 = N / N1;
+        auto X = x;
+        plan.forward_bitreversed(X);
+        double err = 0.0;
+        for (size_t k = 0; k < N; ++k) err = std::max(err, std::abs(X[k] - expected[(k % N1) * N2 + k / N1]));
+        EXPECT_LT(err, 1e-7);
+
+        plan.inverse_bitreversed(X);
+        err = 0.0;
+        for (size_t n = 0; n < N; ++n) err = std::max(err, std::abs(X[n] - x[n]));
+        EXPECT_LT(err, 1e-12);
+    }
+
+    TEST(FFTTest, BitReversedConvolutionMatchesDirect) {
+        using Q24 = FixedPoint<32, 24, SaturationPolicy>;
+        using CQ24 = std::complex<Q24>;
+        const size_t N = 256, taps = 16;
+        std::vector<CQ24> x(N), h(N, CQ24(Q24{ 0 }, Q24{ 0 }));
+        for (size_t n = 0; n < N; ++n) x[n] = { Q24(0.1 * std::sin(0.2 * double(n))), Q24(0.05 * std::cos(0.05 * double(n * n))) };
+        for (size_t n = 0; n < taps; ++n) h[n] = { Q24(0.05 * double(n % 4)), Q24(-0.02 * double(n % 3)) };
+
+        auto as_double = [](const CQ24& z) { return std::complex<double>(z.real().to_double(), z.imag().to_double()); };
+        for (auto kernel : { dsp::FFTKernel::Radix2, dsp::FFTKernel::Radix4, dsp::FFTKernel::SplitRadix }) {
+            dsp::FFTPlan<Q24> plan(N, kernel);
+            auto H = h;
+            plan.forward_bitreversed(H);
+
+            // Circular convolution and cross-correlation, never leaving bit-reversed order
+            auto conv = x;
+            plan.forward_bitreversed(conv);
+            auto corr = conv;
+            dsp::multiply_spectra(std::span<CQ24>(conv), std::span<const CQ24>(H));
+            dsp::multiply_spectra_conj(std::span<CQ24>(corr), std::span<const CQ24>(H));
+            plan.inverse_bitreversed(conv);
+            plan.inverse_bitreversed(corr);
+
+            double conv_err = 0.0, corr_err = 0.0;
+            for (size_t n = 0; n < N; ++n) {
+                std::complex<double> c = 0.0, r = 0.0;
+                for (size_t m = 0; m < taps; ++m) {
+                    c += as_double(x[(n + N - m) % N]) * as_double(h[m]);
+                    r += as_double(x[(n + m) % N]) * std::conj(as_double(h[m]));
+                }
+                conv_err = std::max(conv_err, std::abs(as_double(conv[n]) - c));
+                corr_err = std::max(corr_err, std::abs(as_double(corr[n]) - r));
+            }
+            EXPECT_LT(conv_err, 1e-5) << "kernel=" << int(kernel);
+            EXPECT_LT(corr_err, 1e-5) << "kernel=" << int(kernel);
+        }
+
+        std::vector<CQ24> short_spectrum(N / 2);
+        EXPECT_THROW(dsp::multiply_spectra(std::span<CQ24>(x), std::span<const CQ24>(short_spectrum)), std::invalid_argument);
+    }
+
+    TEST(FFTTest, ParallelMatchesSerialTransform) {
+        using Q15 = FixedPoint<16, 15, SaturationPolicy>;
+        using CQ15 = std::complex<Q15>;
+        // Square (2^14) and non-square (2^13) four-step splits, plus a kernel that stays serial
+        for (auto [N, kernel] : { std::pair{ size_t(1) << 14, dsp::FFTKernel::FourStep },
+                                  std::pair{ size_t(1) << 13, dsp::FFTKernel::FourStep },
+                                  std::pair{ size_t(1) << 10, dsp::FFTKernel::Radix4 } }) {
+            std::mt19937 rng(static_cast<unsigned>(N));
+            std::uniform_real_distribution<double> dist(-1.0 / 256, 1.0 / 256);
+            std::vector<CQ15> x(N);
+            for (auto& v : x) v = { Q15(dist(rng)), Q15(dist(rng)) };
+
+            dsp::FFTPlan<Q15> plan(N, kernel);
+            auto expected = x;
+            plan.forward(expected);
+            auto expected_inv = x;
+            plan.inverse(expected_inv);
+
+            // Small grains make many more tasks than threads
+            for (size_t threads : { 1, 3, 4 }) {
+                auto X = x;
+                plan.forward_parallel(X, threads, 512);
+                for (size_t k = 0; k < N; ++k) ASSERT_EQ(X[k], expected[k]) << "N=" << N << " threads=" << threads << " k=" << k;
+                X = x;
+                plan.inverse_parallel(X, threads, 512);
+                for (size_t n = 0; n < N; ++n) ASSERT_EQ(X[n], expected_inv[n]) << "N=" << N << " threads=" << threads << " n=" << n;
+            }
+        }
+
+        dsp::FFTPlan<double> plan(64);
+        std::vector<std::complex<double>> wrong(32);
+        EXPECT_THROW(plan.forward_parallel(wrong, 2), std::invalid_argument);
+    }
+
+    TEST(FFTTest, BatchMatchesSingleTransforms) {
+        using Q15 = FixedPoint<16, 15, SaturationPolicy>;
+        using CQ15 = std::complex<Q15>;
+        const size_t N = 64, howmany = 37;  // one full lane group, a partial one and a scalar tail
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<double> dist(-1.0 / N, 1.0 / N);
+        std::vector<std::vector<CQ15>> buffers(howmany, std::vector<CQ15>(N));
+        for (auto& b : buffers) for (auto& v : b) v = { Q15(dist(rng)), Q15(dist(rng)) };
+
+        dsp::FFTPlan<Q15> plan(N, dsp::FFTKernel::Radix2);
+        auto expected = buffers;
+        for (auto& b : expected) plan.forward(b);
+
+        // Separate buffers: bit-exact with forward(), on one thread or several
+        for (size_t threads : { 1, 3 }) {
+            auto batch = buffers;
+            plan.forward_batch(std::span<std::vector<CQ15>>(batch), threads);
+            for (size_t t = 0; t < howmany; ++t) {
+                for (size_t k = 0; k < N; ++k) ASSERT_EQ(batch[t][k], expected[t][k]) << "t=" << t << " k=" << k;
+            }
+        }
+
+        // Interleaved channels: sample n of channel t at [n * howmany + t]
+        std::vector<CQ15> interleaved(N * howmany);
+        for (size_t t = 0; t < howmany; ++t) {
+            for (size_t n = 0; n < N; ++n) interleaved[n * howmany + t] = buffers[t][n];
+        }
+        plan.forward_batch(std::span<CQ15>(interleaved), howmany, howmany, 1);
+        for (size_t t = 0; t < howmany; ++t) {
+            for (size_t k = 0; k < N; ++k) ASSERT_EQ(interleaved[k * howmany + t], expected[t][k]) << "t=" << t << " k=" << k;
+        }
+
+        // Views of rows of one array, and types without lane kernels
+        std::vector<std::complex<double>> rows(3 * N);
+        for (size_t i = 0; i < rows.size(); ++i) rows[i] = { std::sin(0.3 * double(i)), 0.25 };
+        dsp::FFTPlan<double> dplan(N);
+        auto drows = rows;
+        std::vector<std::span<std::complex<double>>> views;
+        for (size_t t = 0; t < 3; ++t) views.emplace_back(drows.data() + t * N, N);
+        dplan.forward_batch(std::span<const std::span<std::complex<double>>>(views));
+        for (size_t t = 0; t < 3; ++t) {
+            std::vector<std::complex<double>> one(rows.begin() + t * N, rows.begin() + (t + 1) * N);
+            dplan.forward(one);
+            for (size_t k = 0; k < N; ++k) EXPECT_EQ(drows[t * N + k], one[k]);
+        }
+
+        EXPECT_THROW(plan.forward_batch(std::span<CQ15>(interleaved), howmany + 1, howmany, 1), std::invalid_argument);
+        std::vector<std::vector<CQ15>> wrong{ std::vector<CQ15>(N), std::vector<CQ15>(N / 2) };
+        EXPECT_THROW(plan.forward_batch(std::span<std::vector<CQ15>>(wrong)), std::invalid_argument);
+    }
+
+    template<typename Fixed>
+    void expect_batch_matches_forward(dsp::FFTKernel kernel, size_t N, double range) {
+        using C = std::complex<Fixed>;
+        const size_t howmany = 21;
+        std::mt19937 rng(static_cast<unsigned>(N));
+        std::uniform_real_distribution<double> dist(-range, range);
+        std::vector<std::vector<C>> buffers(howmany, std::vector<C>(N));
+        for (auto& b : buffers) for (auto& v : b) v = { Fixed(dist(rng)), Fixed(dist(rng)) };
+
+        dsp::FFTPlan<Fixed> plan(N, kernel);
+        auto expected = buffers;
+        for (auto& b : expected) plan.forward(b);
+        plan.forward_batch(std::span<std::vector<C>>(buffers));
+        for (size_t t = 0; t < howmany; ++t) {
+            for (size_t k = 0; k < N; ++k) {
+                ASSERT_EQ(buffers[t][k], expected[t][k]) << "kernel=" << int(plan.kernel) << " N=" << N << " t=" << t << " k=" << k;
+            }
+        }
+    }
+
+    TEST(FFTTest, BatchMatchesForwardForEveryKernel) {
+        // Auto resolves to Radix4 at these sizes, whose lane path runs radix-4 passes; odd log2(N)
+        // starts with a radix-2 stage. Inputs of 0.5 saturate, which must happen in the same places.
+        using Q15 = FixedPoint<16, 15, SaturationPolicy>;
+        using Q31 = FixedPoint<32, 31, SaturationPolicy>;
+        for (auto kernel : { dsp::FFTKernel::Auto, dsp::FFTKernel::Radix2, dsp::FFTKernel::Radix4, dsp::FFTKernel::SplitRadix }) {
+            for (size_t N : { 2, 4, 8, 32, 64, 128, 1024 }) {
+                expect_batch_matches_forward<Q15>(kernel, N, 1.0 / double(N));
+                expect_batch_matches_forward<Q15>(kernel, N, 0.5);
+                expect_batch_matches_forward<Q31>(kernel, N, 0.5);
+            }
+        }
+    }
+
 }  // namespace
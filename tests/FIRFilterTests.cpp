@@ -70,6 +70,22 @@ namespace {
         EXPECT_TRUE(std::isfinite(out.to_float()));
     }
 
+    TEST(FIRFilterTest, ConstexprFilterMatchesRuntime) {
+        constexpr std::size_t Taps = 11;
+        static constexpr auto table = dsp::generate_lowpass_coefficients<Fixed, Taps>(48000.0, 1000.0);
+        auto runtime = dsp::generate_lowpass_coefficients<Fixed>(Taps, 48000.0, 1000.0);
+        for (std::size_t i = 0; i < Taps; ++i) {
+            EXPECT_EQ(table[i].raw(), runtime[i].raw()) << "tap " << i;
+        }
+
+        // A whole filter can be built and run during constant evaluation
+        constexpr Fixed first_output = [] {
+            auto filter = dsp::make_lowpass_filter<Fixed, Taps>(48000.0, 1000.0);
+            return filter.process(Fixed(1.0));
+        }();
+        EXPECT_EQ(first_output.raw(), table[0].raw());
+    }
+
     TEST(CoefficientTest, LowpassIsSymmetric) {
         constexpr std::size_t Taps = 7;  // odd-length for linear phase
         auto c = dsp::generate_lowpass_coefficients<Fixed>(
@@ -1,7 +1,12 @@
 ﻿#include "fixed_point/fixed_point.hpp"
+#include "fixed_point/accumulator.hpp"
+#include "fixed_point/reciprocal.hpp"
 #include <gtest/gtest.h>
+#include <bit>
+#include <cmath>
 #include <sstream>
 #include <limits>
+#include <random>
 
 // Type aliases for both policies
 using MyFixedSaturate = FixedPoint<16, 8, SaturationPolicy>;
@@ -205,3 +210,228 @@ TEST(FixedPointTest, EdgeCase_MaxMin) {
     EXPECT_LT(min_fp, max_fp);
     EXPECT_FALSE(max_fp == min_fp);
 }
+
+// ----------------- Constant Evaluation Tests -----------------
+
+TEST(FixedPointTest, ConstexprArithmetic) {
+    constexpr MyFixedSaturate a(2.5), b(1.5f);
+    static_assert((a + b).raw() == 1024);
+    static_assert((a - b).raw() == 256);
+    static_assert((a * b).raw() == 960);
+    static_assert((a / b).raw() == 426);
+    static_assert((-a).raw() == -640);
+    static_assert(a > b && a != b);
+
+    constexpr auto sat = MyFixedSaturate::from_raw(kMax) + MyFixedSaturate(1);
+    static_assert(sat.raw() == kMax);
+    constexpr auto wrap = MyFixedWrap::from_raw(kMax) + MyFixedWrap(1);
+    static_assert(wrap.raw() == kMin);
+
+    // Constant-evaluated rounding must match the runtime std::round path
+    constexpr MyFixedSaturate ct(-1.00390625 * 1.5);
+    volatile double rt_in = -1.00390625 * 1.5;
+    EXPECT_EQ(ct.raw(), MyFixedSaturate(static_cast<double>(rt_in)).raw());
+}
+
+// ----------------- Widening Multiply and Accumulator Tests -----------------
+
+TEST(FixedPointTest, WideningMulIsExact) {
+    MyFixedSaturate a = MyFixedSaturate::from_raw(kMax), b = MyFixedSaturate::from_raw(kMax);
+    auto p = widening_mul(a, b);
+    static_assert(std::is_same_v<decltype(p), FixedPoint<32, 16, SaturationPolicy>>);
+    EXPECT_EQ(p.raw(), int32_t(kMax) * int32_t(kMax));
+
+    // Mixed formats multiply into the exact product type
+    FixedPoint<16, 12, SaturationPolicy> c(0.75);
+    auto q = MyFixedSaturate(2.5) * c;
+    static_assert(std::is_same_v<decltype(q), FixedPoint<32, 20, SaturationPolicy>>);
+    EXPECT_DOUBLE_EQ(q.to_double(), 1.875);
+}
+
+TEST(FixedPointTest, AccumulatorSaturatesOnceAtNarrow) {
+    // Per-tap saturation would clamp the first partial sum; the accumulator keeps it
+    using Product = ProductType<MyFixedSaturate, MyFixedSaturate>;
+    Accumulator<Product> acc;
+    acc.mac(MyFixedSaturate(100.0), MyFixedSaturate(1.0));
+    acc.mac(MyFixedSaturate(100.0), MyFixedSaturate(1.0));
+    acc.mac(MyFixedSaturate(-90.0), MyFixedSaturate(1.0));
+    EXPECT_FLOAT_EQ(acc.narrow<MyFixedSaturate>().to_float(), 110.0f);
+
+    acc.mac(MyFixedSaturate(120.0), MyFixedSaturate(1.0));
+    EXPECT_EQ(acc.narrow<MyFixedSaturate>().raw(), kMax);
+    EXPECT_EQ(acc.narrow<MyFixedWrap>().raw(), kMin);
+}
+
+TEST(FixedPointTest, AccumulatorNarrowRounding) {
+    using fixed_point::Rounding;
+    using Product = ProductType<MyFixedSaturate, MyFixedSaturate>;
+    // 1.5 LSB and -1.5 LSB of the Q8 target
+    Accumulator<Product> pos(Product::from_raw(3 << 7));
+    Accumulator<Product> neg(Product::from_raw(-(3 << 7)));
+
+    EXPECT_EQ((pos.narrow<MyFixedSaturate, Rounding::Nearest>().raw()), 2);
+    EXPECT_EQ((neg.narrow<MyFixedSaturate, Rounding::Nearest>().raw()), -2);
+    EXPECT_EQ((pos.narrow<MyFixedSaturate, Rounding::NearestEven>().raw()), 2);
+    EXPECT_EQ((pos.narrow<MyFixedSaturate, Rounding::TowardZero>().raw()), 1);
+    EXPECT_EQ((neg.narrow<MyFixedSaturate, Rounding::TowardZero>().raw()), -1);
+    EXPECT_EQ((neg.narrow<MyFixedSaturate, Rounding::Floor>().raw()), -2);
+
+    // Narrowing to more fractional bits is an exact left shift
+    Accumulator<Product> one(Product(1));
+    EXPECT_EQ((one.narrow<FixedPoint<32, 24, SaturationPolicy>>().raw()), 1 << 24);
+}
+
+// ----------------- 64-bit Formats (128-bit intermediates) -----------------
+
+TEST(FixedPointTest, Wide64MulDoesNotOverflowBeforeShift) {
+    using Q32 = FixedPoint<64, 32, SaturationPolicy>;
+    Q32 a(123456.75), b(-2.5);
+    EXPECT_DOUBLE_EQ((a * b).to_double(), -308641.875);
+    EXPECT_NEAR((a / b).to_double(), -49382.7, 1e-9);
+
+    // Saturation still applies to the final result
+    Q32 big = Q32::from_raw(std::numeric_limits<int64_t>::max());
+    EXPECT_EQ((big * Q32(2.0)).raw(), std::numeric_limits<int64_t>::max());
+    EXPECT_EQ((big * Q32(-2.0)).raw(), std::numeric_limits<int64_t>::min());
+
+    using W32 = FixedPoint<64, 32, WrapAroundPolicy>;
+    EXPECT_DOUBLE_EQ((W32(1.5) * W32(-4.25)).to_double(), -6.375);
+    EXPECT_EQ((W32::from_raw(std::numeric_limits<int64_t>::max()) * W32(2.0)).raw(),
+              std::numeric_limits<int64_t>::min());
+}
+
+TEST(FixedPointTest, Wide64HighPrecisionPhase) {
+    // Q1.62 phase increment: the product needs all 124 bits of the intermediate
+    using Phase = FixedPoint<64, 62, SaturationPolicy>;
+    Phase inc = Phase::from_raw(int64_t(1) << 40);
+    Phase half(0.5);
+    EXPECT_EQ((inc * half).raw(), int64_t(1) << 39);
+    EXPECT_DOUBLE_EQ(half.to_double(), 0.5);
+}
+
+TEST(FixedPointTest, PortableInt128MatchesNative) {
+    using fixed_point::Int128;
+    std::mt19937_64 rng(5);
+    for (int i = 0; i < 2000; ++i) {
+        int64_t a = static_cast<int64_t>(rng()) >> (rng() % 63);
+        int64_t b = static_cast<int64_t>(rng()) >> (rng() % 63);
+        int shift = static_cast<int>(rng() % 63);
+        if (b == 0) b = 1;
+
+        Int128 wa(a), wb(b);
+        Int128 prod = wa * wb;
+        Int128 quot = (wa << shift) / wb;
+#if FIXED_POINT_HAS_INT128
+        __extension__ typedef __int128 native;
+        native np = native(a) * native(b);
+        native nq = (native(a) << shift) / native(b);
+        ASSERT_EQ(static_cast<int64_t>(prod), static_cast<int64_t>(np));
+        ASSERT_EQ(static_cast<int64_t>(prod >> 64), static_cast<int64_t>(np >> 64));
+        ASSERT_EQ(static_cast<int64_t>(quot), static_cast<int64_t>(nq));
+        ASSERT_EQ(static_cast<int64_t>(quot >> 64), static_cast<int64_t>(nq >> 64));
+        ASSERT_EQ(wa * wb > Int128(0), np > 0);
+#endif
+    }
+}
+
+// ----------------- Power-of-Two Scaling, Reciprocal, No-Throw Division -----------------
+
+TEST(FixedPointTest, ScalePow2MatchesMultiply) {
+    MyFixedSaturate a(3.75);
+    EXPECT_EQ(a.scale_pow2(2).raw(), (a * MyFixedSaturate(4.0)).raw());
+    EXPECT_EQ(a.scale_pow2(-3).raw(), (a * MyFixedSaturate(0.125)).raw());
+    EXPECT_EQ(ldexp(a, -1).raw(), MyFixedSaturate(1.875).raw());
+
+    // Right shifts round as requested
+    MyFixedSaturate odd = MyFixedSaturate::from_raw(-3);
+    EXPECT_EQ(odd.scale_pow2(-1).raw(), -2);
+    EXPECT_EQ(odd.scale_pow2<fixed_point::Rounding::TowardZero>(-1).raw(), -1);
+    EXPECT_EQ(odd.scale_pow2<fixed_point::Rounding::Nearest>(-1).raw(), -2);
+    EXPECT_EQ(MyFixedSaturate(1.0).scale_pow2<fixed_point::Rounding::Nearest>(-40).raw(), 0);
+
+    // Left shifts overflow through the policy
+    EXPECT_EQ(MyFixedSaturate(100.0).scale_pow2(1).raw(), kMax);
+    EXPECT_EQ(MyFixedSaturate(-100.0).scale_pow2(64).raw(), kMin);
+    EXPECT_EQ(MyFixedWrap(100.0).scale_pow2(1).raw(), kMin);
+
+    static_assert(MyFixedSaturate(1.5).scale_pow2(3) == MyFixedSaturate(12.0));
+}
+
+TEST(FixedPointTest, ReciprocalMatchesDivision) {
+    for (double d : { 3.0, -0.75, 0.00390625, 127.99609375, -128.0, 1.0, 5.5 }) {
+        MyFixedWrap divisor(d);
+        Reciprocal<MyFixedWrap> inv(divisor);
+        for (int raw = kMin; raw <= kMax; ++raw) {
+            auto x = MyFixedWrap::from_raw(static_cast<int16_t>(raw));
+            ASSERT_EQ(inv.apply(x).raw(), (x / divisor).raw()) << "d=" << d << " raw=" << raw;
+        }
+    }
+
+    using Q16 = FixedPoint<32, 16, SaturationPolicy>;
+    std::mt19937 rng(11);
+    for (int i = 0; i < 200; ++i) {
+        auto divisor = Q16::from_raw(static_cast<int32_t>(rng()) >> (rng() % 31));
+        if (divisor.raw() == 0) continue;
+        Reciprocal<Q16> inv(divisor);
+        for (int j = 0; j < 200; ++j) {
+            auto x = Q16::from_raw(static_cast<int32_t>(rng()));
+            if (x.raw() == std::numeric_limits<int32_t>::min()) continue;
+            ASSERT_EQ(inv.apply(x).raw(), (x / divisor).raw());
+        }
+    }
+
+    using Q32 = FixedPoint<64, 32, SaturationPolicy>;
+    Q32 a(-1234.5678), b(3.25);
+    EXPECT_EQ(Reciprocal<Q32>(b).apply(a).raw(), (a / b).raw());
+}
+
+TEST(FixedPointTest, ReciprocalFromCount) {
+    for (std::size_t n : { 1u, 3u, 7u, 10u, 255u, 1000u, 70000u }) {
+        auto inv = Reciprocal<MyFixedSaturate>::from_count(n);
+        for (int raw = kMin; raw <= kMax; raw += 37) {
+            auto x = MyFixedSaturate::from_raw(static_cast<int16_t>(raw));
+            ASSERT_EQ(inv.apply(x).raw(), static_cast<int16_t>(raw / static_cast<long long>(n)));
+        }
+    }
+    using Q16 = FixedPoint<32, 16>;
+    auto inv = Reciprocal<Q16>::from_count(3);
+    EXPECT_EQ(inv.apply(Q16(-9.0)).raw(), Q16(-3.0).raw());
+}
+
+TEST(FixedPointTest, ReciprocalRoundedFromCount) {
+    // Half away from zero, like scale_pow2<Rounding::Nearest>
+    for (std::size_t n : { 1u, 2u, 3u, 4u, 6u, 7u, 64u, 1000u, 70000u }) {
+        auto inv = Reciprocal<MyFixedSaturate>::from_count(n);
+        for (int raw = kMin; raw <= kMax; raw += 7) {
+            auto x = MyFixedSaturate::from_raw(static_cast<int16_t>(raw));
+            long long expected = std::llround(double(raw) / double(n));
+            ASSERT_EQ(inv.apply_rounded(x).raw(), expected) << "n=" << n << " raw=" << raw;
+            if (std::has_single_bit(n)) {
+                int shift = std::countr_zero(n);
+                ASSERT_EQ(inv.apply_rounded(x).raw(), x.scale_pow2<fixed_point::Rounding::Nearest>(-shift).raw());
+            }
+        }
+    }
+    using Q16 = FixedPoint<32, 16>;
+    EXPECT_EQ(Reciprocal<Q16>::from_count(3).apply_rounded(Q16::from_raw(-5)).raw(), -2);
+    EXPECT_EQ(Reciprocal<Q16>::from_count(6).apply_rounded(Q16::from_raw(9)).raw(), 2);
+}
+
+TEST(FixedPointTest, NoThrowDivisionByZero) {
+    using SatNoThrow = FixedPoint<16, 8, SaturationNoThrowPolicy>;
+    using WrapNoThrow = FixedPoint<16, 8, WrapAroundNoThrowPolicy>;
+    SatNoThrow zero{ 0 };
+    EXPECT_EQ((SatNoThrow(2.5) / zero).raw(), kMax);
+    EXPECT_EQ((SatNoThrow(-2.5) / zero).raw(), kMin);
+    EXPECT_EQ((zero / zero).raw(), 0);
+    EXPECT_EQ((WrapNoThrow(2.5) / WrapNoThrow{ 0 }).raw(), kMin);
+    EXPECT_EQ((WrapNoThrow(-2.5) / WrapNoThrow{ 0 }).raw(), kMax);
+
+    // Everything else behaves like the base policy
+    EXPECT_EQ((SatNoThrow(3.0) / SatNoThrow(1.5)).raw(), SatNoThrow(2.0).raw());
+    EXPECT_EQ((SatNoThrow(100.0) + SatNoThrow(100.0)).raw(), kMax);
+
+    auto inv = Reciprocal<SatNoThrow>(zero);
+    EXPECT_EQ(inv.apply(SatNoThrow(1.0)).raw(), kMax);
+    EXPECT_THROW(Reciprocal<MyFixedSaturate>(MyFixedSaturate{ 0 }).apply(MyFixedSaturate(1.0)), std::runtime_error);
+}
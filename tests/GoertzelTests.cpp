@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "dsp/cfixed.hpp"
+#include "dsp/dft.hpp"
+#include "dsp/goertzel.hpp"
+#include "fixed_point/fixed_point.hpp"
+
+using Q15 = FixedPoint<16, 15, SaturationPolicy>;
+using Q24 = FixedPoint<32, 24, SaturationPolicy>;
+
+namespace {
+
+    std::vector<double> random_signal(std::size_t N, unsigned seed, double range) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> dist(-range, range);
+        std::vector<double> x(N);
+        for (auto& v : x) v = dist(rng);
+        return x;
+    }
+
+    template<typename Sample>
+    std::vector<Sample> quantize(const std::vector<double>& x) {
+        return std::vector<Sample>(x.begin(), x.end());
+    }
+
+    template<typename Complex>
+    std::complex<double> as_double(const Complex& z) {
+        if constexpr (std::is_same_v<Complex, std::complex<double>>) return z;
+        else return { z.real().to_double(), z.imag().to_double() };
+    }
+
+    template<typename Sample>
+    double to_double(const Sample& x) {
+        if constexpr (std::is_floating_point_v<Sample>) return x;
+        else return x.to_double();
+    }
+
+    // Reference X[k]/N of the window, through the direct DFT in double
+    std::vector<std::complex<double>> scaled_dft(const std::vector<double>& x) {
+        std::vector<std::complex<double>> z(x.begin(), x.end());
+        auto X = dsp::dft_direct(z);
+        for (auto& v : X) v /= double(x.size());
+        return X;
+    }
+
+    template<typename Sample>
+    void expect_goertzel_matches_dft(double tol) {
+        const std::size_t N = 205;
+        auto x = random_signal(N, 3, 0.9);
+        auto samples = quantize<Sample>(x);
+        std::vector<double> x_q(N);
+        for (std::size_t n = 0; n < N; ++n) x_q[n] = to_double(samples[n]);
+        auto expected = scaled_dft(x_q);
+
+        std::vector<std::size_t> bins = { 0, 1, 18, 102, 204 };
+        dsp::GoertzelBank<Sample> bank(N, std::vector<double>(bins.begin(), bins.end()));
+        auto X = bank.analyze(samples);
+        auto P = bank.power(samples);
+        ASSERT_EQ(X.size(), bins.size());
+        for (std::size_t m = 0; m < bins.size(); ++m) {
+            auto got = as_double(X[m]);
+            EXPECT_NEAR(std::abs(got - expected[bins[m]]), 0.0, tol) << "bin " << bins[m];
+            EXPECT_NEAR(to_double(P[m]), std::norm(got), 4 * tol) << "bin " << bins[m];
+        }
+    }
+
+    TEST(GoertzelTest, IntegerBinsMatchDFT) {
+        expect_goertzel_matches_dft<double>(1e-12);
+        expect_goertzel_matches_dft<Q15>(4.0 / 32768);
+        expect_goertzel_matches_dft<Q24>(4.0 / (1 << 24));
+    }
+
+    TEST(GoertzelTest, DetectsToneBetweenBins) {
+        // DTMF: 770 Hz + 1336 Hz at 8 kHz, 205-sample frames; the row/column tones are not on bins
+        const double fs = 8000.0;
+        const std::size_t N = 205;
+        std::vector<Q15> frame(N);
+        for (std::size_t n = 0; n < N; ++n) {
+            double t = double(n) / fs;
+            frame[n] = Q15(0.4 * std::cos(2 * std::numbers::pi * 770 * t) + 0.4 * std::cos(2 * std::numbers::pi * 1336 * t));
+        }
+        std::vector<double> freqs = { 697, 770, 852, 941, 1209, 1336, 1477 };
+        std::vector<double> bins;
+        for (double f : freqs) bins.push_back(f * double(N) / fs);
+        dsp::GoertzelBank<Q15> bank(N, bins);
+        auto P = bank.power(frame);
+        // A tone a*cos reads (a/2)^2 = 0.04 on its own frequency
+        for (std::size_t m = 0; m < freqs.size(); ++m) {
+            bool present = freqs[m] == 770 || freqs[m] == 1336;
+            if (present) {
+                EXPECT_NEAR(P[m].to_double(), 0.04, 0.002) << freqs[m] << " Hz";
+            } else {
+                EXPECT_LT(P[m].to_double(), 0.004) << freqs[m] << " Hz";
+            }
+        }
+    }
+
+    // A constant full-scale frame: bin 0 drives the resonator to N(N+1)/2 samples' worth
+    template<typename Sample>
+    void expect_full_scale_dc(std::size_t N, double bin) {
+        const Sample top = Sample::from_raw(std::numeric_limits<typename Sample::StorageType>::max());
+        std::vector<Sample> frame(N, top);
+        std::complex<double> expected = 0.0;
+        for (std::size_t n = 0; n < N; ++n) {
+            expected += std::polar(top.to_double(), -2.0 * std::numbers::pi * bin * double(n) / double(N));
+        }
+        expected /= double(N);
+
+        dsp::GoertzelBank<Sample> bank(N, { bin });
+        auto X = as_double(bank.analyze(frame)[0]);
+        const double lsb = std::ldexp(1.0, -Sample::fractional_bits);
+        EXPECT_NEAR(std::abs(X - expected), 0.0, 2 * lsb) << "N=" << N << " bin " << bin;
+    }
+
+    TEST(GoertzelTest, FullScaleDCDoesNotOverflow) {
+        using Q8_8 = FixedPoint<16, 8, SaturationPolicy>;
+        expect_full_scale_dc<Q15>(4096, 0.0);
+        expect_full_scale_dc<Q8_8>(4096, 0.0);
+        expect_full_scale_dc<Q8_8>(8192, 0.5);
+        expect_full_scale_dc<Q24>(4096, 0.0);
+        expect_full_scale_dc<Q24>(65536, 0.0);
+    }
+
+    template<typename Sample>
+    void expect_sliding_matches_window_dft(double damping, double tol) {
+        const std::size_t N = 64;
+        auto x = random_signal(5 * N + 17, 7, 0.9);
+        auto samples = quantize<Sample>(x);
+        std::vector<std::size_t> bins = { 0, 3, 32, 63, 64 + 5 };
+        dsp::SlidingDFT<Sample> sdft(N, bins, damping);
+        EXPECT_EQ(sdft.bins()[4], 5u);
+        for (std::size_t n = 0; n < samples.size(); ++n) {
+            sdft.process(samples[n]);
+            if (n + 1 < N || (n % 29) != 0) continue;
+            std::vector<double> window(N);
+            for (std::size_t i = 0; i < N; ++i) window[i] = to_double(samples[n + 1 - N + i]);
+            auto expected = scaled_dft(window);
+            auto values = sdft.values();
+            for (std::size_t m = 0; m < bins.size(); ++m) {
+                EXPECT_NEAR(std::abs(as_double(values[m]) - expected[sdft.bins()[m]]), 0.0, tol)
+                    << "n=" << n << " bin " << sdft.bins()[m];
+            }
+        }
+    }
+
+    TEST(SlidingDFTTest, TracksWindowDFT) {
+        expect_sliding_matches_window_dft<double>(1.0, 1e-12);
+        expect_sliding_matches_window_dft<double>(dsp::sliding_dft_damping, 1e-4);
+        expect_sliding_matches_window_dft<Q15>(dsp::sliding_dft_damping, 4.0 / 32768);
+        expect_sliding_matches_window_dft<Q24>(dsp::sliding_dft_damping, 1e-4);
+    }
+
+    TEST(SlidingDFTTest, FixedPointErrorsDoNotBuildUp) {
+        // A long run of full-scale noise, then N zeros: the window is empty again, and the bins
+        // must come back to within rounding of zero instead of holding accumulated error
+        const std::size_t N = 256;
+        dsp::SlidingDFT<Q15> sdft(N, { 1, 17, 100, 128 });
+        auto noise = quantize<Q15>(random_signal(200000, 11, 0.99));
+        sdft.process(std::span<const Q15>(noise));
+        for (std::size_t n = 0; n < N; ++n) sdft.process(Q15(0.0));
+        for (const auto& v : sdft.values()) {
+            EXPECT_LE(std::abs(v.real().raw()), 2);
+            EXPECT_LE(std::abs(v.imag().raw()), 2);
+        }
+
+        sdft.reset();
+        for (const auto& v : sdft.values()) EXPECT_EQ(v.real().raw(), 0);
+    }
+
+    TEST(GoertzelTest, RejectsBadArguments) {
+        EXPECT_THROW(dsp::GoertzelBank<Q15>(0, { 1.0 }), std::invalid_argument);
+        dsp::GoertzelBank<Q15> bank(8, { 1.0 });
+        std::vector<Q15> short_frame(4);
+        EXPECT_THROW(bank.analyze(short_frame), std::invalid_argument);
+        EXPECT_THROW(dsp::SlidingDFT<Q15>(0, { 1 }), std::invalid_argument);
+        EXPECT_THROW(dsp::SlidingDFT<Q15>(8, { 1 }, 1.5), std::invalid_argument);
+        // Past the state's range: N^2/2 (Goertzel, 32-bit samples) and N (sliding DFT, 16-bit)
+        EXPECT_THROW(dsp::GoertzelBank<Q24>(std::size_t(1) << 24, { 1.0 }), std::invalid_argument);
+        EXPECT_THROW(dsp::SlidingDFT<Q15>(std::size_t(1) << 19, { 1 }), std::invalid_argument);
+    }
+
+}  // namespace
@@ -0,0 +1,95 @@
+// Built as its own executable with FIXED_POINT_COUNT_OVERFLOWS defined (see CMakeLists.txt),
+// so the counted and uncounted builds of the headers never meet in one program
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "fixed_point/fixed_point.hpp"
+#include "fixed_point/accumulator.hpp"
+#include "fixed_point/instrumentation.hpp"
+#include "fixed_point/simd.hpp"
+
+using CountedSat = FixedPoint<16, 8, CountingSaturationPolicy>;
+using CountedWrap = FixedPoint<16, 8, CountingWrapAroundPolicy>;
+using PlainSat = FixedPoint<16, 8, SaturationPolicy>;
+using PlainWrap = FixedPoint<16, 8, WrapAroundPolicy>;
+using fixed_point::OverflowOp;
+
+namespace {
+
+    TEST(InstrumentationTest, CountsEachOperationType) {
+        fixed_point::reset_overflow_counts<CountedSat>();
+        CountedSat big(100.0), small(0.5), zero(0.0);
+
+        (void)(big + big);      // add overflow
+        (void)(-big - big);     // sub overflow
+        (void)(big * big);      // mul overflow
+        (void)(big / small);    // div overflow
+        (void)big.scale_pow2(2);  // narrow overflow
+        (void)(big + small);    // in range, not counted
+        (void)(small * small);
+        EXPECT_THROW((void)(big / zero), std::runtime_error);  // counted as a div overflow, then thrown by the base
+
+        auto counts = fixed_point::overflow_counts<CountedSat>();
+        EXPECT_EQ(counts[OverflowOp::Add], 1u);
+        EXPECT_EQ(counts[OverflowOp::Sub], 1u);
+        EXPECT_EQ(counts[OverflowOp::Mul], 1u);
+        EXPECT_EQ(counts[OverflowOp::Div], 2u);
+        EXPECT_EQ(counts[OverflowOp::Narrow], 1u);
+        EXPECT_EQ(counts.total(), 6u);
+
+        // Counters are per format
+        EXPECT_EQ(fixed_point::overflow_counts<CountedWrap>().total(), 0u);
+        EXPECT_EQ(fixed_point::overflow_counts<PlainSat>().total(), 0u);
+
+        fixed_point::reset_overflow_counts<CountedSat>();
+        EXPECT_EQ(fixed_point::overflow_counts<CountedSat>().total(), 0u);
+    }
+
+    TEST(InstrumentationTest, ResultsMatchBasePolicy) {
+        for (int a = -32768; a <= 32767; a += 97) {
+            for (int b = -32768; b <= 32767; b += 1013) {
+                auto sa = static_cast<int16_t>(a), sb = static_cast<int16_t>(b);
+                ASSERT_EQ((CountedSat::from_raw(sa) * CountedSat::from_raw(sb)).raw(),
+                          (PlainSat::from_raw(sa) * PlainSat::from_raw(sb)).raw());
+                ASSERT_EQ((CountedWrap::from_raw(sa) + CountedWrap::from_raw(sb)).raw(),
+                          (PlainWrap::from_raw(sa) + PlainWrap::from_raw(sb)).raw());
+            }
+        }
+    }
+
+    TEST(InstrumentationTest, AggregatesAcrossThreads) {
+        fixed_point::reset_overflow_counts<CountedWrap>();
+        constexpr int kThreads = 4, kPerThread = 1000;
+        std::vector<std::thread> workers;
+        for (int t = 0; t < kThreads; ++t) {
+            workers.emplace_back([] {
+                CountedWrap big(120.0);
+                for (int i = 0; i < kPerThread; ++i) (void)(big + big);
+            });
+        }
+        for (auto& w : workers) w.join();
+
+        // Exited threads are folded in, and the live main thread is added on top
+        CountedWrap big(120.0);
+        (void)(big * big);
+        auto counts = fixed_point::overflow_counts<CountedWrap>();
+        EXPECT_EQ(counts[OverflowOp::Add], uint64_t(kThreads * kPerThread));
+        EXPECT_EQ(counts[OverflowOp::Mul], 1u);
+    }
+
+    TEST(InstrumentationTest, BatchAndAccumulatorPathsAreCounted) {
+        fixed_point::reset_overflow_counts<CountedSat>();
+        std::vector<CountedSat> a(64, CountedSat(100.0)), out(64);
+        fixed_point::simd::add<CountedSat>(a, a, out);
+        EXPECT_EQ(out[0].raw(), std::numeric_limits<int16_t>::max());
+        EXPECT_EQ(fixed_point::overflow_counts<CountedSat>()[OverflowOp::Add], 64u);
+
+        Accumulator<ProductType<CountedSat, CountedSat>> acc;
+        acc.mac(CountedSat(100.0), CountedSat(100.0));
+        EXPECT_EQ(acc.narrow<CountedSat>().raw(), std::numeric_limits<int16_t>::max());
+        EXPECT_EQ(fixed_point::overflow_counts<CountedSat>()[OverflowOp::Narrow], 1u);
+    }
+
+}  // namespace
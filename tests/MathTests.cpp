@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <random>
+
+#include "fixed_point/fixed_point.hpp"
+#include "fixed_point/math.hpp"
+
+using Q16 = FixedPoint<32, 16, SaturationPolicy>;
+using Q8 = FixedPoint<16, 8, SaturationPolicy>;
+using fixed_point::MathMethod;
+
+namespace {
+
+    constexpr double kLsb = 1.0 / 65536.0;
+
+    TEST(MathTest, SinCosCordicAccuracy) {
+        for (double a = -10.0; a <= 10.0; a += 0.01) {
+            Q16 angle(a);
+            double exact = angle.to_double();
+            auto [s, c] = fixed_point::sincos(angle);
+            ASSERT_NEAR(s.to_double(), std::sin(exact), 3 * kLsb) << "a=" << a;
+            ASSERT_NEAR(c.to_double(), std::cos(exact), 3 * kLsb) << "a=" << a;
+        }
+    }
+
+    TEST(MathTest, SinCosTableAccuracy) {
+        for (double a = -10.0; a <= 10.0; a += 0.01) {
+            Q16 angle(a);
+            double exact = angle.to_double();
+            // 1024 entries: interpolation error (2*pi/1024)^2 / 8 ~ 4.7e-6, plus output rounding
+            ASSERT_NEAR(fixed_point::sin<MathMethod::Table>(angle).to_double(), std::sin(exact), 5e-6 + kLsb) << "a=" << a;
+            ASSERT_NEAR(fixed_point::cos<MathMethod::Table>(angle).to_double(), std::cos(exact), 5e-6 + kLsb) << "a=" << a;
+            // A bigger table is more accurate
+            ASSERT_NEAR((fixed_point::sin<MathMethod::Table, 14>(angle).to_double()), std::sin(exact), 2 * kLsb) << "a=" << a;
+        }
+    }
+
+    TEST(MathTest, FewerIterationsAreCoarser) {
+        Q16 angle(0.7);
+        double exact = std::sin(angle.to_double());
+        EXPECT_NEAR((fixed_point::sin<MathMethod::Cordic, 8>(angle).to_double()), exact, 1e-2);
+        EXPECT_GT(std::abs((fixed_point::sin<MathMethod::Cordic, 4>(angle).to_double()) - exact), 1e-3);
+    }
+
+    TEST(MathTest, Atan2AllQuadrants) {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<double> dist(-100.0, 100.0);
+        for (int i = 0; i < 2000; ++i) {
+            Q16 y(dist(rng)), x(dist(rng));
+            double exact = std::atan2(y.to_double(), x.to_double());
+            ASSERT_NEAR(fixed_point::atan2(y, x).to_double(), exact, 3 * kLsb);
+            ASSERT_NEAR((fixed_point::atan2<MathMethod::Table>(y, x)).to_double(), exact, 2e-6 + kLsb);
+        }
+        EXPECT_NEAR(fixed_point::atan2(Q16(0.0), Q16(-1.0)).to_double(), std::numbers::pi, kLsb);
+        EXPECT_NEAR(fixed_point::atan2(Q16(-1.0), Q16(0.0)).to_double(), -std::numbers::pi / 2, kLsb);
+        EXPECT_EQ(fixed_point::atan2(Q16(0.0), Q16(0.0)).raw(), 0);
+    }
+
+    TEST(MathTest, MagnitudeMatchesHypot) {
+        std::mt19937 rng(4);
+        std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+        for (int i = 0; i < 2000; ++i) {
+            Q16 x(dist(rng)), y(dist(rng));
+            double exact = std::hypot(x.to_double(), y.to_double());
+            ASSERT_NEAR(fixed_point::magnitude(x, y).to_double(), exact, std::max(2 * kLsb, exact * 1e-7));
+        }
+        // Tiny inputs keep their precision, out-of-range results follow the policy
+        EXPECT_EQ(fixed_point::magnitude(Q16::from_raw(3), Q16::from_raw(-4)).raw(), 5);
+        EXPECT_EQ(fixed_point::magnitude(Q8(100.0), Q8(100.0)).raw(), std::numeric_limits<int16_t>::max());
+    }
+
+    TEST(MathTest, SqrtIsExactlyRounded) {
+        EXPECT_EQ(fixed_point::sqrt(Q16(2.25)).raw(), Q16(1.5).raw());
+        EXPECT_EQ(fixed_point::sqrt(Q16(0.0)).raw(), 0);
+        EXPECT_EQ(fixed_point::sqrt(Q16(-4.0)).raw(), 0);
+        for (int32_t raw = 1; raw < (1 << 30); raw += 7919) {
+            Q16 x = Q16::from_raw(raw);
+            double exact = std::sqrt(x.to_double()) * 65536.0;
+            ASSERT_EQ(fixed_point::sqrt(x).raw(), static_cast<int32_t>(std::llround(exact))) << raw;
+        }
+        using Q32 = FixedPoint<64, 32, SaturationPolicy>;
+        EXPECT_NEAR(fixed_point::sqrt(Q32(1e9)).to_double(), std::sqrt(1e9), 1e-9);
+    }
+
+    TEST(MathTest, Log2Accuracy) {
+        for (double v : { 1.0, 2.0, 0.5, 3.0, 10.0, 1000.0, 0.001, 32767.0 }) {
+            ASSERT_NEAR(fixed_point::log2(Q16(v)).to_double(), std::log2(Q16(v).to_double()), 2 * kLsb) << v;
+        }
+        EXPECT_EQ(fixed_point::log2(Q16(8.0)).raw(), Q16(3.0).raw());
+        EXPECT_EQ(fixed_point::log2(Q16(0.0)).raw(), std::numeric_limits<int32_t>::min());
+    }
+
+    TEST(MathTest, ConstexprEvaluation) {
+        static_assert(fixed_point::sqrt(Q16(16.0)) == Q16(4.0));
+        static_assert(fixed_point::log2(Q16(0.25)) == Q16(-2.0));
+        constexpr Q16 s = fixed_point::sin(Q16(0.0));
+        EXPECT_EQ(s.raw(), 0);
+    }
+
+}  // namespace
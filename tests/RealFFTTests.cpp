@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "dsp/cfixed.hpp"
+#include "dsp/dft.hpp"
+#include "dsp/real_fft.hpp"
+#include "fixed_point/fixed_point.hpp"
+
+using Fixed = FixedPoint<16, 8, SaturationPolicy>;
+using Q24 = FixedPoint<32, 24, SaturationPolicy>;
+
+namespace {
+
+    std::vector<double> test_signal(std::size_t N) {
+        std::vector<double> x(N);
+        for (std::size_t n = 0; n < N; ++n) {
+            x[n] = 0.6 * std::sin(0.37 * double(n)) + 0.3 * std::cos(2.1 * double(n) + 0.4) + (n % 3 == 0 ? 0.05 : -0.02);
+        }
+        return x;
+    }
+
+    TEST(RealFFTTest, MatchesRealDFTForAllSizes) {
+        for (std::size_t N : { 2, 4, 8, 16, 64, 256 }) {
+            auto x = test_signal(N);
+            auto expected = dsp::dft_direct(x);
+
+            dsp::RealFFTPlan<double> plan(N);
+            std::vector<std::complex<double>> X;
+            plan.forward(x, X);
+            ASSERT_EQ(X.size(), N / 2 + 1);
+            for (std::size_t k = 0; k <= N / 2; ++k) {
+                EXPECT_NEAR(std::abs(X[k] - expected[k]), 0.0, 1e-9 * double(N)) << "N=" << N << " k=" << k;
+            }
+
+            std::vector<double> y;
+            plan.inverse(X, y);
+            ASSERT_EQ(y.size(), N);
+            for (std::size_t n = 0; n < N; ++n) {
+                EXPECT_NEAR(y[n], x[n], 1e-12 * double(N)) << "N=" << N << " n=" << n;
+            }
+        }
+    }
+
+    TEST(RealFFTTest, FixedPointMatchesDouble) {
+        const std::size_t N = 128;
+        auto x = test_signal(N);
+        std::vector<Q24> xq(N);
+        for (std::size_t n = 0; n < N; ++n) xq[n] = Q24(x[n]);
+        auto expected = dsp::dft_direct(x);
+
+        dsp::RealFFTPlan<Q24, dsp::cfixed<Q24>> plan(N);
+        std::vector<dsp::cfixed<Q24>> X;
+        plan.forward(xq, X);
+        for (std::size_t k = 0; k <= N / 2; ++k) {
+            EXPECT_NEAR(X[k].re.to_double(), expected[k].real(), 1e-4) << "k=" << k;
+            EXPECT_NEAR(X[k].im.to_double(), expected[k].imag(), 1e-4) << "k=" << k;
+        }
+
+        std::vector<Q24> y;
+        plan.inverse(X, y);
+        for (std::size_t n = 0; n < N; ++n) {
+            EXPECT_NEAR(y[n].to_double(), x[n], 1e-5) << "n=" << n;
+        }
+    }
+
+    TEST(RealFFTTest, StdComplexFixedSpectrum) {
+        // DC and Nyquist bins are real
+        const std::size_t N = 16;
+        std::vector<Fixed> x(N);
+        for (std::size_t n = 0; n < N; ++n) x[n] = Fixed(n % 2 == 0 ? 1.0 : 0.5);
+        dsp::RealFFTPlan<Fixed> plan(N);
+        std::vector<std::complex<Fixed>> X;
+        plan.forward(x, X);
+        EXPECT_NEAR(X[0].real().to_double(), 12.0, 0.05);
+        EXPECT_NEAR(X[N / 2].real().to_double(), 4.0, 0.05);
+        for (std::size_t k = 1; k < N / 2; ++k) {
+            EXPECT_NEAR(std::abs(X[k].real().to_double()) + std::abs(X[k].imag().to_double()), 0.0, 0.05) << "k=" << k;
+        }
+    }
+
+    TEST(RealFFTTest, RejectsBadSizes) {
+        EXPECT_THROW(dsp::RealFFTPlan<double>(1), std::invalid_argument);
+        EXPECT_THROW(dsp::RealFFTPlan<double>(12), std::invalid_argument);
+
+        dsp::RealFFTPlan<double> plan(8);
+        std::vector<std::complex<double>> X;
+        EXPECT_THROW(plan.forward(std::vector<double>(4), X), std::invalid_argument);
+        X.resize(3);
+        std::vector<double> y;
+        EXPECT_THROW(plan.inverse(X, y), std::invalid_argument);
+    }
+
+}  // namespace
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <limits>
+
+#include "fixed_point/simd.hpp"
+#include "fixed_point/fixed_point.hpp"
+
+namespace {
+
+    namespace simd = fixed_point::simd;
+
+    // Random raw values, biased towards the extremes so every overflow path is exercised
+    template<typename Fixed>
+    std::vector<Fixed> random_buffer(std::size_t n, unsigned seed) {
+        using S = typename Fixed::StorageType;
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<long long> dist(std::numeric_limits<S>::min(), std::numeric_limits<S>::max());
+        std::vector<Fixed> v(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            switch (rng() % 8) {
+                case 0:  v[i] = Fixed::from_raw(std::numeric_limits<S>::max()); break;
+                case 1:  v[i] = Fixed::from_raw(std::numeric_limits<S>::min()); break;
+                case 2:  v[i] = Fixed::from_raw(static_cast<S>(dist(rng) >> (sizeof(S) * 4))); break;
+                default: v[i] = Fixed::from_raw(static_cast<S>(dist(rng))); break;
+            }
+        }
+        return v;
+    }
+
+    // Run every op at every available dispatch level and compare with the scalar operators
+    template<typename Fixed>
+    void expect_bit_exact() {
+        const std::size_t n = 1000 + 13;  // not a multiple of any vector width
+        auto a = random_buffer<Fixed>(n, 1);
+        auto b = random_buffer<Fixed>(n, 2);
+        auto acc0 = random_buffer<Fixed>(n, 3);
+        Fixed k = b[7];
+
+        for (int lvl = 0; lvl <= static_cast<int>(simd::detected_level()); ++lvl) {
+            simd::set_level(static_cast<simd::SimdLevel>(lvl));
+            std::vector<Fixed> sum(n), diff(n), prod(n), scaled(n), acc = acc0;
+            simd::add<Fixed>(a, b, sum);
+            simd::sub<Fixed>(a, b, diff);
+            simd::mul<Fixed>(a, b, prod);
+            simd::mac<Fixed>(a, b, acc);
+            simd::scale<Fixed>(a, k, scaled);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                ASSERT_EQ(sum[i].raw(), (a[i] + b[i]).raw()) << "add level " << lvl << " i=" << i;
+                ASSERT_EQ(diff[i].raw(), (a[i] - b[i]).raw()) << "sub level " << lvl << " i=" << i;
+                ASSERT_EQ(prod[i].raw(), (a[i] * b[i]).raw()) << "mul level " << lvl << " i=" << i;
+                ASSERT_EQ(acc[i].raw(), (acc0[i] + a[i] * b[i]).raw()) << "mac level " << lvl << " i=" << i;
+                ASSERT_EQ(scaled[i].raw(), (a[i] * k).raw()) << "scale level " << lvl << " i=" << i;
+            }
+        }
+        simd::set_level(simd::detected_level());
+    }
+
+    TEST(SimdTest, Q16SaturateBitExact) {
+        expect_bit_exact<FixedPoint<16, 8, SaturationPolicy>>();
+        expect_bit_exact<FixedPoint<16, 15, SaturationPolicy>>();
+        expect_bit_exact<FixedPoint<12, 4, SaturationPolicy>>();
+    }
+
+    TEST(SimdTest, Q16WrapBitExact) {
+        expect_bit_exact<FixedPoint<16, 8, WrapAroundPolicy>>();
+        expect_bit_exact<FixedPoint<16, 0, WrapAroundPolicy>>();
+    }
+
+    TEST(SimdTest, Q32SaturateBitExact) {
+        expect_bit_exact<FixedPoint<32, 16, SaturationPolicy>>();
+        expect_bit_exact<FixedPoint<32, 31, SaturationPolicy>>();
+    }
+
+    TEST(SimdTest, Q32WrapBitExact) {
+        expect_bit_exact<FixedPoint<32, 16, WrapAroundPolicy>>();
+        expect_bit_exact<FixedPoint<32, 0, WrapAroundPolicy>>();
+    }
+
+    TEST(SimdTest, ScalarFallbackForOtherWidths) {
+        expect_bit_exact<FixedPoint<8, 4, SaturationPolicy>>();
+    }
+
+    // Split-complex butterflies against the same operators std::complex<Fixed> uses
+    template<typename Fixed>
+    void expect_butterfly_bit_exact() {
+        const std::size_t n = 200 + 7;
+        auto ur0 = random_buffer<Fixed>(n, 4), ui0 = random_buffer<Fixed>(n, 5);
+        auto xr0 = random_buffer<Fixed>(n, 6), xi0 = random_buffer<Fixed>(n, 7);
+        auto wr = random_buffer<Fixed>(n, 8), wi = random_buffer<Fixed>(n, 9);
+
+        for (int lvl = 0; lvl <= static_cast<int>(simd::detected_level()); ++lvl) {
+            simd::set_level(static_cast<simd::SimdLevel>(lvl));
+            // Table, broadcast and the two multiply-free twiddles (W = 1, W = -j)
+            for (int mode = 0; mode < 4; ++mode) {
+                auto ur = ur0, ui = ui0, xr = xr0, xi = xi0;
+                if (mode == 0) simd::butterfly<Fixed>(ur, ui, xr, xi, wr, wi);
+                if (mode == 1) simd::butterfly<Fixed>(ur, ui, xr, xi, wr[3], wi[3]);
+                if (mode == 2) simd::butterfly_one<Fixed>(ur, ui, xr, xi);
+                if (mode == 3) simd::butterfly_minus_j<Fixed>(ur, ui, xr, xi);
+
+                for (std::size_t i = 0; i < n; ++i) {
+                    Fixed vr, vi;
+                    if (mode == 2) {
+                        vr = xr0[i];
+                        vi = xi0[i];
+                    } else if (mode == 3) {
+                        vr = xi0[i];
+                        vi = -xr0[i];
+                    } else {
+                        Fixed w_r = mode == 0 ? wr[i] : wr[3], w_i = mode == 0 ? wi[i] : wi[3];
+                        vr = xr0[i] * w_r - xi0[i] * w_i;
+                        vi = xr0[i] * w_i + xi0[i] * w_r;
+                    }
+                    ASSERT_EQ(ur[i].raw(), (ur0[i] + vr).raw()) << "level " << lvl << " mode " << mode << " i=" << i;
+                    ASSERT_EQ(ui[i].raw(), (ui0[i] + vi).raw()) << "level " << lvl << " mode " << mode << " i=" << i;
+                    ASSERT_EQ(xr[i].raw(), (ur0[i] - vr).raw()) << "level " << lvl << " mode " << mode << " i=" << i;
+                    ASSERT_EQ(xi[i].raw(), (ui0[i] - vi).raw()) << "level " << lvl << " mode " << mode << " i=" << i;
+                }
+            }
+        }
+        simd::set_level(simd::detected_level());
+    }
+
+    TEST(SimdTest, ButterflyBitExact) {
+        expect_butterfly_bit_exact<FixedPoint<16, 15, SaturationPolicy>>();
+        expect_butterfly_bit_exact<FixedPoint<16, 8, WrapAroundPolicy>>();
+        expect_butterfly_bit_exact<FixedPoint<32, 24, SaturationPolicy>>();
+        expect_butterfly_bit_exact<FixedPoint<32, 16, WrapAroundPolicy>>();
+        expect_butterfly_bit_exact<FixedPoint<8, 4, SaturationPolicy>>();
+    }
+
+    TEST(SimdTest, SizeMismatchThrows) {
+        using Fixed = FixedPoint<16, 8, SaturationPolicy>;
+        std::vector<Fixed> a(4), b(5), out(4);
+        EXPECT_THROW(simd::add<Fixed>(a, b, out), std::invalid_argument);
+        EXPECT_THROW(simd::butterfly<Fixed>(a, out, out, out, a, b), std::invalid_argument);
+    }
+
+} // namespace
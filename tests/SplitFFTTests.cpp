@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <complex>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "dsp/cfixed.hpp"
+#include "dsp/dft.hpp"
+#include "dsp/fft.hpp"
+#include "dsp/split_fft.hpp"
+#include "fixed_point/fixed_point.hpp"
+#include "fixed_point/simd.hpp"
+
+using Q15 = FixedPoint<16, 15, SaturationPolicy>;
+using Q24 = FixedPoint<32, 24, SaturationPolicy>;
+
+namespace {
+
+    template<typename Sample>
+    std::vector<std::complex<Sample>> random_signal(std::size_t N, unsigned seed, double range) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> dist(-range, range);
+        std::vector<std::complex<Sample>> x(N);
+        for (auto& v : x) v = { Sample(dist(rng)), Sample(dist(rng)) };
+        return x;
+    }
+
+    // Same bits as the AoS radix-2 plan, at every SIMD level
+    template<typename Fixed>
+    void expect_matches_aos_plan(std::size_t N) {
+        auto x = random_signal<Fixed>(N, unsigned(N), 1.0 / double(N));
+        dsp::FFTPlan<Fixed> aos(N, dsp::FFTKernel::Radix2);
+        dsp::SplitFFTPlan<Fixed> split(N);
+        auto expected = x;
+        aos.forward(expected);
+        auto expected_inv = x;
+        aos.inverse(expected_inv);
+
+        namespace simd = fixed_point::simd;
+        for (int lvl = 0; lvl <= static_cast<int>(simd::detected_level()); ++lvl) {
+            simd::set_level(static_cast<simd::SimdLevel>(lvl));
+            std::vector<Fixed> re(N), im(N);
+            dsp::deinterleave(std::span<const std::complex<Fixed>>(x), std::span<Fixed>(re), std::span<Fixed>(im));
+            split.forward(re, im);
+            for (std::size_t k = 0; k < N; ++k) {
+                ASSERT_EQ(re[k].raw(), expected[k].real().raw()) << "N=" << N << " level " << lvl << " k=" << k;
+                ASSERT_EQ(im[k].raw(), expected[k].imag().raw()) << "N=" << N << " level " << lvl << " k=" << k;
+            }
+
+            dsp::deinterleave(std::span<const std::complex<Fixed>>(x), std::span<Fixed>(re), std::span<Fixed>(im));
+            split.inverse(re, im);
+            for (std::size_t n = 0; n < N; ++n) {
+                ASSERT_EQ(re[n].raw(), expected_inv[n].real().raw()) << "N=" << N << " level " << lvl << " n=" << n;
+                ASSERT_EQ(im[n].raw(), expected_inv[n].imag().raw()) << "N=" << N << " level " << lvl << " n=" << n;
+            }
+        }
+        simd::set_level(simd::detected_level());
+    }
+
+    TEST(SplitFFTTest, BitExactWithInterleavedPlan) {
+        for (std::size_t N : { 1, 2, 4, 8, 16, 64, 512 }) {
+            expect_matches_aos_plan<Q15>(N);
+            expect_matches_aos_plan<Q24>(N);
+        }
+    }
+
+    TEST(SplitFFTTest, DoubleMatchesDFT) {
+        const std::size_t N = 256;
+        auto x = random_signal<double>(N, 1, 1.0);
+        auto expected = dsp::dft_direct(x);
+
+        std::vector<double> re(N), im(N);
+        dsp::deinterleave(std::span<const std::complex<double>>(x), std::span<double>(re), std::span<double>(im));
+        dsp::SplitFFTPlan<double> plan(N);
+        plan.forward(re, im);
+        for (std::size_t k = 0; k < N; ++k) {
+            EXPECT_NEAR(re[k], expected[k].real(), 1e-9) << "k=" << k;
+            EXPECT_NEAR(im[k], expected[k].imag(), 1e-9) << "k=" << k;
+        }
+
+        plan.inverse(re, im);
+        std::vector<std::complex<double>> y(N);
+        dsp::interleave(std::span<const double>(re), std::span<const double>(im), std::span<std::complex<double>>(y));
+        for (std::size_t n = 0; n < N; ++n) {
+            EXPECT_NEAR(std::abs(y[n] - x[n]), 0.0, 1e-12) << "n=" << n;
+        }
+    }
+
+    TEST(SplitFFTTest, InterleaveRoundTripsCFixed) {
+        std::vector<dsp::cfixed<Q15>> z{ { Q15(0.5), Q15(-0.25) }, { Q15(-1.0), Q15(0.125) }, { Q15(0.0), Q15(0.75) } };
+        std::vector<Q15> re(z.size()), im(z.size());
+        dsp::deinterleave(std::span<const dsp::cfixed<Q15>>(z), std::span<Q15>(re), std::span<Q15>(im));
+        EXPECT_EQ(re[1].raw(), Q15(-1.0).raw());
+        EXPECT_EQ(im[2].raw(), Q15(0.75).raw());
+
+        std::vector<dsp::cfixed<Q15>> back(z.size());
+        dsp::interleave(std::span<const Q15>(re), std::span<const Q15>(im), std::span<dsp::cfixed<Q15>>(back));
+        EXPECT_EQ(back, z);
+    }
+
+    TEST(SplitFFTTest, RejectsBadSizes) {
+        EXPECT_THROW(dsp::SplitFFTPlan<double>(12), std::invalid_argument);
+        dsp::SplitFFTPlan<double> plan(8);
+        std::vector<double> re(8), im(4);
+        EXPECT_THROW(plan.forward(re, im), std::invalid_argument);
+        std::vector<std::complex<double>> z(8);
+        EXPECT_THROW(dsp::deinterleave(std::span<const std::complex<double>>(z), std::span<double>(re), std::span<double>(im)),
+                     std::invalid_argument);
+    }
+
+}  // namespace
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <complex>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "dsp/cfixed.hpp"
+#include "dsp/fft.hpp"
+#include "dsp/static_fft.hpp"
+#include "fixed_point/fixed_point.hpp"
+
+using Q15 = FixedPoint<16, 15, SaturationPolicy>;
+using Q24 = FixedPoint<32, 24, SaturationPolicy>;
+
+namespace {
+
+    // Spectrum of a unit impulse, computed entirely at compile time
+    constexpr std::array<std::complex<double>, 8> impulse_spectrum() {
+        std::array<std::complex<double>, 8> x{};
+        x[0] = 1.0;
+        dsp::StaticFFT<double, 8>::forward(x);
+        return x;
+    }
+    static_assert(impulse_spectrum()[5] == std::complex<double>(1.0, 0.0));
+
+    template<typename Sample, std::size_t N, typename Complex>
+    void expect_matches_plan(unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> dist(-1.0 / N, 1.0 / N);
+        std::array<Complex, N> x;
+        for (auto& v : x) v = Complex(Sample(dist(rng)), Sample(dist(rng)));
+
+        std::vector<Complex> expected(x.begin(), x.end());
+        dsp::FFTPlan<Sample, Complex> plan(N);
+        plan.forward(expected);
+        auto X = x;
+        dsp::StaticFFT<Sample, N, Complex>::forward(X);
+        for (std::size_t k = 0; k < N; ++k) ASSERT_EQ(X[k], expected[k]) << "N=" << N << " k=" << k;
+
+        plan.inverse(expected);
+        dsp::StaticFFT<Sample, N, Complex>::inverse(std::span<Complex, N>(X));
+        for (std::size_t n = 0; n < N; ++n) ASSERT_EQ(X[n], expected[n]) << "N=" << N << " n=" << n;
+    }
+
+    template<typename Sample, typename Complex = std::complex<Sample>>
+    void expect_all_sizes_match() {
+        expect_matches_plan<Sample, 1, Complex>(1);
+        expect_matches_plan<Sample, 2, Complex>(2);
+        expect_matches_plan<Sample, 4, Complex>(3);
+        expect_matches_plan<Sample, 8, Complex>(4);
+        expect_matches_plan<Sample, 16, Complex>(5);
+        expect_matches_plan<Sample, 64, Complex>(6);
+        expect_matches_plan<Sample, 256, Complex>(7);  // looped passes
+        expect_matches_plan<Sample, 1024, Complex>(8);  // looped bit reversal
+    }
+
+    TEST(StaticFFTTest, BitExactWithRuntimePlan) {
+        expect_all_sizes_match<Q15>();
+        expect_all_sizes_match<Q24>();
+        expect_all_sizes_match<Q15, dsp::cfixed<Q15>>();
+    }
+
+    TEST(StaticFFTTest, DoubleRoundTrip) {
+        std::array<std::complex<double>, 32> x;
+        for (std::size_t n = 0; n < x.size(); ++n) x[n] = { std::sin(0.4 * double(n)), 0.1 * double(n % 5) };
+        auto X = x;
+        dsp::StaticFFT<double, 32>::forward(X);
+        std::complex<double> dc = 0.0;
+        for (const auto& v : x) dc += v;
+        EXPECT_NEAR(std::abs(X[0] - dc), 0.0, 1e-12);
+        dsp::StaticFFT<double, 32>::inverse(X);
+        for (std::size_t n = 0; n < x.size(); ++n) EXPECT_NEAR(std::abs(X[n] - x[n]), 0.0, 1e-12) << "n=" << n;
+    }
+
+}  // namespace